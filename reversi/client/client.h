@@ -1,8 +1,8 @@
 #ifndef CLIENT_H
 #define CLIENT_H
 
-int handle_server_message(const char *message);
-int wait_for_server_message(int socket_fd, char *buffer, size_t buffer_size, int timeout_seconds);
+int handle_server_message(char *line);
+int run_event_loop(int socket_fd);
 void handle_sigint(int sig);
 
 #endif
@@ -3,14 +3,23 @@
 #include <string.h>
 #include <unistd.h>
 #include <signal.h>
-#include <sys/select.h>
+#include <errno.h>
+#include <poll.h>
 #include "network.h"
 #include "ui.h"
 #include "client.h"
 #include "../common/protocol.h"
+#include "../common/board.h"
+#include "../lib/reversi.h"
 
 static int g_socket_fd = -1;
 static volatile sig_atomic_t g_should_quit = 0;
+static int g_in_tournament = 0;
+static const char *g_player_name = NULL;
+static int g_board_size = BOARD_DEFAULT_SIZE;
+static ReversiGame *g_local_game = NULL;
+static ReversiColor g_local_color = REVERSI_BLACK;
+static int g_local_synced = 0;
 
 void handle_sigint(int sig) {
     (void)sig;
@@ -24,25 +33,60 @@ void handle_sigint(int sig) {
     exit(0);
 }
 
-int handle_server_message(const char *message) {
-    MessageType msg_type = parse_message_type(message);
-    char buffer[MAX_MESSAGE_LENGTH];
-    char color[64];
-    char result[64];
-    char winner[64];
+static void sync_local_game(const char *cells, int size) {
+    char serialized[REVERSI_SERIALIZED_LENGTH];
+    int written = snprintf(serialized, sizeof(serialized), "%d|%c|%s", size,
+                           g_local_color == REVERSI_BLACK ? CELL_BLACK : CELL_WHITE, cells);
+
+    if (g_local_game == NULL) {
+        g_local_game = reversi_create(REVERSI_DEFAULT_SIZE);
+    }
+    g_local_synced = g_local_game != NULL && written > 0 && (size_t)written < sizeof(serialized) &&
+                     reversi_deserialize(g_local_game, serialized) == 0;
+}
+
+static int local_has_legal_moves(void) {
+    int square;
+    return g_local_synced && reversi_legal_moves(g_local_game, &square, 1) > 0;
+}
+
+static const char *local_move_error(int row, int col) {
+    if (!g_local_synced) {
+        return NULL;
+    }
+    if (reversi_cell(g_local_game, row, col) != CELL_EMPTY) {
+        return "occupied";
+    }
+    return reversi_is_legal(g_local_game, row, col) ? NULL : "no_flip";
+}
+
+int handle_server_message(char *line) {
+    ParsedMessage message;
+    const char *text;
+    const char *result;
+    const char *winner;
     int row;
     int col;
     int black_count;
     int white_count;
+    int round;
+    int total_rounds;
+    RankReply rank;
+    
+    tokenize_message(line, &message);
     
-    switch (msg_type) {
+    switch (message.type) {
         case MESSAGE_TYPE_WAIT:
             display_waiting();
             break;
             
         case MESSAGE_TYPE_WELCOME:
-            if (parse_welcome_message(message, color) == 0) {
-                display_welcome(color);
+            if ((text = message_field(&message, 0)) != NULL) {
+                g_local_color = (strcmp(text, COLOR_WHITE) == 0) ? REVERSI_WHITE : REVERSI_BLACK;
+                display_welcome(text);
+            }
+            if (g_player_name != NULL) {
+                send_name(g_socket_fd, g_player_name);
             }
             break;
             
@@ -51,33 +95,39 @@ int handle_server_message(const char *message) {
             break;
             
         case MESSAGE_TYPE_BOARD:
-            if (parse_board_message(message, buffer) == 0) {
-                display_board(buffer);
+            if ((text = parse_board_message(&message, &g_board_size)) != NULL) {
+                sync_local_game(text, g_board_size);
+                display_board(text, g_board_size);
             }
             break;
             
         case MESSAGE_TYPE_YOUR_TURN:
+            if (g_local_synced && !local_has_legal_moves()) {
+                display_status("No legal moves, passing");
+                send_pass(g_socket_fd);
+                return 2;
+            }
             display_status("Your turn!");
             return 1;
             
         case MESSAGE_TYPE_OPPONENT_TURN:
             display_status("Opponent's turn...");
-            break;
+            return 2;
             
         case MESSAGE_TYPE_VALID:
             display_status("Move accepted!");
             break;
             
         case MESSAGE_TYPE_INVALID:
-            if (parse_invalid_message(message, buffer) == 0) {
-                display_error(buffer);
+            if ((text = message_field(&message, 0)) != NULL) {
+                display_error(text);
             } else {
                 display_error("Invalid move");
             }
             return 1;
             
         case MESSAGE_TYPE_OPPONENT_MOVE:
-            if (parse_opponent_move_message(message, &row, &col) == 0) {
+            if (parse_opponent_move_message(&message, &row, &col) == 0) {
                 display_opponent_move(row, col);
             }
             break;
@@ -87,25 +137,64 @@ int handle_server_message(const char *message) {
             break;
             
         case MESSAGE_TYPE_GAME_OVER:
-            if (parse_game_over_message(message, result, winner, &black_count, &white_count) == 0) {
+            if (parse_game_over_message(&message, &result, &winner, &black_count, &white_count) == 0) {
                 display_game_over(result, winner, black_count, white_count);
             }
-            return -1;
+            return g_in_tournament ? 2 : -1;
             
         case MESSAGE_TYPE_OPPONENT_LEFT:
             display_status("Opponent has left the game");
+            return g_in_tournament ? 2 : -1;
+            
+        case MESSAGE_TYPE_ROUND:
+            if (parse_round_message(&message, &round, &total_rounds) == 0) {
+                g_in_tournament = 1;
+                display_round(round, total_rounds);
+            }
+            break;
+            
+        case MESSAGE_TYPE_BYE:
+            display_status("You have a bye this round, waiting for the next one...");
+            break;
+            
+        case MESSAGE_TYPE_TOURNAMENT_OVER:
+            if (parse_tournament_over_message(&message, &round, &total_rounds, &text) == 0) {
+                display_tournament_over(round, total_rounds, text);
+            }
             return -1;
             
+        case MESSAGE_TYPE_RANK:
+            if (parse_rank_message(&message, &rank) == 0) {
+                display_rank(rank.name, rank.rank, rank.players, rank.rating, rank.wins, rank.losses, rank.draws);
+            }
+            break;
+            
+        case MESSAGE_TYPE_UNDO:
+            display_undo_prompt();
+            return 3;
+            
+        case MESSAGE_TYPE_UNDO_ACCEPT:
+            display_status("Takeback accepted");
+            return 2;
+            
+        case MESSAGE_TYPE_UNDO_DECLINE:
+            display_status("Takeback declined");
+            break;
+            
+        case MESSAGE_TYPE_PING:
+            send_pong(g_socket_fd, (text = message_field(&message, 0)) != NULL ? text : "");
+            break;
+            
         case MESSAGE_TYPE_ERROR:
-            if (parse_error_message(message, buffer) == 0) {
-                display_error(buffer);
+            if ((text = message_field(&message, 0)) != NULL) {
+                display_error(text);
             } else {
                 display_error("Server error");
             }
             break;
             
         case MESSAGE_TYPE_UNKNOWN:
-            printf("Unknown message: %s\n", message);
+            printf("Unknown message: %s\n", line);
             break;
             
         default:
@@ -115,54 +204,162 @@ int handle_server_message(const char *message) {
     return 0;
 }
 
-int wait_for_server_message(int socket_fd, char *buffer, size_t buffer_size, int timeout_seconds) {
-    fd_set read_fds;
-    struct timeval timeout;
-    
-    FD_ZERO(&read_fds);
-    FD_SET(socket_fd, &read_fds);
-    
-    timeout.tv_sec = timeout_seconds;
-    timeout.tv_usec = 0;
-    
-    int select_result = select(socket_fd + 1, &read_fds, NULL, NULL, &timeout);
+static int handle_player_input(const char *input, int socket_fd) {
+    const char *reason;
+    int row;
+    int col;
     
-    if (select_result < 0) {
-        perror("select failed");
-        return -1;
+    switch (interpret_player_input(input, g_board_size, &row, &col)) {
+        case PLAYER_INPUT_QUIT:
+            send_quit(socket_fd);
+            return -1;
+        case PLAYER_INPUT_PASS:
+            if (local_has_legal_moves()) {
+                display_error("has_legal_moves");
+                display_move_prompt();
+                return 1;
+            }
+            send_pass(socket_fd);
+            return 0;
+        case PLAYER_INPUT_MOVE:
+            if ((reason = local_move_error(row, col)) != NULL) {
+                display_error(reason);
+                display_move_prompt();
+                return 1;
+            }
+            send_move(socket_fd, row, col);
+            return 0;
+        case PLAYER_INPUT_RANK:
+            input += strlen("rank");
+            while (*input == ' ') {
+                input++;
+            }
+            send_rank_query(socket_fd, (*input != '\0') ? input : g_player_name);
+            return 1;
+        case PLAYER_INPUT_UNDO:
+            send_undo(socket_fd);
+            return 1;
+        case PLAYER_INPUT_ACCEPT:
+            send_undo_reply(socket_fd, 1);
+            return 2;
+        case PLAYER_INPUT_DECLINE:
+            send_undo_reply(socket_fd, 0);
+            return 2;
+        case PLAYER_INPUT_INVALID:
+        default:
+            display_move_prompt();
+            return 1;
     }
+}
+
+int run_event_loop(int socket_fd) {
+    LineReader server_reader;
+    LineReader input_reader;
+    line_reader_init(&server_reader, socket_fd);
+    line_reader_init(&input_reader, STDIN_FILENO);
     
-    if (select_result == 0) {
-        return 0;
-    }
+    int waiting_for_turn = 0;
+    int answering_undo = 0;
     
-    ssize_t bytes_received = receive_server_message(socket_fd, buffer, buffer_size);
-    if (bytes_received <= 0) {
-        if (bytes_received == 0) {
-            printf("Server disconnected\n");
-        } else {
-            perror("recv failed");
+    while (!g_should_quit) {
+        char *line;
+        
+        while ((line = line_reader_next(&server_reader)) != NULL) {
+            int handle_result = handle_server_message(line);
+            
+            if (handle_result == -1) {
+                return 0;
+            }
+            if (handle_result == 2) {
+                waiting_for_turn = 0;
+            }
+            if (handle_result == 3) {
+                answering_undo = 1;
+            }
+            if (handle_result == 1 && !waiting_for_turn) {
+                waiting_for_turn = 1;
+                display_move_prompt();
+            }
+        }
+        
+        while ((waiting_for_turn || answering_undo) && (line = line_reader_next(&input_reader)) != NULL) {
+            int input_result = handle_player_input(line, socket_fd);
+            
+            if (input_result < 0) {
+                return 0;
+            }
+            if (input_result == 2) {
+                answering_undo = 0;
+                continue;
+            }
+            waiting_for_turn = input_result;
+        }
+        
+        struct pollfd poll_fds[2] = {
+            { .fd = socket_fd, .events = POLLIN },
+            { .fd = STDIN_FILENO, .events = POLLIN }
+        };
+        
+        int reading_input = waiting_for_turn || answering_undo;
+        if (poll(poll_fds, reading_input ? 2 : 1, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("poll failed");
+            return -1;
+        }
+        
+        if (poll_fds[0].revents & (POLLIN | POLLHUP | POLLERR)) {
+            ssize_t bytes_received = line_reader_fill(&server_reader);
+            if (bytes_received == 0) {
+                printf("Server disconnected\n");
+                return -1;
+            }
+            if (bytes_received < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                perror("recv failed");
+                return -1;
+            }
+        }
+        
+        if (reading_input && (poll_fds[1].revents & (POLLIN | POLLHUP | POLLERR))) {
+            ssize_t bytes_read = line_reader_fill(&input_reader);
+            if (bytes_read == 0 && line_reader_next(&input_reader) == NULL) {
+                send_quit(socket_fd);
+                return 0;
+            }
+            if (bytes_read < 0 && errno != EINTR) {
+                send_quit(socket_fd);
+                return 0;
+            }
         }
-        return -1;
     }
     
-    return 1;
+    return 0;
 }
 
 int main(int argc, char *argv[]) {
-    if (argc != 3) {
-        fprintf(stderr, "Usage: %s <server_ip> <port>\n", argv[0]);
+    if (argc != 3 && argc != 4) {
+        fprintf(stderr, "Usage: %s <server_ip> <port> [nickname]\n", argv[0]);
+        fprintf(stderr, "       %s -u <socket_path> [nickname]\n", argv[0]);
         return 1;
     }
     
+    int use_unix_socket = strcmp(argv[1], "-u") == 0;
     const char *host = argv[1];
     const char *port = argv[2];
+    if (argc == 4) {
+        g_player_name = argv[3];
+    }
     
     signal(SIGINT, handle_sigint);
     
-    printf("Connecting to server at %s:%s...\n", host, port);
-    
-    g_socket_fd = connect_to_server(host, port);
+    if (use_unix_socket) {
+        printf("Connecting to server at %s...\n", port);
+        g_socket_fd = connect_to_unix_server(port);
+    } else {
+        printf("Connecting to server at %s:%s...\n", host, port);
+        g_socket_fd = connect_to_server(host, port);
+    }
     if (g_socket_fd < 0) {
         fprintf(stderr, "Failed to connect to server\n");
         return 1;
@@ -170,51 +367,12 @@ int main(int argc, char *argv[]) {
     
     printf("Connected successfully!\n");
     
-    char message_buffer[MAX_MESSAGE_LENGTH];
-    int game_active = 1;
-    int waiting_for_turn = 0;
-    
-    while (game_active && !g_should_quit) {
-        if (waiting_for_turn) {
-            int row;
-            int col;
-            int move_result = get_player_move(&row, &col);
-            
-            if (move_result == -1) {
-                send_quit(g_socket_fd);
-                break;
-            } else if (move_result == 0) {
-                send_pass(g_socket_fd);
-            } else {
-                send_move(g_socket_fd, row, col);
-            }
-            
-            waiting_for_turn = 0;
-        }
-        
-        int wait_result = wait_for_server_message(g_socket_fd, message_buffer, sizeof(message_buffer), 1);
-        
-        if (wait_result < 0) {
-            game_active = 0;
-            break;
-        }
-        
-        if (wait_result == 0) {
-            continue;
-        }
-        
-        int handle_result = handle_server_message(message_buffer);
-        
-        if (handle_result == 1) {
-            waiting_for_turn = 1;
-        } else if (handle_result == -1) {
-            game_active = 0;
-            break;
-        }
-    }
+    set_nonblocking(g_socket_fd);
+    run_event_loop(g_socket_fd);
     
     close(g_socket_fd);
     g_socket_fd = -1;
+    reversi_destroy(g_local_game);
     
     printf("Disconnected from server.\n");
     return 0;
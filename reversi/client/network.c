@@ -2,12 +2,17 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <sys/socket.h>
+#include <sys/un.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <netdb.h>
 #include "network.h"
 #include "../common/protocol.h"
+#include "../common/board.h"
 
 int connect_to_server(const char *host, const char *port) {
     struct addrinfo hints;
@@ -48,150 +53,319 @@ int connect_to_server(const char *host, const char *port) {
     return socket_fd;
 }
 
+int connect_to_unix_server(const char *path) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "UNIX socket path too long\n");
+        return -1;
+    }
+    memcpy(address.sun_path, path, strlen(path));
+
+    int socket_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (socket_fd == -1) {
+        perror("socket creation failed");
+        return -1;
+    }
+
+    if (connect(socket_fd, (struct sockaddr *)&address, sizeof(address)) < 0) {
+        fprintf(stderr, "Could not connect to server at %s: %s\n", path, strerror(errno));
+        close(socket_fd);
+        return -1;
+    }
+
+    return socket_fd;
+}
+
+int set_nonblocking(int socket_fd) {
+    int flags = fcntl(socket_fd, F_GETFL, 0);
+    if (flags < 0) {
+        return -1;
+    }
+    return fcntl(socket_fd, F_SETFL, flags | O_NONBLOCK);
+}
+
 ssize_t send_client_message(int socket_fd, const char *message) {
     size_t message_length = strlen(message);
-    return send(socket_fd, message, message_length, 0);
+    size_t total_sent = 0;
+
+    while (total_sent < message_length) {
+        ssize_t bytes_sent = send(socket_fd, message + total_sent, message_length - total_sent, MSG_NOSIGNAL);
+        if (bytes_sent > 0) {
+            total_sent += (size_t)bytes_sent;
+            continue;
+        }
+        if (bytes_sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes_sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            struct pollfd writable = { .fd = socket_fd, .events = POLLOUT };
+            int ready = poll(&writable, 1, CLIENT_SEND_TIMEOUT_MS);
+            if (ready > 0 || (ready < 0 && errno == EINTR)) {
+                continue;
+            }
+            if (ready == 0) {
+                errno = ETIMEDOUT;
+            }
+        }
+        return -1;
+    }
+    return (ssize_t)total_sent;
+}
+
+void line_reader_init(LineReader *reader, int fd) {
+    reader->fd = fd;
+    reader->start = 0;
+    reader->end = 0;
 }
 
-ssize_t receive_server_message(int socket_fd, char *buffer, size_t buffer_size) {
-    size_t total_received = 0;
+ssize_t line_reader_fill(LineReader *reader) {
+    if (reader->start > 0) {
+        memmove(reader->data, reader->data + reader->start, reader->end - reader->start);
+        reader->end -= reader->start;
+        reader->start = 0;
+    }
     
-    while (total_received < buffer_size - 1) {
-        ssize_t bytes_received = recv(socket_fd, buffer + total_received, 1, 0);
-        
-        if (bytes_received <= 0) {
-            if (total_received == 0) {
-                return bytes_received;
-            }
-            break;
+    size_t available = sizeof(reader->data) - 1 - reader->end;
+    if (available == 0) {
+        errno = ENOBUFS;
+        return -1;
+    }
+    
+    ssize_t bytes_read = read(reader->fd, reader->data + reader->end, available);
+    if (bytes_read > 0) {
+        reader->end += (size_t)bytes_read;
+    }
+    return bytes_read;
+}
+
+char *line_reader_next(LineReader *reader) {
+    char *line = reader->data + reader->start;
+    size_t buffered = reader->end - reader->start;
+    char *newline = memchr(line, '\n', buffered);
+    
+    if (newline == NULL) {
+        if (reader->start > 0 || reader->end < sizeof(reader->data) - 1) {
+            return NULL;
         }
-        
-        if (buffer[total_received] == '\n') {
-            buffer[total_received] = '\0';
-            return total_received;
+        reader->data[reader->end] = '\0';
+        reader->start = reader->end;
+        return line;
+    }
+    
+    *newline = '\0';
+    if (newline > line && newline[-1] == '\r') {
+        newline[-1] = '\0';
+    }
+    reader->start = (size_t)(newline - reader->data) + 1;
+    return line;
+}
+
+ssize_t receive_server_message(LineReader *reader, char *buffer, size_t buffer_size) {
+    char *line;
+    
+    while ((line = line_reader_next(reader)) == NULL) {
+        ssize_t bytes_read = line_reader_fill(reader);
+        if (bytes_read <= 0) {
+            return bytes_read;
         }
-        
-        total_received++;
     }
     
-    buffer[total_received] = '\0';
-    return total_received;
+    size_t length = strlen(line);
+    if (length >= buffer_size) {
+        length = buffer_size - 1;
+    }
+    memcpy(buffer, line, length);
+    buffer[length] = '\0';
+    return (ssize_t)length;
+}
+
+static size_t clamp_formatted_length(int written, size_t buffer_size) {
+    if (written < 0) {
+        return 0;
+    }
+    if ((size_t)written >= buffer_size) {
+        return buffer_size - 1;
+    }
+    return (size_t)written;
+}
+
+size_t format_move_message(char *buffer, size_t buffer_size, int row, int col) {
+    int written = snprintf(buffer, buffer_size, "%s%s%d%s%d%s",
+                           MESSAGE_MOVE, PROTOCOL_DELIMITER, row, PROTOCOL_DELIMITER, col, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
+}
+
+size_t format_pass_message(char *buffer, size_t buffer_size) {
+    int written = snprintf(buffer, buffer_size, "%s%s", MESSAGE_PASS, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
+}
+
+size_t format_quit_message(char *buffer, size_t buffer_size) {
+    int written = snprintf(buffer, buffer_size, "%s%s", MESSAGE_QUIT, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
+}
+
+size_t format_name_message(char *buffer, size_t buffer_size, const char *name) {
+    int written = snprintf(buffer, buffer_size, "%s%s%s%s", MESSAGE_NAME, PROTOCOL_DELIMITER, name, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
+}
+
+size_t format_rank_query_message(char *buffer, size_t buffer_size, const char *name) {
+    int written;
+    if (name == NULL || name[0] == '\0') {
+        written = snprintf(buffer, buffer_size, "%s%s", MESSAGE_RANK, PROTOCOL_TERMINATOR);
+    } else {
+        written = snprintf(buffer, buffer_size, "%s%s%s%s", MESSAGE_RANK, PROTOCOL_DELIMITER, name, PROTOCOL_TERMINATOR);
+    }
+    return clamp_formatted_length(written, buffer_size);
+}
+
+size_t format_undo_message(char *buffer, size_t buffer_size) {
+    int written = snprintf(buffer, buffer_size, "%s%s", MESSAGE_UNDO, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
+}
+
+size_t format_undo_reply_message(char *buffer, size_t buffer_size, int accepted) {
+    int written = snprintf(buffer, buffer_size, "%s%s",
+                           accepted ? MESSAGE_UNDO_ACCEPT : MESSAGE_UNDO_DECLINE, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
+}
+
+size_t format_rematch_message(char *buffer, size_t buffer_size) {
+    int written = snprintf(buffer, buffer_size, "%s%s", MESSAGE_REMATCH, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
+}
+
+size_t format_pong_message(char *buffer, size_t buffer_size, const char *stamp) {
+    int written = snprintf(buffer, buffer_size, "%s%s%s%s", MESSAGE_PONG, PROTOCOL_DELIMITER, stamp, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
 }
 
 int send_move(int socket_fd, int row, int col) {
     char message[MAX_MESSAGE_LENGTH];
-    snprintf(message, sizeof(message), "%s%s%d%s%d%s",
-             MESSAGE_MOVE, PROTOCOL_DELIMITER, row, PROTOCOL_DELIMITER, col, PROTOCOL_TERMINATOR);
+    format_move_message(message, sizeof(message), row, col);
     return send_client_message(socket_fd, message) > 0 ? 0 : -1;
 }
 
 int send_pass(int socket_fd) {
     char message[MAX_MESSAGE_LENGTH];
-    snprintf(message, sizeof(message), "%s%s", MESSAGE_PASS, PROTOCOL_TERMINATOR);
+    format_pass_message(message, sizeof(message));
     return send_client_message(socket_fd, message) > 0 ? 0 : -1;
 }
 
 int send_quit(int socket_fd) {
     char message[MAX_MESSAGE_LENGTH];
-    snprintf(message, sizeof(message), "%s%s", MESSAGE_QUIT, PROTOCOL_TERMINATOR);
+    format_quit_message(message, sizeof(message));
     return send_client_message(socket_fd, message) > 0 ? 0 : -1;
 }
 
-MessageType parse_message_type(const char *message) {
-    if (strncmp(message, MESSAGE_WAIT, strlen(MESSAGE_WAIT)) == 0) {
-        return MESSAGE_TYPE_WAIT;
-    }
-    if (strncmp(message, MESSAGE_WELCOME, strlen(MESSAGE_WELCOME)) == 0) {
-        return MESSAGE_TYPE_WELCOME;
-    }
-    if (strncmp(message, MESSAGE_START, strlen(MESSAGE_START)) == 0) {
-        return MESSAGE_TYPE_START;
-    }
-    if (strncmp(message, MESSAGE_BOARD, strlen(MESSAGE_BOARD)) == 0) {
-        return MESSAGE_TYPE_BOARD;
-    }
-    if (strncmp(message, MESSAGE_YOUR_TURN, strlen(MESSAGE_YOUR_TURN)) == 0) {
-        return MESSAGE_TYPE_YOUR_TURN;
-    }
-    if (strncmp(message, MESSAGE_OPPONENT_TURN, strlen(MESSAGE_OPPONENT_TURN)) == 0) {
-        return MESSAGE_TYPE_OPPONENT_TURN;
-    }
-    if (strncmp(message, MESSAGE_VALID, strlen(MESSAGE_VALID)) == 0) {
-        return MESSAGE_TYPE_VALID;
-    }
-    if (strncmp(message, MESSAGE_INVALID, strlen(MESSAGE_INVALID)) == 0) {
-        return MESSAGE_TYPE_INVALID;
-    }
-    if (strncmp(message, MESSAGE_OPPONENT_MOVE, strlen(MESSAGE_OPPONENT_MOVE)) == 0) {
-        return MESSAGE_TYPE_OPPONENT_MOVE;
-    }
-    if (strncmp(message, MESSAGE_OPPONENT_PASS, strlen(MESSAGE_OPPONENT_PASS)) == 0) {
-        return MESSAGE_TYPE_OPPONENT_PASS;
-    }
-    if (strncmp(message, MESSAGE_GAME_OVER, strlen(MESSAGE_GAME_OVER)) == 0) {
-        return MESSAGE_TYPE_GAME_OVER;
-    }
-    if (strncmp(message, MESSAGE_OPPONENT_LEFT, strlen(MESSAGE_OPPONENT_LEFT)) == 0) {
-        return MESSAGE_TYPE_OPPONENT_LEFT;
+int send_name(int socket_fd, const char *name) {
+    char message[MAX_MESSAGE_LENGTH];
+    format_name_message(message, sizeof(message), name);
+    return send_client_message(socket_fd, message) > 0 ? 0 : -1;
+}
+
+int send_rank_query(int socket_fd, const char *name) {
+    char message[MAX_MESSAGE_LENGTH];
+    format_rank_query_message(message, sizeof(message), name);
+    return send_client_message(socket_fd, message) > 0 ? 0 : -1;
+}
+
+int send_undo(int socket_fd) {
+    char message[MAX_MESSAGE_LENGTH];
+    format_undo_message(message, sizeof(message));
+    return send_client_message(socket_fd, message) > 0 ? 0 : -1;
+}
+
+int send_undo_reply(int socket_fd, int accepted) {
+    char message[MAX_MESSAGE_LENGTH];
+    format_undo_reply_message(message, sizeof(message), accepted);
+    return send_client_message(socket_fd, message) > 0 ? 0 : -1;
+}
+
+int send_rematch(int socket_fd) {
+    char message[MAX_MESSAGE_LENGTH];
+    format_rematch_message(message, sizeof(message));
+    return send_client_message(socket_fd, message) > 0 ? 0 : -1;
+}
+
+int send_pong(int socket_fd, const char *stamp) {
+    char message[MAX_MESSAGE_LENGTH];
+    format_pong_message(message, sizeof(message), stamp);
+    return send_client_message(socket_fd, message) > 0 ? 0 : -1;
+}
+
+const char *parse_board_message(const ParsedMessage *message, int *size) {
+    int rows;
+    int cols;
+    if (message->field_count != 3 ||
+        parse_message_int(message->fields[0], &rows) < 0 ||
+        parse_message_int(message->fields[1], &cols) < 0) {
+        return NULL;
     }
-    if (strncmp(message, MESSAGE_ERROR, strlen(MESSAGE_ERROR)) == 0) {
-        return MESSAGE_TYPE_ERROR;
+    if (rows != cols || rows < BOARD_MIN_SIZE || rows > BOARD_MAX_SIZE ||
+        strlen(message->fields[2]) != (size_t)(rows * cols)) {
+        return NULL;
     }
-    return MESSAGE_TYPE_UNKNOWN;
+    *size = rows;
+    return message->fields[2];
 }
 
-int parse_welcome_message(const char *message, char *color) {
-    const char *delimiter_pos = strchr(message, '|');
-    if (delimiter_pos == NULL) {
-        return -1;
-    }
-    
-    strcpy(color, delimiter_pos + 1);
-    return 0;
+int parse_opponent_move_message(const ParsedMessage *message, int *row, int *col) {
+    return parse_message_coordinates(message, row, col);
 }
 
-int parse_board_message(const char *message, char *board) {
-    const char *delimiter_pos = strchr(message, '|');
-    if (delimiter_pos == NULL) {
+int parse_game_over_message(const ParsedMessage *message, const char **result, const char **winner,
+                            int *black_count, int *white_count) {
+    if (message->field_count != 4) {
         return -1;
     }
-    
-    strcpy(board, delimiter_pos + 1);
+    if (parse_message_int(message->fields[2], black_count) < 0 ||
+        parse_message_int(message->fields[3], white_count) < 0) {
+        return -1;
+    }
+    *result = message->fields[0];
+    *winner = message->fields[1];
     return 0;
 }
 
-int parse_invalid_message(const char *message, char *reason) {
-    const char *delimiter_pos = strchr(message, '|');
-    if (delimiter_pos == NULL) {
-        strcpy(reason, "Unknown reason");
+int parse_round_message(const ParsedMessage *message, int *round, int *total_rounds) {
+    if (message->field_count != 2) {
+        return -1;
+    }
+    if (parse_message_int(message->fields[0], round) < 0 ||
+        parse_message_int(message->fields[1], total_rounds) < 0) {
         return -1;
     }
-    
-    strcpy(reason, delimiter_pos + 1);
     return 0;
 }
 
-int parse_opponent_move_message(const char *message, int *row, int *col) {
-    if (sscanf(message, "OPPONENT_MOVE|%d|%d", row, col) == 2) {
-        return 0;
+int parse_tournament_over_message(const ParsedMessage *message, int *rank, int *entrants, const char **score) {
+    if (message->field_count != 3) {
+        return -1;
     }
-    return -1;
-}
-
-int parse_game_over_message(const char *message, char *result, char *winner, int *black_count, int *white_count) {
-    if (sscanf(message, "GAME_OVER|%[^|]|%[^|]|%d|%d", result, winner, black_count, white_count) == 4) {
-        return 0;
+    if (parse_message_int(message->fields[0], rank) < 0 ||
+        parse_message_int(message->fields[1], entrants) < 0) {
+        return -1;
     }
-    return -1;
+    *score = message->fields[2];
+    return 0;
 }
 
-int parse_error_message(const char *message, char *error_text) {
-    const char *delimiter_pos = strchr(message, '|');
-    if (delimiter_pos == NULL) {
-        strcpy(error_text, "Unknown error");
+int parse_rank_message(const ParsedMessage *message, RankReply *reply) {
+    if (message->field_count != 7) {
         return -1;
     }
-    
-    strcpy(error_text, delimiter_pos + 1);
+    if (parse_message_int(message->fields[1], &reply->rank) < 0 ||
+        parse_message_int(message->fields[2], &reply->rating) < 0 ||
+        parse_message_int(message->fields[3], &reply->wins) < 0 ||
+        parse_message_int(message->fields[4], &reply->losses) < 0 ||
+        parse_message_int(message->fields[5], &reply->draws) < 0 ||
+        parse_message_int(message->fields[6], &reply->players) < 0) {
+        return -1;
+    }
+    reply->name = message->fields[0];
     return 0;
 }
@@ -2,20 +2,62 @@
 #define CLIENT_NETWORK_H
 
 #include <stddef.h>
+#include <sys/types.h>
 #include "../common/protocol.h"
+#include "../common/message.h"
+
+#define LINE_READER_BUFFER_SIZE (MAX_MESSAGE_LENGTH * 4)
+#define CLIENT_SEND_TIMEOUT_MS 5000
+
+typedef struct {
+    int fd;
+    size_t start;
+    size_t end;
+    char data[LINE_READER_BUFFER_SIZE];
+} LineReader;
+
+typedef struct {
+    const char *name;
+    int rank;
+    int rating;
+    int wins;
+    int losses;
+    int draws;
+    int players;
+} RankReply;
 
 int connect_to_server(const char *host, const char *port);
+int connect_to_unix_server(const char *path);
+int set_nonblocking(int socket_fd);
+void line_reader_init(LineReader *reader, int fd);
+ssize_t line_reader_fill(LineReader *reader);
+char *line_reader_next(LineReader *reader);
 ssize_t send_client_message(int socket_fd, const char *message);
-ssize_t receive_server_message(int socket_fd, char *buffer, size_t buffer_size);
+ssize_t receive_server_message(LineReader *reader, char *buffer, size_t buffer_size);
+size_t format_move_message(char *buffer, size_t buffer_size, int row, int col);
+size_t format_pass_message(char *buffer, size_t buffer_size);
+size_t format_quit_message(char *buffer, size_t buffer_size);
+size_t format_name_message(char *buffer, size_t buffer_size, const char *name);
+size_t format_rank_query_message(char *buffer, size_t buffer_size, const char *name);
+size_t format_undo_message(char *buffer, size_t buffer_size);
+size_t format_undo_reply_message(char *buffer, size_t buffer_size, int accepted);
+size_t format_rematch_message(char *buffer, size_t buffer_size);
+size_t format_pong_message(char *buffer, size_t buffer_size, const char *stamp);
 int send_move(int socket_fd, int row, int col);
 int send_pass(int socket_fd);
 int send_quit(int socket_fd);
-MessageType parse_message_type(const char *message);
-int parse_welcome_message(const char *message, char *color);
-int parse_board_message(const char *message, char *board);
-int parse_invalid_message(const char *message, char *reason);
-int parse_opponent_move_message(const char *message, int *row, int *col);
-int parse_game_over_message(const char *message, char *result, char *winner, int *black_count, int *white_count);
-int parse_error_message(const char *message, char *error_text);
+int send_name(int socket_fd, const char *name);
+int send_rank_query(int socket_fd, const char *name);
+int send_undo(int socket_fd);
+int send_undo_reply(int socket_fd, int accepted);
+int send_rematch(int socket_fd);
+int send_pong(int socket_fd, const char *stamp);
+const char *parse_board_message(const ParsedMessage *message, int *size);
+int parse_opponent_move_message(const ParsedMessage *message, int *row, int *col);
+int parse_game_over_message(const ParsedMessage *message, const char **result, const char **winner,
+                            int *black_count, int *white_count);
+int parse_round_message(const ParsedMessage *message, int *round, int *total_rounds);
+int parse_tournament_over_message(const ParsedMessage *message, int *rank, int *entrants, const char **score);
+int parse_rank_message(const ParsedMessage *message, RankReply *reply);
 
 #endif
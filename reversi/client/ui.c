@@ -4,14 +4,21 @@
 #include "ui.h"
 #include "../common/board.h"
 
-void display_board(const char *board_string) {
-    printf("\n    0 1 2 3 4 5 6 7\n");
-    printf("  +----------------\n");
+void display_board(const char *board_string, int size) {
+    printf("\n    ");
+    for (int col = 0; col < size; col++) {
+        printf("%d ", col);
+    }
+    printf("\n  +");
+    for (int col = 0; col < size; col++) {
+        printf("--");
+    }
+    printf("\n");
     
-    for (int row = 0; row < BOARD_HEIGHT; row++) {
+    for (int row = 0; row < size; row++) {
         printf("%d | ", row);
-        for (int col = 0; col < BOARD_WIDTH; col++) {
-            int index = row * BOARD_WIDTH + col;
+        for (int col = 0; col < size; col++) {
+            int index = row * size + col;
             printf("%c ", board_string[index]);
         }
         printf("\n");
@@ -37,44 +44,56 @@ void display_waiting(void) {
     printf("Waiting for opponent to connect...\n");
 }
 
-int get_player_move(int *row, int *col) {
-    char input[256];
-    
-    printf("Your turn! Enter move (e.g., '3 4' or 'd3'), 'pass', or 'quit': ");
+void display_move_prompt(void) {
+    printf("Your turn! Enter move (e.g., '3 4' or 'd3'), 'pass', 'undo', 'rank [name]', or 'quit': ");
     fflush(stdout);
+}
+
+void display_undo_prompt(void) {
+    printf("Opponent asks to take back their last move. Enter 'accept' or 'decline': ");
+    fflush(stdout);
+}
+
+PlayerInput interpret_player_input(const char *input, int size, int *row, int *col) {
+    if (strcasecmp(input, "quit") == 0 || strcasecmp(input, "q") == 0) {
+        return PLAYER_INPUT_QUIT;
+    }
     
-    if (fgets(input, sizeof(input), stdin) == NULL) {
-        return -1;
+    if (strcasecmp(input, "pass") == 0 || strcasecmp(input, "p") == 0) {
+        return PLAYER_INPUT_PASS;
     }
     
-    size_t len = strlen(input);
-    if (len > 0 && input[len - 1] == '\n') {
-        input[len - 1] = '\0';
+    if (strcasecmp(input, "undo") == 0 || strcasecmp(input, "u") == 0) {
+        return PLAYER_INPUT_UNDO;
     }
     
-    if (strcasecmp(input, "quit") == 0 || strcasecmp(input, "q") == 0) {
-        return -1;
+    if (strcasecmp(input, "accept") == 0) {
+        return PLAYER_INPUT_ACCEPT;
     }
     
-    if (strcasecmp(input, "pass") == 0 || strcasecmp(input, "p") == 0) {
-        return 0;
+    if (strcasecmp(input, "decline") == 0) {
+        return PLAYER_INPUT_DECLINE;
     }
     
-    if (parse_move_input(input, row, col) == 0) {
-        return 1;
+    if (strncasecmp(input, "rank", 4) == 0 && (input[4] == '\0' || input[4] == ' ')) {
+        return PLAYER_INPUT_RANK;
+    }
+    
+    if (parse_move_input(input, size, row, col) == 0) {
+        return PLAYER_INPUT_MOVE;
     }
     
     printf("Invalid input format. Use 'row col' (e.g., '3 4') or algebraic notation (e.g., 'd3')\n");
-    return get_player_move(row, col);
+    return PLAYER_INPUT_INVALID;
 }
 
-int parse_move_input(const char *input, int *row, int *col) {
+int parse_move_input(const char *input, int size, int *row, int *col) {
     int parsed_row;
     int parsed_col;
     
     if (sscanf(input, "%d %d", &parsed_row, &parsed_col) == 2) {
-        if (parsed_row >= 0 && parsed_row < BOARD_HEIGHT && 
-            parsed_col >= 0 && parsed_col < BOARD_WIDTH) {
+        if (parsed_row >= 0 && parsed_row < size && 
+            parsed_col >= 0 && parsed_col < size) {
             *row = parsed_row;
             *col = parsed_col;
             return 0;
@@ -86,7 +105,7 @@ int parse_move_input(const char *input, int *row, int *col) {
         char col_char = tolower(input[0]);
         char row_char = input[1];
         
-        if (col_char >= 'a' && col_char <= 'h' && row_char >= '0' && row_char <= '7') {
+        if (col_char >= 'a' && col_char < 'a' + size && row_char >= '0' && row_char < '0' + size) {
             *col = col_char - 'a';
             *row = row_char - '0';
             return 0;
@@ -117,3 +136,25 @@ void display_game_over(const char *result, const char *winner, int black_count,
     printf("====================================\n");
     printf("\n");
 }
+
+void display_round(int round, int total_rounds) {
+    printf("\n");
+    printf("====================================\n");
+    printf("      TOURNAMENT ROUND %d OF %d\n", round, total_rounds);
+    printf("====================================\n");
+}
+
+void display_tournament_over(int rank, int entrants, const char *score) {
+    printf("\n");
+    printf("====================================\n");
+    printf("         TOURNAMENT OVER\n");
+    printf("====================================\n");
+    printf("Final Rank: %d of %d\n", rank, entrants);
+    printf("Score: %s\n", score);
+    printf("====================================\n");
+    printf("\n");
+}
+
+void display_rank(const char *name, int rank, int players, int rating, int wins, int losses, int draws) {
+    printf("%s: rank %d of %d, rating %d (%d W / %d L / %d D)\n", name, rank, players, rating, wins, losses, draws);
+}
@@ -1,14 +1,30 @@
 #ifndef UI_H
 #define UI_H
 
-void display_board(const char *board_string);
+typedef enum {
+    PLAYER_INPUT_QUIT,
+    PLAYER_INPUT_PASS,
+    PLAYER_INPUT_MOVE,
+    PLAYER_INPUT_RANK,
+    PLAYER_INPUT_UNDO,
+    PLAYER_INPUT_ACCEPT,
+    PLAYER_INPUT_DECLINE,
+    PLAYER_INPUT_INVALID
+} PlayerInput;
+
+void display_board(const char *board_string, int size);
 void display_status(const char *message);
 void display_welcome(const char *color);
 void display_waiting(void);
-int get_player_move(int *row, int *col);
-int parse_move_input(const char *input, int *row, int *col);
+void display_move_prompt(void);
+void display_undo_prompt(void);
+PlayerInput interpret_player_input(const char *input, int size, int *row, int *col);
+int parse_move_input(const char *input, int size, int *row, int *col);
 void display_error(const char *message);
 void display_opponent_move(int row, int col);
 void display_game_over(const char *result, const char *winner, int black_count, int white_count);
+void display_round(int round, int total_rounds);
+void display_tournament_over(int rank, int entrants, const char *score);
+void display_rank(const char *name, int rank, int players, int rating, int wins, int losses, int draws);
 
 #endif
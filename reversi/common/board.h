@@ -1,8 +1,10 @@
 #ifndef BOARD_H
 #define BOARD_H
 
-#define BOARD_WIDTH 8
-#define BOARD_HEIGHT 8
+#define BOARD_MIN_SIZE 6
+#define BOARD_DEFAULT_SIZE 8
+#define BOARD_MAX_SIZE 10
+#define BOARD_MAX_CELLS (BOARD_MAX_SIZE * BOARD_MAX_SIZE)
 
 #define CELL_EMPTY '.'
 #define CELL_BLACK 'B'
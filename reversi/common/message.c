@@ -0,0 +1,180 @@
+#include <string.h>
+#include "message.h"
+
+static char fold_upper(char character) {
+    if (character >= 'a' && character <= 'z') {
+        return (char)(character - 'a' + 'A');
+    }
+    return character;
+}
+
+static int opcode_equals(const char *opcode, const char *keyword, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        if (fold_upper(opcode[i]) != keyword[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+#define MATCH_OPCODE(keyword, message_type) \
+    (opcode_equals(opcode, (keyword), length) ? (message_type) : MESSAGE_TYPE_UNKNOWN)
+
+MessageType lookup_message_type(const char *opcode, size_t length) {
+    switch (length) {
+        case 3:
+            return MATCH_OPCODE(MESSAGE_BYE, MESSAGE_TYPE_BYE);
+        case 4:
+            switch (fold_upper(opcode[0])) {
+                case 'W': return MATCH_OPCODE(MESSAGE_WAIT, MESSAGE_TYPE_WAIT);
+                case 'M': return MATCH_OPCODE(MESSAGE_MOVE, MESSAGE_TYPE_MOVE);
+                case 'P':
+                    switch (fold_upper(opcode[1])) {
+                        case 'A': return MATCH_OPCODE(MESSAGE_PASS, MESSAGE_TYPE_PASS);
+                        case 'I': return MATCH_OPCODE(MESSAGE_PING, MESSAGE_TYPE_PING);
+                        case 'O': return MATCH_OPCODE(MESSAGE_PONG, MESSAGE_TYPE_PONG);
+                        default: return MESSAGE_TYPE_UNKNOWN;
+                    }
+                case 'Q': return MATCH_OPCODE(MESSAGE_QUIT, MESSAGE_TYPE_QUIT);
+                case 'N': return MATCH_OPCODE(MESSAGE_NAME, MESSAGE_TYPE_NAME);
+                case 'R': return MATCH_OPCODE(MESSAGE_RANK, MESSAGE_TYPE_RANK);
+                case 'U': return MATCH_OPCODE(MESSAGE_UNDO, MESSAGE_TYPE_UNDO);
+                default: return MESSAGE_TYPE_UNKNOWN;
+            }
+        case 5:
+            switch (fold_upper(opcode[0])) {
+                case 'S': return MATCH_OPCODE(MESSAGE_START, MESSAGE_TYPE_START);
+                case 'B': return MATCH_OPCODE(MESSAGE_BOARD, MESSAGE_TYPE_BOARD);
+                case 'V': return MATCH_OPCODE(MESSAGE_VALID, MESSAGE_TYPE_VALID);
+                case 'E': return MATCH_OPCODE(MESSAGE_ERROR, MESSAGE_TYPE_ERROR);
+                case 'R': return MATCH_OPCODE(MESSAGE_ROUND, MESSAGE_TYPE_ROUND);
+                default: return MESSAGE_TYPE_UNKNOWN;
+            }
+        case 7:
+            switch (fold_upper(opcode[0])) {
+                case 'W': return MATCH_OPCODE(MESSAGE_WELCOME, MESSAGE_TYPE_WELCOME);
+                case 'I': return MATCH_OPCODE(MESSAGE_INVALID, MESSAGE_TYPE_INVALID);
+                case 'P': return MATCH_OPCODE(MESSAGE_PREMOVE, MESSAGE_TYPE_PREMOVE);
+                case 'R': return MATCH_OPCODE(MESSAGE_REMATCH, MESSAGE_TYPE_REMATCH);
+                default: return MESSAGE_TYPE_UNKNOWN;
+            }
+        case 9:
+            switch (fold_upper(opcode[0])) {
+                case 'Y': return MATCH_OPCODE(MESSAGE_YOUR_TURN, MESSAGE_TYPE_YOUR_TURN);
+                case 'G': return MATCH_OPCODE(MESSAGE_GAME_OVER, MESSAGE_TYPE_GAME_OVER);
+                default: return MESSAGE_TYPE_UNKNOWN;
+            }
+        case 11:
+            return MATCH_OPCODE(MESSAGE_UNDO_ACCEPT, MESSAGE_TYPE_UNDO_ACCEPT);
+        case 12:
+            return MATCH_OPCODE(MESSAGE_UNDO_DECLINE, MESSAGE_TYPE_UNDO_DECLINE);
+        case 13:
+            switch (fold_upper(opcode[9])) {
+                case 'T': return MATCH_OPCODE(MESSAGE_OPPONENT_TURN, MESSAGE_TYPE_OPPONENT_TURN);
+                case 'M': return MATCH_OPCODE(MESSAGE_OPPONENT_MOVE, MESSAGE_TYPE_OPPONENT_MOVE);
+                case 'P': return MATCH_OPCODE(MESSAGE_OPPONENT_PASS, MESSAGE_TYPE_OPPONENT_PASS);
+                case 'L': return MATCH_OPCODE(MESSAGE_OPPONENT_LEFT, MESSAGE_TYPE_OPPONENT_LEFT);
+                default: return MESSAGE_TYPE_UNKNOWN;
+            }
+        case 15:
+            return MATCH_OPCODE(MESSAGE_TOURNAMENT_OVER, MESSAGE_TYPE_TOURNAMENT_OVER);
+        default:
+            return MESSAGE_TYPE_UNKNOWN;
+    }
+}
+
+static int is_line_space(char character) {
+    return character == ' ' || character == '\t' || character == '\r' || character == '\n';
+}
+
+int tokenize_message(char *line, ParsedMessage *message) {
+    char *end = line;
+    while (*end != '\0' && *end != '\n') {
+        end++;
+    }
+    while (end > line && is_line_space(end[-1])) {
+        end--;
+    }
+    *end = '\0';
+
+    char *cursor = line;
+    while (*cursor != '\0' && *cursor != '|') {
+        cursor++;
+    }
+
+    message->opcode = line;
+    message->opcode_length = (size_t)(cursor - line);
+    message->type = lookup_message_type(line, message->opcode_length);
+    message->field_count = 0;
+
+    while (*cursor == '|') {
+        *cursor++ = '\0';
+        if (message->field_count == MESSAGE_MAX_FIELDS) {
+            message->type = MESSAGE_TYPE_UNKNOWN;
+            return -1;
+        }
+        message->fields[message->field_count++] = cursor;
+        while (*cursor != '\0' && *cursor != '|') {
+            cursor++;
+        }
+    }
+
+    return message->type == MESSAGE_TYPE_UNKNOWN ? -1 : 0;
+}
+
+const char *message_field(const ParsedMessage *message, int index) {
+    if (index < 0 || index >= message->field_count) {
+        return NULL;
+    }
+    return message->fields[index];
+}
+
+int parse_message_int(const char *text, int *value) {
+    if (text == NULL) {
+        return -1;
+    }
+
+    while (*text == ' ' || *text == '\t') {
+        text++;
+    }
+
+    int negative = 0;
+    if (*text == '-' || *text == '+') {
+        negative = (*text == '-');
+        text++;
+    }
+
+    if (*text < '0' || *text > '9') {
+        return -1;
+    }
+
+    int result = 0;
+    int digits = 0;
+    while (*text >= '0' && *text <= '9') {
+        if (++digits > 9) {
+            return -1;
+        }
+        result = result * 10 + (*text - '0');
+        text++;
+    }
+
+    while (*text == ' ' || *text == '\t') {
+        text++;
+    }
+    if (*text != '\0') {
+        return -1;
+    }
+
+    *value = negative ? -result : result;
+    return 0;
+}
+
+int parse_message_coordinates(const ParsedMessage *message, int *row, int *col) {
+    if (message->field_count != 2) {
+        return -1;
+    }
+    if (parse_message_int(message->fields[0], row) < 0 || parse_message_int(message->fields[1], col) < 0) {
+        return -1;
+    }
+    return 0;
+}
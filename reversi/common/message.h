@@ -0,0 +1,23 @@
+#ifndef MESSAGE_H
+#define MESSAGE_H
+
+#include <stddef.h>
+#include "protocol.h"
+
+#define MESSAGE_MAX_FIELDS 8
+
+typedef struct {
+    MessageType type;
+    const char *opcode;
+    size_t opcode_length;
+    int field_count;
+    char *fields[MESSAGE_MAX_FIELDS];
+} ParsedMessage;
+
+MessageType lookup_message_type(const char *opcode, size_t length);
+int tokenize_message(char *line, ParsedMessage *message);
+const char *message_field(const ParsedMessage *message, int index);
+int parse_message_int(const char *text, int *value);
+int parse_message_coordinates(const ParsedMessage *message, int *row, int *col);
+
+#endif
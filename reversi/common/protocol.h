@@ -20,12 +20,22 @@
 #define MESSAGE_GAME_OVER "GAME_OVER"
 #define MESSAGE_OPPONENT_LEFT "OPPONENT_LEFT"
 #define MESSAGE_ERROR "ERROR"
+#define MESSAGE_ROUND "ROUND"
+#define MESSAGE_BYE "BYE"
+#define MESSAGE_TOURNAMENT_OVER "TOURNAMENT_OVER"
+#define MESSAGE_NAME "NAME"
+#define MESSAGE_RANK "RANK"
+#define MESSAGE_UNDO "UNDO"
+#define MESSAGE_UNDO_ACCEPT "UNDO_ACCEPT"
+#define MESSAGE_UNDO_DECLINE "UNDO_DECLINE"
+#define MESSAGE_PREMOVE "PREMOVE"
+#define MESSAGE_REMATCH "REMATCH"
+#define MESSAGE_PING "PING"
+#define MESSAGE_PONG "PONG"
 
 #define COLOR_BLACK "BLACK"
 #define COLOR_WHITE "WHITE"
 
-#define BOARD_SIZE 64
-
 #define MAX_MESSAGE_LENGTH 512
 
 typedef enum {
@@ -45,6 +55,18 @@ typedef enum {
     MESSAGE_TYPE_GAME_OVER,
     MESSAGE_TYPE_OPPONENT_LEFT,
     MESSAGE_TYPE_ERROR,
+    MESSAGE_TYPE_ROUND,
+    MESSAGE_TYPE_BYE,
+    MESSAGE_TYPE_TOURNAMENT_OVER,
+    MESSAGE_TYPE_NAME,
+    MESSAGE_TYPE_RANK,
+    MESSAGE_TYPE_UNDO,
+    MESSAGE_TYPE_UNDO_ACCEPT,
+    MESSAGE_TYPE_UNDO_DECLINE,
+    MESSAGE_TYPE_PREMOVE,
+    MESSAGE_TYPE_REMATCH,
+    MESSAGE_TYPE_PING,
+    MESSAGE_TYPE_PONG,
     MESSAGE_TYPE_UNKNOWN
 } MessageType;
 
@@ -0,0 +1,215 @@
+#include <string.h>
+#include "reversi.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define BATCH_HAVE_X86 1
+#include <immintrin.h>
+#else
+#define BATCH_HAVE_X86 0
+#endif
+
+#define BATCH_INNER_COLUMNS 0x7e7e7e7e7e7e7e7eULL
+
+typedef struct {
+    size_t lanes;
+    void (*legal_moves)(const ReversiBoardBatch *batch, uint64_t *moves);
+    void (*flips)(const ReversiBoardBatch *batch, const uint8_t *squares, uint64_t *flips);
+    void (*apply)(ReversiBoardBatch *batch, const uint8_t *squares, uint64_t *flips);
+} BatchKernels;
+
+#define BATCH_ISA scalar
+#define BATCH_LANES 1
+#define BATCH_TARGET
+#define BatchVector uint64_t
+#define BATCH_LOAD(pointer) (*(pointer))
+#define BATCH_STORE(pointer, value) (*(pointer) = (value))
+#define BATCH_LOAD_SQUARES(pointer) ((uint64_t)*(pointer))
+#define BATCH_SET1(value) ((uint64_t)(value))
+#define BATCH_AND(a, b) ((a) & (b))
+#define BATCH_OR(a, b) ((a) | (b))
+#define BATCH_ANDNOT(a, b) (~(a) & (b))
+#define BATCH_SHL(value, amount) ((value) << (amount))
+#define BATCH_SHR(value, amount) ((value) >> (amount))
+#define BATCH_SHLV(value, counts) ((counts) < 64 ? (value) << (counts) : 0)
+#define BATCH_KEEP_NONZERO(condition, value) ((condition) ? (value) : 0)
+#define BATCH_KEEP_ZERO(condition, value) ((condition) ? 0 : (value))
+#include "batch_kernel.h"
+#undef BATCH_LANES
+#undef BATCH_TARGET
+#undef BatchVector
+#undef BATCH_LOAD
+#undef BATCH_STORE
+#undef BATCH_LOAD_SQUARES
+#undef BATCH_SET1
+#undef BATCH_AND
+#undef BATCH_OR
+#undef BATCH_ANDNOT
+#undef BATCH_SHL
+#undef BATCH_SHR
+#undef BATCH_SHLV
+#undef BATCH_KEEP_NONZERO
+#undef BATCH_KEEP_ZERO
+
+#if BATCH_HAVE_X86
+static __attribute__((target("avx2"))) inline __m256i load_squares_avx2(const uint8_t *squares) {
+    int packed;
+    memcpy(&packed, squares, sizeof(packed));
+    return _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(packed));
+}
+
+#define BATCH_ISA avx2
+#define BATCH_LANES 4
+#define BATCH_TARGET __attribute__((target("avx2")))
+#define BatchVector __m256i
+#define BATCH_LOAD(pointer) _mm256_loadu_si256((const __m256i *)(pointer))
+#define BATCH_STORE(pointer, value) _mm256_storeu_si256((__m256i *)(pointer), (value))
+#define BATCH_LOAD_SQUARES(pointer) load_squares_avx2(pointer)
+#define BATCH_SET1(value) _mm256_set1_epi64x((long long)(value))
+#define BATCH_AND(a, b) _mm256_and_si256((a), (b))
+#define BATCH_OR(a, b) _mm256_or_si256((a), (b))
+#define BATCH_ANDNOT(a, b) _mm256_andnot_si256((a), (b))
+#define BATCH_SHL(value, amount) _mm256_slli_epi64((value), (amount))
+#define BATCH_SHR(value, amount) _mm256_srli_epi64((value), (amount))
+#define BATCH_SHLV(value, counts) _mm256_sllv_epi64((value), (counts))
+#define BATCH_KEEP_NONZERO(condition, value) \
+    _mm256_andnot_si256(_mm256_cmpeq_epi64((condition), _mm256_setzero_si256()), (value))
+#define BATCH_KEEP_ZERO(condition, value) \
+    _mm256_and_si256(_mm256_cmpeq_epi64((condition), _mm256_setzero_si256()), (value))
+#include "batch_kernel.h"
+#undef BATCH_LANES
+#undef BATCH_TARGET
+#undef BatchVector
+#undef BATCH_LOAD
+#undef BATCH_STORE
+#undef BATCH_LOAD_SQUARES
+#undef BATCH_SET1
+#undef BATCH_AND
+#undef BATCH_OR
+#undef BATCH_ANDNOT
+#undef BATCH_SHL
+#undef BATCH_SHR
+#undef BATCH_SHLV
+#undef BATCH_KEEP_NONZERO
+#undef BATCH_KEEP_ZERO
+
+#define BATCH_ISA avx512
+#define BATCH_LANES 8
+#define BATCH_TARGET __attribute__((target("avx512f")))
+#define BatchVector __m512i
+#define BATCH_LOAD(pointer) _mm512_loadu_si512((const void *)(pointer))
+#define BATCH_STORE(pointer, value) _mm512_storeu_si512((void *)(pointer), (value))
+#define BATCH_LOAD_SQUARES(pointer) _mm512_cvtepu8_epi64(_mm_loadl_epi64((const __m128i *)(pointer)))
+#define BATCH_SET1(value) _mm512_set1_epi64((long long)(value))
+#define BATCH_AND(a, b) _mm512_and_si512((a), (b))
+#define BATCH_OR(a, b) _mm512_or_si512((a), (b))
+#define BATCH_ANDNOT(a, b) _mm512_andnot_si512((a), (b))
+#define BATCH_SHL(value, amount) _mm512_slli_epi64((value), (amount))
+#define BATCH_SHR(value, amount) _mm512_srli_epi64((value), (amount))
+#define BATCH_SHLV(value, counts) _mm512_sllv_epi64((value), (counts))
+#define BATCH_KEEP_NONZERO(condition, value) \
+    _mm512_maskz_mov_epi64(_mm512_test_epi64_mask((condition), (condition)), (value))
+#define BATCH_KEEP_ZERO(condition, value) \
+    _mm512_maskz_mov_epi64(_mm512_testn_epi64_mask((condition), (condition)), (value))
+#include "batch_kernel.h"
+#undef BATCH_LANES
+#undef BATCH_TARGET
+#undef BatchVector
+#undef BATCH_LOAD
+#undef BATCH_STORE
+#undef BATCH_LOAD_SQUARES
+#undef BATCH_SET1
+#undef BATCH_AND
+#undef BATCH_OR
+#undef BATCH_ANDNOT
+#undef BATCH_SHL
+#undef BATCH_SHR
+#undef BATCH_SHLV
+#undef BATCH_KEEP_NONZERO
+#undef BATCH_KEEP_ZERO
+#endif
+
+static const BatchKernels batch_kernels[] = {
+    [REVERSI_BATCH_SCALAR] = { 1, batch_legal_moves_scalar, batch_flips_scalar, batch_apply_scalar },
+#if BATCH_HAVE_X86
+    [REVERSI_BATCH_AVX2] = { 4, batch_legal_moves_avx2, batch_flips_avx2, batch_apply_avx2 },
+    [REVERSI_BATCH_AVX512] = { 8, batch_legal_moves_avx512, batch_flips_avx512, batch_apply_avx512 },
+#endif
+};
+
+static const BatchKernels *active_kernels = NULL;
+
+static int isa_supported(ReversiBatchIsa isa) {
+    switch (isa) {
+        case REVERSI_BATCH_SCALAR:
+            return 1;
+#if BATCH_HAVE_X86
+        case REVERSI_BATCH_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+        case REVERSI_BATCH_AVX512:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx512f");
+#endif
+        default:
+            return 0;
+    }
+}
+
+static const BatchKernels *current_kernels(void) {
+    const BatchKernels *kernels = __atomic_load_n(&active_kernels, __ATOMIC_ACQUIRE);
+    if (kernels == NULL) {
+        ReversiBatchIsa isa = isa_supported(REVERSI_BATCH_AVX512) ? REVERSI_BATCH_AVX512 :
+                              isa_supported(REVERSI_BATCH_AVX2) ? REVERSI_BATCH_AVX2 : REVERSI_BATCH_SCALAR;
+        kernels = &batch_kernels[isa];
+        __atomic_store_n(&active_kernels, kernels, __ATOMIC_RELEASE);
+    }
+    return kernels;
+}
+
+static ReversiBoardBatch batch_tail(const ReversiBoardBatch *batch, size_t start) {
+    return (ReversiBoardBatch){ batch->player + start, batch->opponent + start, batch->count - start };
+}
+
+ReversiBatchIsa reversi_batch_isa(void) {
+    return (ReversiBatchIsa)(current_kernels() - batch_kernels);
+}
+
+int reversi_batch_use_isa(ReversiBatchIsa isa) {
+    if (!isa_supported(isa)) {
+        return -1;
+    }
+    __atomic_store_n(&active_kernels, &batch_kernels[isa], __ATOMIC_RELEASE);
+    return 0;
+}
+
+void reversi_batch_legal_moves(const ReversiBoardBatch *batch, uint64_t *moves) {
+    const BatchKernels *kernels = current_kernels();
+    size_t vectored = batch->count - batch->count % kernels->lanes;
+    ReversiBoardBatch tail = batch_tail(batch, vectored);
+
+    kernels->legal_moves(batch, moves);
+    batch_legal_moves_scalar(&tail, moves + vectored);
+}
+
+void reversi_batch_flips(const ReversiBoardBatch *batch, const uint8_t *squares, uint64_t *flips) {
+    const BatchKernels *kernels = current_kernels();
+    size_t vectored = batch->count - batch->count % kernels->lanes;
+    ReversiBoardBatch tail = batch_tail(batch, vectored);
+
+    kernels->flips(batch, squares, flips);
+    batch_flips_scalar(&tail, squares + vectored, flips + vectored);
+}
+
+size_t reversi_batch_apply(ReversiBoardBatch *batch, const uint8_t *squares, uint64_t *flips) {
+    const BatchKernels *kernels = current_kernels();
+    size_t vectored = batch->count - batch->count % kernels->lanes;
+    ReversiBoardBatch tail = batch_tail(batch, vectored);
+    size_t applied = 0;
+
+    kernels->apply(batch, squares, flips);
+    batch_apply_scalar(&tail, squares + vectored, flips + vectored);
+    for (size_t i = 0; i < batch->count; i++) {
+        applied += (flips[i] != 0);
+    }
+    return applied;
+}
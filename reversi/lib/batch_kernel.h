@@ -0,0 +1,100 @@
+#ifndef BATCH_ISA
+#error "define BATCH_ISA before including batch_kernel.h"
+#endif
+
+#define BATCH_PASTE(name, isa) name##_##isa
+#define BATCH_EXPAND(name, isa) BATCH_PASTE(name, isa)
+#define BATCH(name) BATCH_EXPAND(name, BATCH_ISA)
+
+#define BATCH_FILL(shift, amount, start, mask, run)                                        \
+    do {                                                                                   \
+        run = BATCH_AND(shift(start, amount), mask);                                       \
+        for (int step = 0; step < 5; step++) {                                             \
+            run = BATCH_OR(run, BATCH_AND(shift(run, amount), mask));                      \
+        }                                                                                  \
+    } while (0)
+
+#define BATCH_MOVES(shift, amount, mask)                                                   \
+    do {                                                                                   \
+        BatchVector run;                                                                   \
+        BATCH_FILL(shift, amount, player, mask, run);                                      \
+        moves = BATCH_OR(moves, BATCH_AND(shift(run, amount), empty));                     \
+    } while (0)
+
+#define BATCH_FLIPS(shift, amount, mask)                                                   \
+    do {                                                                                   \
+        BatchVector run;                                                                   \
+        BATCH_FILL(shift, amount, move, mask, run);                                        \
+        BatchVector bracket = BATCH_AND(shift(run, amount), player);                       \
+        flips = BATCH_OR(flips, BATCH_KEEP_NONZERO(bracket, run));                         \
+    } while (0)
+
+static BATCH_TARGET BatchVector BATCH(legal_moves)(BatchVector player, BatchVector opponent) {
+    BatchVector empty = BATCH_ANDNOT(BATCH_OR(player, opponent), BATCH_SET1(~0ULL));
+    BatchVector inner = BATCH_AND(opponent, BATCH_SET1(BATCH_INNER_COLUMNS));
+    BatchVector moves = BATCH_SET1(0);
+
+    BATCH_MOVES(BATCH_SHL, 1, inner);
+    BATCH_MOVES(BATCH_SHR, 1, inner);
+    BATCH_MOVES(BATCH_SHL, 8, opponent);
+    BATCH_MOVES(BATCH_SHR, 8, opponent);
+    BATCH_MOVES(BATCH_SHL, 7, inner);
+    BATCH_MOVES(BATCH_SHR, 7, inner);
+    BATCH_MOVES(BATCH_SHL, 9, inner);
+    BATCH_MOVES(BATCH_SHR, 9, inner);
+    return moves;
+}
+
+static BATCH_TARGET BatchVector BATCH(flips)(BatchVector player, BatchVector opponent, BatchVector squares) {
+    BatchVector empty = BATCH_ANDNOT(BATCH_OR(player, opponent), BATCH_SET1(~0ULL));
+    BatchVector move = BATCH_AND(BATCH_SHLV(BATCH_SET1(1), squares), empty);
+    BatchVector inner = BATCH_AND(opponent, BATCH_SET1(BATCH_INNER_COLUMNS));
+    BatchVector flips = BATCH_SET1(0);
+
+    BATCH_FLIPS(BATCH_SHL, 1, inner);
+    BATCH_FLIPS(BATCH_SHR, 1, inner);
+    BATCH_FLIPS(BATCH_SHL, 8, opponent);
+    BATCH_FLIPS(BATCH_SHR, 8, opponent);
+    BATCH_FLIPS(BATCH_SHL, 7, inner);
+    BATCH_FLIPS(BATCH_SHR, 7, inner);
+    BATCH_FLIPS(BATCH_SHL, 9, inner);
+    BATCH_FLIPS(BATCH_SHR, 9, inner);
+    return flips;
+}
+
+static BATCH_TARGET void BATCH(batch_legal_moves)(const ReversiBoardBatch *batch, uint64_t *moves) {
+    for (size_t i = 0; i + BATCH_LANES <= batch->count; i += BATCH_LANES) {
+        BATCH_STORE(moves + i, BATCH(legal_moves)(BATCH_LOAD(batch->player + i), BATCH_LOAD(batch->opponent + i)));
+    }
+}
+
+static BATCH_TARGET void BATCH(batch_flips)(const ReversiBoardBatch *batch, const uint8_t *squares, uint64_t *flips) {
+    for (size_t i = 0; i + BATCH_LANES <= batch->count; i += BATCH_LANES) {
+        BATCH_STORE(flips + i, BATCH(flips)(BATCH_LOAD(batch->player + i), BATCH_LOAD(batch->opponent + i),
+                                            BATCH_LOAD_SQUARES(squares + i)));
+    }
+}
+
+static BATCH_TARGET void BATCH(batch_apply)(ReversiBoardBatch *batch, const uint8_t *squares, uint64_t *flips) {
+    for (size_t i = 0; i + BATCH_LANES <= batch->count; i += BATCH_LANES) {
+        BatchVector player = BATCH_LOAD(batch->player + i);
+        BatchVector opponent = BATCH_LOAD(batch->opponent + i);
+        BatchVector squares_vector = BATCH_LOAD_SQUARES(squares + i);
+        BatchVector flipped = BATCH(flips)(player, opponent, squares_vector);
+        BatchVector placed = BATCH_OR(flipped, BATCH_SHLV(BATCH_SET1(1), squares_vector));
+
+        BATCH_STORE(flips + i, flipped);
+        BATCH_STORE(batch->player + i, BATCH_OR(BATCH_KEEP_ZERO(flipped, player),
+                                                BATCH_KEEP_NONZERO(flipped, BATCH_ANDNOT(flipped, opponent))));
+        BATCH_STORE(batch->opponent + i, BATCH_OR(BATCH_KEEP_ZERO(flipped, opponent),
+                                                  BATCH_KEEP_NONZERO(flipped, BATCH_OR(player, placed))));
+    }
+}
+
+#undef BATCH_FLIPS
+#undef BATCH_MOVES
+#undef BATCH_FILL
+#undef BATCH
+#undef BATCH_EXPAND
+#undef BATCH_PASTE
+#undef BATCH_ISA
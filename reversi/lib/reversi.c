@@ -0,0 +1,233 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "reversi.h"
+#include "../server/game.h"
+
+_Static_assert(REVERSI_MIN_SIZE == BOARD_MIN_SIZE && REVERSI_MAX_SIZE == BOARD_MAX_SIZE,
+               "public size limits track the engine");
+_Static_assert((int)REVERSI_BLACK == (int)PLAYER_BLACK && (int)REVERSI_WHITE == (int)PLAYER_WHITE,
+               "public colors track the engine");
+_Static_assert((int)REVERSI_DRAW == (int)GAME_STATUS_DRAW, "public statuses track the engine");
+
+#define REVERSI_HASH_SIDE_TO_MOVE 0x9e3779b97f4a7c15ULL
+
+struct ReversiGame {
+    GameState state;
+};
+
+static uint64_t mix64(uint64_t value) {
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+static void refresh_status(GameState *game) {
+    game->black_can_move = has_legal_moves(game, PLAYER_BLACK);
+    game->white_can_move = has_legal_moves(game, PLAYER_WHITE);
+    game->status = is_game_over(game) ? determine_winner(game) : GAME_STATUS_IN_PROGRESS;
+}
+
+unsigned reversi_version(void) {
+    return REVERSI_VERSION;
+}
+
+ReversiGame *reversi_create(int size) {
+    if (!is_supported_board_size(size)) {
+        return NULL;
+    }
+
+    ReversiGame *game = malloc(sizeof(*game));
+    if (game == NULL) {
+        return NULL;
+    }
+    initialize_sized_game(&game->state, size);
+    return game;
+}
+
+ReversiGame *reversi_clone(const ReversiGame *game) {
+    ReversiGame *copy = malloc(sizeof(*copy));
+    if (copy == NULL) {
+        return NULL;
+    }
+    memcpy(copy, game, sizeof(*copy));
+    return copy;
+}
+
+void reversi_destroy(ReversiGame *game) {
+    free(game);
+}
+
+int reversi_size(const ReversiGame *game) {
+    return game->state.size;
+}
+
+ReversiColor reversi_to_move(const ReversiGame *game) {
+    return (ReversiColor)game->state.current_player;
+}
+
+ReversiStatus reversi_status(const ReversiGame *game) {
+    return (ReversiStatus)game->state.status;
+}
+
+char reversi_cell(const ReversiGame *game, int row, int col) {
+    if (row < 0 || row >= game->state.size || col < 0 || col >= game->state.size) {
+        return '\0';
+    }
+    return game->state.board[row][col];
+}
+
+void reversi_count(const ReversiGame *game, int *black_count, int *white_count) {
+    count_pieces(&game->state, black_count, white_count);
+}
+
+int reversi_is_legal(const ReversiGame *game, int row, int col) {
+    return game->state.status == GAME_STATUS_IN_PROGRESS && is_valid_move(&game->state, row, col);
+}
+
+int reversi_legal_moves(const ReversiGame *game, int *squares, int max_squares) {
+    int size = game->state.size;
+    int count = 0;
+
+    if (game->state.status != GAME_STATUS_IN_PROGRESS) {
+        return 0;
+    }
+    for (int row = 0; row < size && count < max_squares; row++) {
+        for (int col = 0; col < size && count < max_squares; col++) {
+            if (is_valid_move(&game->state, row, col)) {
+                squares[count++] = row * size + col;
+            }
+        }
+    }
+    return count;
+}
+
+int reversi_apply_move(ReversiGame *game, int row, int col) {
+    if (game->state.status != GAME_STATUS_IN_PROGRESS || !execute_move(&game->state, row, col)) {
+        return -1;
+    }
+    return 0;
+}
+
+int reversi_pass(ReversiGame *game) {
+    if (game->state.status != GAME_STATUS_IN_PROGRESS ||
+        has_legal_moves(&game->state, game->state.current_player)) {
+        return -1;
+    }
+    pass_turn(&game->state);
+    return 0;
+}
+
+int reversi_undo(ReversiGame *game) {
+    return undo_move(&game->state) ? 0 : -1;
+}
+
+size_t reversi_serialize(const ReversiGame *game, char *buffer, size_t buffer_size) {
+    const GameState *state = &game->state;
+    int written = snprintf(buffer, buffer_size, "%d|%c|", state->size,
+                           state->current_player == PLAYER_BLACK ? CELL_BLACK : CELL_WHITE);
+    if (written < 0 || (size_t)written + (size_t)(state->size * state->size) >= buffer_size) {
+        return 0;
+    }
+
+    size_t length = (size_t)written;
+    for (int row = 0; row < state->size; row++) {
+        memcpy(buffer + length, state->board[row], (size_t)state->size);
+        length += (size_t)state->size;
+    }
+    buffer[length] = '\0';
+    return length;
+}
+
+int reversi_deserialize(ReversiGame *game, const char *text) {
+    char *end;
+    long size = strtol(text, &end, 10);
+    if (end == text || *end != '|' || !is_supported_board_size((int)size)) {
+        return -1;
+    }
+
+    char side = end[1];
+    const char *cells = end + 3;
+    if ((side != CELL_BLACK && side != CELL_WHITE) || end[2] != '|' || strlen(cells) != (size_t)(size * size)) {
+        return -1;
+    }
+    for (long i = 0; i < size * size; i++) {
+        if (cells[i] != CELL_EMPTY && cells[i] != CELL_BLACK && cells[i] != CELL_WHITE) {
+            return -1;
+        }
+    }
+
+    GameState *state = &game->state;
+    initialize_sized_game(state, (int)size);
+    for (int row = 0; row < state->size; row++) {
+        memcpy(state->board[row], cells + row * state->size, (size_t)state->size);
+    }
+    state->current_player = (side == CELL_BLACK) ? PLAYER_BLACK : PLAYER_WHITE;
+    refresh_status(state);
+    return 0;
+}
+
+uint64_t reversi_hash(const ReversiGame *game) {
+    const GameState *state = &game->state;
+    uint64_t hash = mix64(((uint64_t)state->size << 32) ^ REVERSI_HASH_SIDE_TO_MOVE);
+
+    for (int row = 0; row < state->size; row++) {
+        for (int col = 0; col < state->size; col++) {
+            char cell = state->board[row][col];
+            if (cell != CELL_EMPTY) {
+                uint64_t square = (uint64_t)(row * state->size + col);
+                hash ^= mix64((square << 1) | (cell == CELL_WHITE));
+            }
+        }
+    }
+    if (state->current_player == PLAYER_WHITE) {
+        hash ^= REVERSI_HASH_SIDE_TO_MOVE;
+    }
+    return hash;
+}
+
+int reversi_to_bitboards(const ReversiGame *game, uint64_t *player, uint64_t *opponent) {
+    const GameState *state = &game->state;
+    if (state->size != REVERSI_BITBOARD_SIZE) {
+        return -1;
+    }
+
+    char own_cell = (state->current_player == PLAYER_BLACK) ? CELL_BLACK : CELL_WHITE;
+    uint64_t own = 0;
+    uint64_t other = 0;
+    for (int row = 0; row < REVERSI_BITBOARD_SIZE; row++) {
+        for (int col = 0; col < REVERSI_BITBOARD_SIZE; col++) {
+            uint64_t bit = 1ULL << (row * REVERSI_BITBOARD_SIZE + col);
+            char cell = state->board[row][col];
+            if (cell == own_cell) {
+                own |= bit;
+            } else if (cell != CELL_EMPTY) {
+                other |= bit;
+            }
+        }
+    }
+    *player = own;
+    *opponent = other;
+    return 0;
+}
+
+int reversi_from_bitboards(ReversiGame *game, uint64_t player, uint64_t opponent, ReversiColor to_move) {
+    if ((player & opponent) != 0 || (to_move != REVERSI_BLACK && to_move != REVERSI_WHITE)) {
+        return -1;
+    }
+
+    GameState *state = &game->state;
+    char own_cell = (to_move == REVERSI_BLACK) ? CELL_BLACK : CELL_WHITE;
+    char other_cell = (to_move == REVERSI_BLACK) ? CELL_WHITE : CELL_BLACK;
+    initialize_sized_game(state, REVERSI_BITBOARD_SIZE);
+    for (int row = 0; row < REVERSI_BITBOARD_SIZE; row++) {
+        for (int col = 0; col < REVERSI_BITBOARD_SIZE; col++) {
+            uint64_t bit = 1ULL << (row * REVERSI_BITBOARD_SIZE + col);
+            state->board[row][col] = (player & bit) ? own_cell : (opponent & bit) ? other_cell : CELL_EMPTY;
+        }
+    }
+    state->current_player = (Player)to_move;
+    refresh_status(state);
+    return 0;
+}
@@ -0,0 +1,76 @@
+#ifndef REVERSI_H
+#define REVERSI_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define REVERSI_VERSION_MAJOR 1
+#define REVERSI_VERSION_MINOR 1
+#define REVERSI_VERSION_PATCH 0
+#define REVERSI_VERSION ((REVERSI_VERSION_MAJOR << 16) | (REVERSI_VERSION_MINOR << 8) | REVERSI_VERSION_PATCH)
+
+#define REVERSI_MIN_SIZE 6
+#define REVERSI_DEFAULT_SIZE 8
+#define REVERSI_MAX_SIZE 10
+#define REVERSI_MAX_SQUARES (REVERSI_MAX_SIZE * REVERSI_MAX_SIZE)
+#define REVERSI_SERIALIZED_LENGTH (REVERSI_MAX_SQUARES + 8)
+#define REVERSI_BITBOARD_SIZE 8
+
+typedef struct ReversiGame ReversiGame;
+
+typedef enum {
+    REVERSI_BLACK,
+    REVERSI_WHITE
+} ReversiColor;
+
+typedef enum {
+    REVERSI_IN_PROGRESS,
+    REVERSI_BLACK_WINS,
+    REVERSI_WHITE_WINS,
+    REVERSI_DRAW
+} ReversiStatus;
+
+typedef enum {
+    REVERSI_BATCH_SCALAR,
+    REVERSI_BATCH_AVX2,
+    REVERSI_BATCH_AVX512
+} ReversiBatchIsa;
+
+typedef struct {
+    uint64_t *player;
+    uint64_t *opponent;
+    size_t count;
+} ReversiBoardBatch;
+
+unsigned reversi_version(void);
+
+ReversiGame *reversi_create(int size);
+ReversiGame *reversi_clone(const ReversiGame *game);
+void reversi_destroy(ReversiGame *game);
+
+int reversi_size(const ReversiGame *game);
+ReversiColor reversi_to_move(const ReversiGame *game);
+ReversiStatus reversi_status(const ReversiGame *game);
+char reversi_cell(const ReversiGame *game, int row, int col);
+void reversi_count(const ReversiGame *game, int *black_count, int *white_count);
+
+int reversi_is_legal(const ReversiGame *game, int row, int col);
+int reversi_legal_moves(const ReversiGame *game, int *squares, int max_squares);
+int reversi_apply_move(ReversiGame *game, int row, int col);
+int reversi_pass(ReversiGame *game);
+int reversi_undo(ReversiGame *game);
+
+size_t reversi_serialize(const ReversiGame *game, char *buffer, size_t buffer_size);
+int reversi_deserialize(ReversiGame *game, const char *text);
+uint64_t reversi_hash(const ReversiGame *game);
+
+int reversi_to_bitboards(const ReversiGame *game, uint64_t *player, uint64_t *opponent);
+int reversi_from_bitboards(ReversiGame *game, uint64_t player, uint64_t opponent, ReversiColor to_move);
+
+ReversiBatchIsa reversi_batch_isa(void);
+int reversi_batch_use_isa(ReversiBatchIsa isa);
+void reversi_batch_legal_moves(const ReversiBoardBatch *batch, uint64_t *moves);
+void reversi_batch_flips(const ReversiBoardBatch *batch, const uint8_t *squares, uint64_t *flips);
+size_t reversi_batch_apply(ReversiBoardBatch *batch, const uint8_t *squares, uint64_t *flips);
+
+#endif
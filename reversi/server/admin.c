@@ -0,0 +1,365 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include "admin.h"
+#include "metrics.h"
+#include "log.h"
+#include "leaderboard.h"
+#include "gametable.h"
+#include "workers.h"
+#include "trace.h"
+
+typedef struct {
+    int fd;
+    int active;
+    uint64_t deadline_ns;
+    size_t request_length;
+    char request[ADMIN_REQUEST_SIZE];
+    char *response;
+    size_t response_length;
+    size_t response_sent;
+} AdminClient;
+
+static AdminClient admin_clients[ADMIN_MAX_CLIENTS];
+
+static void send_admin_response(AdminClient *client, const char *status, const char *body, size_t body_length) {
+    char header[256];
+    int header_length = snprintf(header, sizeof(header),
+                                 "HTTP/1.0 %s\r\n"
+                                 "Content-Type: text/plain; version=0.0.4\r\n"
+                                 "Content-Length: %zu\r\n"
+                                 "Connection: close\r\n\r\n",
+                                 status, body_length);
+
+    client->response = malloc((size_t)header_length + body_length);
+    if (client->response == NULL) {
+        return;
+    }
+    memcpy(client->response, header, (size_t)header_length);
+    memcpy(client->response + header_length, body, body_length);
+    client->response_length = (size_t)header_length + body_length;
+    client->response_sent = 0;
+    client->deadline_ns = metrics_now_ns() + (uint64_t)ADMIN_RESPONSE_TIMEOUT_MS * 1000000ULL;
+}
+
+static void send_method_not_allowed(AdminClient *client) {
+    const char *body = "use POST\n";
+    send_admin_response(client, "405 Method Not Allowed", body, strlen(body));
+}
+
+static void handle_log_level_request(AdminClient *client, const char *query, int is_post) {
+    char body[64];
+    const char *level_parameter = "?level=";
+
+    if (strncmp(query, level_parameter, strlen(level_parameter)) == 0) {
+        if (!is_post) {
+            send_method_not_allowed(client);
+            return;
+        }
+        char level_text[16];
+        size_t length = strcspn(query + strlen(level_parameter), " &\r\n");
+        LogLevel level;
+
+        if (length >= sizeof(level_text)) {
+            length = sizeof(level_text) - 1;
+        }
+        memcpy(level_text, query + strlen(level_parameter), length);
+        level_text[length] = '\0';
+
+        if (parse_log_level(level_text, &level) < 0) {
+            snprintf(body, sizeof(body), "unknown level %s\n", level_text);
+            send_admin_response(client, "400 Bad Request", body, strlen(body));
+            return;
+        }
+        log_set_level(level);
+        LOG_WARN("log_level_changed", LOG_TEXT("level", log_level_name(level)));
+    }
+
+    snprintf(body, sizeof(body), "%s\n", log_level_name(log_get_level()));
+    send_admin_response(client, "200 OK", body, strlen(body));
+}
+
+static void handle_leaderboard_request(AdminClient *client, const char *query) {
+    const char *top_parameter = "?top=";
+    int top = LEADERBOARD_DEFAULT_TOP;
+
+    if (strncmp(query, top_parameter, strlen(top_parameter)) == 0) {
+        top = atoi(query + strlen(top_parameter));
+        if (top <= 0) {
+            top = LEADERBOARD_DEFAULT_TOP;
+        }
+    }
+
+    char *body = malloc(ADMIN_RESPONSE_SIZE);
+    if (body != NULL) {
+        size_t body_length = render_leaderboard(body, ADMIN_RESPONSE_SIZE, top);
+        send_admin_response(client, "200 OK", body, body_length);
+        free(body);
+    }
+}
+
+static void handle_games_request(AdminClient *client, const char *path, int is_post) {
+    const char *stop_parameter = "/stop?id=";
+
+    if (strncmp(path, stop_parameter, strlen(stop_parameter)) == 0) {
+        if (!is_post) {
+            send_method_not_allowed(client);
+            return;
+        }
+        char body[64];
+        int game_id = atoi(path + strlen(stop_parameter));
+        if (game_id <= 0 || stop_pooled_game(game_id) < 0) {
+            snprintf(body, sizeof(body), "no live game %d\n", game_id);
+            send_admin_response(client, "404 Not Found", body, strlen(body));
+            return;
+        }
+        LOG_WARN("game_stop_requested", LOG_INT("game_id", game_id));
+        snprintf(body, sizeof(body), "stopping game %d\n", game_id);
+        send_admin_response(client, "200 OK", body, strlen(body));
+        return;
+    }
+
+    size_t body_size = game_table_render_size();
+    char *body = malloc(body_size);
+    if (body != NULL) {
+        size_t body_length = render_game_table(body, body_size, metrics_now_ns());
+        send_admin_response(client, "200 OK", body, body_length);
+        free(body);
+    }
+}
+
+static void handle_trace_request(AdminClient *client, const char *path, int is_post) {
+    const char *start_parameter = "/start?id=";
+    const char *stop_parameter = "/stop?id=";
+    const char *id_parameter = "?id=";
+    char body[64];
+
+    if ((strncmp(path, start_parameter, strlen(start_parameter)) == 0 ||
+         strncmp(path, stop_parameter, strlen(stop_parameter)) == 0) && !is_post) {
+        send_method_not_allowed(client);
+        return;
+    }
+
+    if (strncmp(path, start_parameter, strlen(start_parameter)) == 0) {
+        int game_id = atoi(path + strlen(start_parameter));
+        if (game_id <= 0 || trace_enable_game(game_id) < 0) {
+            snprintf(body, sizeof(body), "cannot trace game %d\n", game_id);
+            send_admin_response(client, "503 Service Unavailable", body, strlen(body));
+            return;
+        }
+        LOG_INFO("game_trace_started", LOG_INT("game_id", game_id));
+        snprintf(body, sizeof(body), "tracing game %d\n", game_id);
+        send_admin_response(client, "200 OK", body, strlen(body));
+        return;
+    }
+
+    if (strncmp(path, stop_parameter, strlen(stop_parameter)) == 0) {
+        int game_id = atoi(path + strlen(stop_parameter));
+        if (game_id <= 0 || trace_disable_game(game_id) < 0) {
+            snprintf(body, sizeof(body), "game %d not traced\n", game_id);
+            send_admin_response(client, "404 Not Found", body, strlen(body));
+            return;
+        }
+        LOG_INFO("game_trace_stopped", LOG_INT("game_id", game_id));
+        snprintf(body, sizeof(body), "stopped tracing game %d\n", game_id);
+        send_admin_response(client, "200 OK", body, strlen(body));
+        return;
+    }
+
+    int game_id = 0;
+    if (strncmp(path, id_parameter, strlen(id_parameter)) == 0) {
+        game_id = atoi(path + strlen(id_parameter));
+    }
+
+    char *trace = malloc(TRACE_RENDER_SIZE);
+    if (trace != NULL) {
+        size_t trace_length = render_chrome_trace(trace, TRACE_RENDER_SIZE, game_id);
+        send_admin_response(client, "200 OK", trace, trace_length);
+        free(trace);
+    }
+}
+
+static void route_admin_request(AdminClient *client) {
+    const char *request = client->request;
+    const char *path = NULL;
+    int is_post = 0;
+
+    if (strncmp(request, "GET ", strlen("GET ")) == 0) {
+        path = request + strlen("GET ");
+    } else if (strncmp(request, "POST ", strlen("POST ")) == 0) {
+        path = request + strlen("POST ");
+        is_post = 1;
+    }
+
+    if (client->request_length == 0 || (path != NULL && (strncmp(path, "/metrics", strlen("/metrics")) == 0 ||
+                                                        strncmp(path, "/ ", strlen("/ ")) == 0))) {
+        char *body = malloc(ADMIN_RESPONSE_SIZE);
+        if (body != NULL) {
+            size_t body_length = metrics_render_prometheus(body, ADMIN_RESPONSE_SIZE);
+            send_admin_response(client, "200 OK", body, body_length);
+            free(body);
+        }
+    } else if (path != NULL && strncmp(path, "/loglevel", strlen("/loglevel")) == 0) {
+        handle_log_level_request(client, path + strlen("/loglevel"), is_post);
+    } else if (path != NULL && strncmp(path, "/trace", strlen("/trace")) == 0) {
+        handle_trace_request(client, path + strlen("/trace"), is_post);
+    } else if (path != NULL && strncmp(path, "/games", strlen("/games")) == 0) {
+        handle_games_request(client, path + strlen("/games"), is_post);
+    } else if (path != NULL && strncmp(path, "/leaderboard", strlen("/leaderboard")) == 0) {
+        handle_leaderboard_request(client, path + strlen("/leaderboard"));
+    } else {
+        const char *body = "not found\n";
+        send_admin_response(client, "404 Not Found", body, strlen(body));
+    }
+}
+
+static void close_admin_client(AdminClient *client) {
+    close(client->fd);
+    free(client->response);
+    memset(client, 0, sizeof(*client));
+}
+
+static int request_complete(const AdminClient *client) {
+    return client->request_length == sizeof(client->request) - 1 || strstr(client->request, "\r\n\r\n") != NULL ||
+           strstr(client->request, "\n\n") != NULL;
+}
+
+static void read_admin_request(AdminClient *client) {
+    for (;;) {
+        size_t available = sizeof(client->request) - 1 - client->request_length;
+        ssize_t bytes_received = recv(client->fd, client->request + client->request_length, available, MSG_DONTWAIT);
+        if (bytes_received > 0) {
+            client->request_length += (size_t)bytes_received;
+            client->request[client->request_length] = '\0';
+            if (request_complete(client)) {
+                break;
+            }
+            continue;
+        }
+        if (bytes_received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes_received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        break;
+    }
+
+    route_admin_request(client);
+    if (client->response == NULL) {
+        close_admin_client(client);
+    }
+}
+
+static void write_admin_response(AdminClient *client) {
+    while (client->response_sent < client->response_length) {
+        ssize_t bytes_sent = send(client->fd, client->response + client->response_sent,
+                                  client->response_length - client->response_sent, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (bytes_sent > 0) {
+            client->response_sent += (size_t)bytes_sent;
+            continue;
+        }
+        if (bytes_sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes_sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        break;
+    }
+    close_admin_client(client);
+}
+
+void handle_admin_connection(int admin_socket) {
+    int client_socket = accept4(admin_socket, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (client_socket < 0) {
+        return;
+    }
+
+    for (int i = 0; i < ADMIN_MAX_CLIENTS; i++) {
+        AdminClient *client = &admin_clients[i];
+        if (!client->active) {
+            client->fd = client_socket;
+            client->active = 1;
+            client->deadline_ns = metrics_now_ns() + (uint64_t)ADMIN_REQUEST_TIMEOUT_MS * 1000000ULL;
+            return;
+        }
+    }
+
+    const char *busy = "HTTP/1.0 503 Service Unavailable\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    send(client_socket, busy, strlen(busy), MSG_NOSIGNAL | MSG_DONTWAIT);
+    close(client_socket);
+}
+
+int collect_admin_fds(struct pollfd *fds, int capacity) {
+    int count = 0;
+    for (int i = 0; i < ADMIN_MAX_CLIENTS && count < capacity; i++) {
+        if (admin_clients[i].active) {
+            fds[count].fd = admin_clients[i].fd;
+            fds[count].events = admin_clients[i].response != NULL ? POLLOUT : POLLIN;
+            fds[count].revents = 0;
+            count++;
+        }
+    }
+    return count;
+}
+
+void handle_admin_clients(const struct pollfd *fds, int count, uint64_t now_ns) {
+    for (int i = 0; i < ADMIN_MAX_CLIENTS; i++) {
+        AdminClient *client = &admin_clients[i];
+        if (!client->active) {
+            continue;
+        }
+
+        short revents = 0;
+        for (int j = 0; j < count; j++) {
+            if (fds[j].fd == client->fd) {
+                revents = fds[j].revents;
+            }
+        }
+
+        if (client->response == NULL) {
+            if (revents != 0) {
+                read_admin_request(client);
+            } else if (now_ns >= client->deadline_ns) {
+                route_admin_request(client);
+                if (client->response == NULL) {
+                    close_admin_client(client);
+                }
+            }
+        } else if (revents & (POLLERR | POLLHUP)) {
+            close_admin_client(client);
+        } else if (revents & POLLOUT) {
+            write_admin_response(client);
+        } else if (now_ns >= client->deadline_ns) {
+            close_admin_client(client);
+        }
+    }
+}
+
+int admin_timeout_ms(uint64_t now_ns) {
+    int timeout = -1;
+    for (int i = 0; i < ADMIN_MAX_CLIENTS; i++) {
+        if (!admin_clients[i].active) {
+            continue;
+        }
+        uint64_t deadline_ns = admin_clients[i].deadline_ns;
+        int remaining = deadline_ns > now_ns ? (int)((deadline_ns - now_ns + 999999) / 1000000) : 0;
+        if (timeout < 0 || remaining < timeout) {
+            timeout = remaining;
+        }
+    }
+    return timeout;
+}
+
+void close_admin_clients(void) {
+    for (int i = 0; i < ADMIN_MAX_CLIENTS; i++) {
+        if (admin_clients[i].active) {
+            close_admin_client(&admin_clients[i]);
+        }
+    }
+}
@@ -0,0 +1,19 @@
+#ifndef ADMIN_H
+#define ADMIN_H
+
+#include <stdint.h>
+#include <poll.h>
+
+#define ADMIN_RESPONSE_SIZE 65536
+#define ADMIN_REQUEST_SIZE 1024
+#define ADMIN_REQUEST_TIMEOUT_MS 100
+#define ADMIN_RESPONSE_TIMEOUT_MS 5000
+#define ADMIN_MAX_CLIENTS 8
+
+void handle_admin_connection(int admin_socket);
+int collect_admin_fds(struct pollfd *fds, int capacity);
+void handle_admin_clients(const struct pollfd *fds, int count, uint64_t now_ns);
+int admin_timeout_ms(uint64_t now_ns);
+void close_admin_clients(void);
+
+#endif
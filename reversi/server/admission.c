@@ -0,0 +1,131 @@
+#include <string.h>
+#include "admission.h"
+
+typedef struct {
+    uint32_t address;
+    uint32_t tokens;
+    uint64_t updated_ns;
+} AddressBucket;
+
+static AddressBucket address_buckets[ADMISSION_TABLE_CAPACITY];
+static admission_config limits = {
+    .max_connections = DEFAULT_MAX_CONNECTIONS,
+    .connect_rate = DEFAULT_CONNECT_RATE,
+    .connect_burst = DEFAULT_CONNECT_BURST
+};
+static uint64_t full_refill_ns = 0;
+
+static const char *DECISION_NAMES[] = { "accepted", "over_capacity", "rate_limited" };
+
+void configure_admission(const admission_config *config) {
+    limits = *config;
+    memset(address_buckets, 0, sizeof(address_buckets));
+    full_refill_ns = 0;
+    if (limits.connect_rate > 0) {
+        full_refill_ns = (uint64_t)limits.connect_burst * 1000000000ULL / limits.connect_rate;
+    }
+}
+
+const char *admission_decision_name(AdmissionDecision decision) {
+    return DECISION_NAMES[decision];
+}
+
+static uint32_t hash_address(uint32_t address) {
+    return (address * 0x9E3779B1u) >> (32 - ADMISSION_TABLE_BITS);
+}
+
+static int is_bucket_full(const AddressBucket *bucket, uint64_t now_ns) {
+    return now_ns - bucket->updated_ns >= full_refill_ns;
+}
+
+static AddressBucket *find_bucket(uint32_t address, uint64_t now_ns) {
+    uint32_t home = hash_address(address);
+    AddressBucket *reusable = NULL;
+    AddressBucket *oldest = NULL;
+
+    for (int probe = 0; probe < ADMISSION_MAX_PROBE; probe++) {
+        AddressBucket *bucket = &address_buckets[(home + (uint32_t)probe) & (ADMISSION_TABLE_CAPACITY - 1)];
+
+        if (bucket->address == address) {
+            return bucket;
+        }
+        if (bucket->address == 0) {
+            if (reusable == NULL) {
+                reusable = bucket;
+            }
+            break;
+        }
+        if (reusable == NULL && is_bucket_full(bucket, now_ns)) {
+            reusable = bucket;
+        }
+        if (oldest == NULL || bucket->updated_ns < oldest->updated_ns) {
+            oldest = bucket;
+        }
+    }
+
+    AddressBucket *bucket = (reusable != NULL) ? reusable : oldest;
+    bucket->address = address;
+    bucket->tokens = limits.connect_burst * ADMISSION_TOKEN_SCALE;
+    bucket->updated_ns = now_ns;
+    return bucket;
+}
+
+static int take_token(uint32_t address, uint64_t now_ns) {
+    if (limits.connect_rate == 0 || address == 0) {
+        return 1;
+    }
+
+    AddressBucket *bucket = find_bucket(address, now_ns);
+    uint64_t capacity = (uint64_t)limits.connect_burst * ADMISSION_TOKEN_SCALE;
+    uint64_t elapsed_ns = now_ns - bucket->updated_ns;
+
+    if (elapsed_ns >= full_refill_ns) {
+        bucket->tokens = (uint32_t)capacity;
+        bucket->updated_ns = now_ns;
+    } else {
+        uint64_t refill = elapsed_ns * limits.connect_rate / (1000000000ULL / ADMISSION_TOKEN_SCALE);
+        if (refill > 0) {
+            uint64_t tokens = bucket->tokens + refill;
+            if (tokens >= capacity) {
+                bucket->tokens = (uint32_t)capacity;
+                bucket->updated_ns = now_ns;
+            } else {
+                bucket->tokens = (uint32_t)tokens;
+                bucket->updated_ns += refill * (1000000000ULL / ADMISSION_TOKEN_SCALE) / limits.connect_rate;
+            }
+        }
+    }
+
+    if (bucket->tokens < ADMISSION_TOKEN_SCALE) {
+        return 0;
+    }
+    bucket->tokens -= ADMISSION_TOKEN_SCALE;
+    return 1;
+}
+
+AdmissionDecision admit_local_connection(int open_connections) {
+    if (limits.max_connections > 0 && open_connections >= limits.max_connections) {
+        return ADMISSION_OVER_CAPACITY;
+    }
+    return ADMISSION_ACCEPTED;
+}
+
+AdmissionDecision admit_connection(uint32_t address, int open_connections, uint64_t now_ns) {
+    if (admit_local_connection(open_connections) != ADMISSION_ACCEPTED) {
+        return ADMISSION_OVER_CAPACITY;
+    }
+    if (!take_token(address, now_ns)) {
+        return ADMISSION_RATE_LIMITED;
+    }
+    return ADMISSION_ACCEPTED;
+}
+
+int count_tracked_addresses(void) {
+    int count = 0;
+    for (int i = 0; i < ADMISSION_TABLE_CAPACITY; i++) {
+        if (address_buckets[i].address != 0) {
+            count++;
+        }
+    }
+    return count;
+}
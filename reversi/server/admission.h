@@ -0,0 +1,34 @@
+#ifndef ADMISSION_H
+#define ADMISSION_H
+
+#include <stdint.h>
+
+#define ADMISSION_TABLE_BITS 12
+#define ADMISSION_TABLE_CAPACITY (1 << ADMISSION_TABLE_BITS)
+#define ADMISSION_MAX_PROBE 16
+#define ADMISSION_TOKEN_SCALE 1000
+#define ADMISSION_MAX_CONNECT_RATE 1000000
+
+#define DEFAULT_MAX_CONNECTIONS 1024
+#define DEFAULT_CONNECT_RATE 20
+#define DEFAULT_CONNECT_BURST 40
+
+typedef enum {
+    ADMISSION_ACCEPTED,
+    ADMISSION_OVER_CAPACITY,
+    ADMISSION_RATE_LIMITED
+} AdmissionDecision;
+
+typedef struct {
+    int max_connections;
+    uint32_t connect_rate;
+    uint32_t connect_burst;
+} admission_config;
+
+void configure_admission(const admission_config *config);
+AdmissionDecision admit_connection(uint32_t address, int open_connections, uint64_t now_ns);
+AdmissionDecision admit_local_connection(int open_connections);
+const char *admission_decision_name(AdmissionDecision decision);
+int count_tracked_addresses(void);
+
+#endif
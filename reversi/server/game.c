@@ -1,6 +1,9 @@
 #include "game.h"
 #include <string.h>
 
+_Static_assert(BOARD_MAX_CELLS <= 64 * MOVE_FLIP_WORDS, "flip masks hold one bit per square");
+_Static_assert(BOARD_MAX_CELLS <= 127, "move records store squares in an int8_t");
+
 static const int DIRECTIONS[8][2] = {
     {-1, 0}, {-1, 1}, {0, 1}, {1, 1},
     {1, 0}, {1, -1}, {0, -1}, {-1, -1}
@@ -14,80 +17,94 @@ static char get_opponent_cell(Player player) {
     return (player == PLAYER_BLACK) ? CELL_WHITE : CELL_BLACK;
 }
 
-static bool is_within_bounds(int row, int col) {
-    return row >= 0 && row < BOARD_HEIGHT && col >= 0 && col < BOARD_WIDTH;
+static Player opponent_of(Player player) {
+    return (player == PLAYER_BLACK) ? PLAYER_WHITE : PLAYER_BLACK;
 }
 
-static int check_direction_for_flip(const GameState *game, int row, int col, int dir_row, int dir_col) {
-    char player_cell = get_player_cell(game->current_player);
-    char opponent_cell = get_opponent_cell(game->current_player);
-    
-    int current_row = row + dir_row;
-    int current_col = col + dir_col;
-    int count = 0;
-    
-    while (is_within_bounds(current_row, current_col)) {
-        char cell = game->board[current_row][current_col];
-        
-        if (cell == CELL_EMPTY) {
-            return 0;
-        }
-        
-        if (cell == opponent_cell) {
-            count++;
-            current_row += dir_row;
-            current_col += dir_col;
-            continue;
-        }
-        
-        if (cell == player_cell) {
-            return count;
-        }
-        
-        return 0;
+#define BOARD_KERNEL_SIZE 6
+#include "game_kernel.h"
+#define BOARD_KERNEL_SIZE 8
+#include "game_kernel.h"
+#define BOARD_KERNEL_SIZE 10
+#include "game_kernel.h"
+
+static bool is_valid_move_for(const GameState *game, Player player, int row, int col) {
+    switch (game->size) {
+        case 6:
+            return is_valid_move_6(game, player, row, col);
+        case 10:
+            return is_valid_move_10(game, player, row, col);
+        default:
+            return is_valid_move_8(game, player, row, col);
     }
-    
-    return 0;
-}
-
-static void flip_pieces_in_direction(GameState *game, int row, int col, int dir_row, int dir_col, int count) {
-    char player_cell = get_player_cell(game->current_player);
-    
-    int current_row = row + dir_row;
-    int current_col = col + dir_col;
-    
-    for (int i = 0; i < count; i++) {
-        game->board[current_row][current_col] = player_cell;
-        current_row += dir_row;
-        current_col += dir_col;
+}
+
+static void flip_discs(GameState *game, int row, int col, MoveRecord *record) {
+    switch (game->size) {
+        case 6:
+            flip_discs_6(game, row, col, record);
+            break;
+        case 10:
+            flip_discs_10(game, row, col, record);
+            break;
+        default:
+            flip_discs_8(game, row, col, record);
+            break;
     }
 }
 
-void initialize_game(GameState *game) {
-    for (int row = 0; row < BOARD_HEIGHT; row++) {
-        for (int col = 0; col < BOARD_WIDTH; col++) {
-            game->board[row][col] = CELL_EMPTY;
-        }
+static MoveRecord *push_move_record(GameState *game, int square) {
+    if (game->history_length >= MOVE_HISTORY_CAPACITY) {
+        memmove(game->history, game->history + 1, (MOVE_HISTORY_CAPACITY - 1) * sizeof(MoveRecord));
+        game->history_length--;
+    }
+
+    MoveRecord *record = &game->history[game->history_length++];
+    memset(record->flipped, 0, sizeof(record->flipped));
+    record->square = (int8_t)square;
+    record->player = (uint8_t)game->current_player;
+    record->status = (uint8_t)game->status;
+    record->black_can_move = game->black_can_move;
+    record->white_can_move = game->white_can_move;
+    return record;
+}
+
+bool is_supported_board_size(int size) {
+    return size == 6 || size == 8 || size == 10;
+}
+
+void initialize_sized_game(GameState *game, int size) {
+    if (!is_supported_board_size(size)) {
+        size = BOARD_DEFAULT_SIZE;
     }
-    
-    game->board[3][3] = CELL_WHITE;
-    game->board[3][4] = CELL_BLACK;
-    game->board[4][3] = CELL_BLACK;
-    game->board[4][4] = CELL_WHITE;
-    
+    memset(game->board, CELL_EMPTY, sizeof(game->board));
+    game->size = size;
+
+    int center = size / 2;
+    game->board[center - 1][center - 1] = CELL_WHITE;
+    game->board[center - 1][center] = CELL_BLACK;
+    game->board[center][center - 1] = CELL_BLACK;
+    game->board[center][center] = CELL_WHITE;
+
     game->current_player = PLAYER_BLACK;
     game->status = GAME_STATUS_IN_PROGRESS;
     game->black_can_move = true;
     game->white_can_move = true;
+    game->history_length = 0;
+}
+
+void initialize_game(GameState *game) {
+    initialize_sized_game(game, BOARD_DEFAULT_SIZE);
 }
 
 void initialize_test_game(GameState *game) {
-    for (int row = 0; row < BOARD_HEIGHT; row++) {
-        for (int col = 0; col < BOARD_WIDTH; col++) {
+    initialize_sized_game(game, BOARD_DEFAULT_SIZE);
+    for (int row = 0; row < BOARD_DEFAULT_SIZE; row++) {
+        for (int col = 0; col < BOARD_DEFAULT_SIZE; col++) {
             game->board[row][col] = CELL_BLACK;
         }
     }
-    
+
     game->board[0][7] = CELL_EMPTY;
     game->board[1][7] = CELL_WHITE;
     game->board[2][7] = CELL_WHITE;
@@ -98,77 +115,81 @@ void initialize_test_game(GameState *game) {
     game->board[7][7] = CELL_WHITE;
     game->board[7][6] = CELL_WHITE;
     game->board[7][5] = CELL_WHITE;
-    
-    game->current_player = PLAYER_BLACK;
-    game->status = GAME_STATUS_IN_PROGRESS;
-    game->black_can_move = true;
-    game->white_can_move = true;
 }
 
 bool is_valid_move(const GameState *game, int row, int col) {
-    if (!is_within_bounds(row, col)) {
-        return false;
-    }
-    
-    if (game->board[row][col] != CELL_EMPTY) {
-        return false;
-    }
-    
-    for (int i = 0; i < 8; i++) {
-        int dir_row = DIRECTIONS[i][0];
-        int dir_col = DIRECTIONS[i][1];
-        
-        if (check_direction_for_flip(game, row, col, dir_row, dir_col) > 0) {
-            return true;
-        }
-    }
-    
-    return false;
+    return is_valid_move_for(game, game->current_player, row, col);
 }
 
 bool execute_move(GameState *game, int row, int col) {
     if (!is_valid_move(game, row, col)) {
         return false;
     }
-    
-    char player_cell = get_player_cell(game->current_player);
-    game->board[row][col] = player_cell;
-    
-    for (int i = 0; i < 8; i++) {
-        int dir_row = DIRECTIONS[i][0];
-        int dir_col = DIRECTIONS[i][1];
-        int flip_count = check_direction_for_flip(game, row, col, dir_row, dir_col);
-        
-        if (flip_count > 0) {
-            flip_pieces_in_direction(game, row, col, dir_row, dir_col, flip_count);
-        }
-    }
-    
-    game->current_player = (game->current_player == PLAYER_BLACK) ? PLAYER_WHITE : PLAYER_BLACK;
-    
+
+    MoveRecord *record = push_move_record(game, row * BOARD_MAX_SIZE + col);
+    game->board[row][col] = get_player_cell(game->current_player);
+    flip_discs(game, row, col, record);
+
+    game->current_player = opponent_of(game->current_player);
+
     game->black_can_move = has_legal_moves(game, PLAYER_BLACK);
     game->white_can_move = has_legal_moves(game, PLAYER_WHITE);
-    
+
     if (is_game_over(game)) {
         game->status = determine_winner(game);
     }
-    
+
     return true;
 }
 
-bool has_legal_moves(const GameState *game, Player player) {
-    GameState temp_game = *game;
-    temp_game.current_player = player;
-    
-    for (int row = 0; row < BOARD_HEIGHT; row++) {
-        for (int col = 0; col < BOARD_WIDTH; col++) {
-            if (is_valid_move(&temp_game, row, col)) {
-                return true;
+void pass_turn(GameState *game) {
+    push_move_record(game, MOVE_PASS);
+    game->current_player = opponent_of(game->current_player);
+}
+
+bool undo_move(GameState *game) {
+    if (game->history_length == 0) {
+        return false;
+    }
+
+    const MoveRecord *record = &game->history[--game->history_length];
+    Player player = (Player)record->player;
+
+    if (record->square != MOVE_PASS) {
+        char opponent_cell = get_opponent_cell(player);
+        game->board[record->square / BOARD_MAX_SIZE][record->square % BOARD_MAX_SIZE] = CELL_EMPTY;
+        for (int word = 0; word < MOVE_FLIP_WORDS; word++) {
+            for (uint64_t flipped = record->flipped[word]; flipped != 0; flipped &= flipped - 1) {
+                int square = word * 64 + __builtin_ctzll(flipped);
+                game->board[square / BOARD_MAX_SIZE][square % BOARD_MAX_SIZE] = opponent_cell;
             }
         }
     }
-    
-    return false;
+
+    game->current_player = player;
+    game->status = (GameStatus)record->status;
+    game->black_can_move = record->black_can_move;
+    game->white_can_move = record->white_can_move;
+    return true;
+}
+
+int count_moves_by(const GameState *game, Player player) {
+    int moves = 0;
+    for (int i = 0; i < game->history_length; i++) {
+        moves += (game->history[i].square != MOVE_PASS && game->history[i].player == (uint8_t)player);
+    }
+    return moves;
+}
+
+bool has_legal_moves(const GameState *game, Player player) {
+    switch (game->size) {
+        case 6:
+            return has_legal_moves_6(game, player);
+        case 10:
+            return has_legal_moves_10(game, player);
+        default:
+            return has_legal_moves_8(game, player);
+    }
 }
 
 bool is_game_over(const GameState *game) {
@@ -176,24 +197,23 @@ bool is_game_over(const GameState *game) {
 }
 
 void count_pieces(const GameState *game, int *black_count, int *white_count) {
-    *black_count = 0;
-    *white_count = 0;
-    
-    for (int row = 0; row < BOARD_HEIGHT; row++) {
-        for (int col = 0; col < BOARD_WIDTH; col++) {
-            if (game->board[row][col] == CELL_BLACK) {
-                (*black_count)++;
-            } else if (game->board[row][col] == CELL_WHITE) {
-                (*white_count)++;
-            }
-        }
+    switch (game->size) {
+        case 6:
+            count_pieces_6(game, black_count, white_count);
+            break;
+        case 10:
+            count_pieces_10(game, black_count, white_count);
+            break;
+        default:
+            count_pieces_8(game, black_count, white_count);
+            break;
     }
 }
 
 GameStatus determine_winner(const GameState *game) {
     int black_count, white_count;
     count_pieces(game, &black_count, &white_count);
-    
+
     if (black_count > white_count) {
         return GAME_STATUS_BLACK_WINS;
     } else if (white_count > black_count) {
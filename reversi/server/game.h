@@ -3,6 +3,11 @@
 
 #include "../common/board.h"
 #include <stdbool.h>
+#include <stdint.h>
+
+#define MOVE_HISTORY_CAPACITY (2 * BOARD_MAX_CELLS)
+#define MOVE_FLIP_WORDS ((BOARD_MAX_CELLS + 63) / 64)
+#define MOVE_PASS -1
 
 typedef enum {
     GAME_STATUS_IN_PROGRESS,
@@ -17,17 +22,34 @@ typedef enum {
 } Player;
 
 typedef struct {
-    char board[BOARD_HEIGHT][BOARD_WIDTH];
+    uint64_t flipped[MOVE_FLIP_WORDS];
+    int8_t square;
+    uint8_t player;
+    uint8_t status;
+    bool black_can_move;
+    bool white_can_move;
+} MoveRecord;
+
+typedef struct {
+    char board[BOARD_MAX_SIZE][BOARD_MAX_SIZE];
+    int size;
     Player current_player;
     GameStatus status;
     bool black_can_move;
     bool white_can_move;
+    int history_length;
+    MoveRecord history[MOVE_HISTORY_CAPACITY];
 } GameState;
 
+bool is_supported_board_size(int size);
 void initialize_game(GameState *game);
+void initialize_sized_game(GameState *game, int size);
 void initialize_test_game(GameState *game);
 bool is_valid_move(const GameState *game, int row, int col);
 bool execute_move(GameState *game, int row, int col);
+void pass_turn(GameState *game);
+bool undo_move(GameState *game);
+int count_moves_by(const GameState *game, Player player);
 bool has_legal_moves(const GameState *game, Player player);
 bool is_game_over(const GameState *game);
 void count_pieces(const GameState *game, int *black_count, int *white_count);
@@ -0,0 +1,87 @@
+#ifndef BOARD_KERNEL_SIZE
+#error "define BOARD_KERNEL_SIZE before including game_kernel.h"
+#endif
+
+#define KERNEL_PASTE(name, size) name##_##size
+#define KERNEL_EXPAND(name, size) KERNEL_PASTE(name, size)
+#define KERNEL(name) KERNEL_EXPAND(name, BOARD_KERNEL_SIZE)
+
+static inline int KERNEL(count_flips)(const GameState *game, char own_cell, char other_cell,
+                                      int row, int col, int dir_row, int dir_col) {
+    int current_row = row + dir_row;
+    int current_col = col + dir_col;
+    int count = 0;
+
+    while ((unsigned)current_row < BOARD_KERNEL_SIZE && (unsigned)current_col < BOARD_KERNEL_SIZE) {
+        char cell = game->board[current_row][current_col];
+        if (cell != other_cell) {
+            return (cell == own_cell) ? count : 0;
+        }
+        count++;
+        current_row += dir_row;
+        current_col += dir_col;
+    }
+    return 0;
+}
+
+static bool KERNEL(is_valid_move)(const GameState *game, Player player, int row, int col) {
+    if ((unsigned)row >= BOARD_KERNEL_SIZE || (unsigned)col >= BOARD_KERNEL_SIZE ||
+        game->board[row][col] != CELL_EMPTY) {
+        return false;
+    }
+
+    char own_cell = get_player_cell(player);
+    char other_cell = get_opponent_cell(player);
+    for (int i = 0; i < 8; i++) {
+        if (KERNEL(count_flips)(game, own_cell, other_cell, row, col, DIRECTIONS[i][0], DIRECTIONS[i][1]) > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void KERNEL(flip_discs)(GameState *game, int row, int col, MoveRecord *record) {
+    char own_cell = get_player_cell(game->current_player);
+    char other_cell = get_opponent_cell(game->current_player);
+
+    for (int i = 0; i < 8; i++) {
+        int dir_row = DIRECTIONS[i][0];
+        int dir_col = DIRECTIONS[i][1];
+        int count = KERNEL(count_flips)(game, own_cell, other_cell, row, col, dir_row, dir_col);
+
+        for (int step = 1; step <= count; step++) {
+            int square = (row + step * dir_row) * BOARD_MAX_SIZE + (col + step * dir_col);
+            game->board[row + step * dir_row][col + step * dir_col] = own_cell;
+            record->flipped[square / 64] |= 1ULL << (square % 64);
+        }
+    }
+}
+
+static bool KERNEL(has_legal_moves)(const GameState *game, Player player) {
+    for (int row = 0; row < BOARD_KERNEL_SIZE; row++) {
+        for (int col = 0; col < BOARD_KERNEL_SIZE; col++) {
+            if (KERNEL(is_valid_move)(game, player, row, col)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static void KERNEL(count_pieces)(const GameState *game, int *black_count, int *white_count) {
+    int black = 0;
+    int white = 0;
+    for (int row = 0; row < BOARD_KERNEL_SIZE; row++) {
+        for (int col = 0; col < BOARD_KERNEL_SIZE; col++) {
+            black += (game->board[row][col] == CELL_BLACK);
+            white += (game->board[row][col] == CELL_WHITE);
+        }
+    }
+    *black_count = black;
+    *white_count = white;
+}
+
+#undef KERNEL
+#undef KERNEL_EXPAND
+#undef KERNEL_PASTE
+#undef BOARD_KERNEL_SIZE
@@ -0,0 +1,272 @@
+#include <stdio.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include "gametable.h"
+#include "metrics.h"
+
+enum {
+    SLOT_FREE,
+    SLOT_CLAIMED
+};
+
+typedef struct {
+    _Alignas(64) _Atomic uint32_t sequence;
+    _Atomic int32_t state;
+    _Atomic int32_t pid;
+    _Atomic int32_t game_id;
+    _Atomic int32_t current_player;
+    _Atomic int32_t move_count;
+    _Atomic int32_t black_count;
+    _Atomic int32_t white_count;
+    _Atomic int32_t board_size;
+    _Atomic uint64_t started_ns;
+    _Atomic uint64_t heartbeat_ns;
+    _Atomic uint32_t rtt_us[2];
+    _Atomic uint64_t board_words[GAME_TABLE_BOARD_WORDS];
+} GameSlot;
+
+static GameSlot *slots = NULL;
+static int slot_count = 0;
+static int next_free_hint = 0;
+
+int initialize_game_table(int requested_slots) {
+    if (requested_slots <= 0) {
+        requested_slots = GAME_TABLE_DEFAULT_SLOTS;
+    }
+    void *memory = mmap(NULL, sizeof(GameSlot) * (size_t)requested_slots, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        perror("game table mmap failed");
+        return -1;
+    }
+
+    slots = memory;
+    slot_count = requested_slots;
+    return 0;
+}
+
+static void write_begin(GameSlot *slot) {
+    uint32_t sequence = atomic_load_explicit(&slot->sequence, memory_order_relaxed);
+    atomic_store_explicit(&slot->sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+static void write_end(GameSlot *slot) {
+    uint32_t sequence = atomic_load_explicit(&slot->sequence, memory_order_relaxed);
+    atomic_store_explicit(&slot->sequence, sequence + 1, memory_order_release);
+}
+
+static void store_board(GameSlot *slot, const GameState *game) {
+    int cells = game->size * game->size;
+    for (int word = 0; word * 8 < cells; word++) {
+        uint64_t packed = 0;
+        for (int byte = 0; byte < 8 && word * 8 + byte < cells; byte++) {
+            int cell = word * 8 + byte;
+            packed |= (uint64_t)(unsigned char)game->board[cell / game->size][cell % game->size] << (byte * 8);
+        }
+        atomic_store_explicit(&slot->board_words[word], packed, memory_order_relaxed);
+    }
+}
+
+static void store_state(GameSlot *slot, const GameState *game, int move_count) {
+    int black_count;
+    int white_count;
+    count_pieces(game, &black_count, &white_count);
+
+    write_begin(slot);
+    atomic_store_explicit(&slot->current_player, (int32_t)game->current_player, memory_order_relaxed);
+    atomic_store_explicit(&slot->move_count, move_count, memory_order_relaxed);
+    atomic_store_explicit(&slot->black_count, black_count, memory_order_relaxed);
+    atomic_store_explicit(&slot->white_count, white_count, memory_order_relaxed);
+    atomic_store_explicit(&slot->board_size, game->size, memory_order_relaxed);
+    store_board(slot, game);
+    write_end(slot);
+}
+
+int claim_game_slot(int game_id) {
+    if (slots == NULL) {
+        return -1;
+    }
+
+    for (int probe = 0; probe < slot_count; probe++) {
+        int index = (next_free_hint + probe) % slot_count;
+        GameSlot *slot = &slots[index];
+        if (atomic_load_explicit(&slot->state, memory_order_acquire) != SLOT_FREE) {
+            continue;
+        }
+
+        uint64_t now = metrics_now_ns();
+        write_begin(slot);
+        atomic_store_explicit(&slot->pid, 0, memory_order_relaxed);
+        atomic_store_explicit(&slot->game_id, game_id, memory_order_relaxed);
+        atomic_store_explicit(&slot->started_ns, now, memory_order_relaxed);
+        atomic_store_explicit(&slot->heartbeat_ns, now, memory_order_relaxed);
+        atomic_store_explicit(&slot->rtt_us[PLAYER_BLACK], 0, memory_order_relaxed);
+        atomic_store_explicit(&slot->rtt_us[PLAYER_WHITE], 0, memory_order_relaxed);
+        write_end(slot);
+
+        GameState initial;
+        initialize_game(&initial);
+        store_state(slot, &initial, 0);
+        atomic_store_explicit(&slot->state, SLOT_CLAIMED, memory_order_release);
+        next_free_hint = (index + 1) % slot_count;
+        return index;
+    }
+    return -1;
+}
+
+void assign_game_slot_process(int slot, pid_t pid) {
+    if (slots == NULL || slot < 0) {
+        return;
+    }
+    atomic_store_explicit(&slots[slot].pid, (int32_t)pid, memory_order_release);
+}
+
+void release_game_slot(int slot) {
+    if (slots == NULL || slot < 0) {
+        return;
+    }
+    atomic_store_explicit(&slots[slot].pid, 0, memory_order_relaxed);
+    atomic_store_explicit(&slots[slot].state, SLOT_FREE, memory_order_release);
+}
+
+void release_process_slots(pid_t pid) {
+    if (slots == NULL) {
+        return;
+    }
+    for (int i = 0; i < slot_count; i++) {
+        if (atomic_load_explicit(&slots[i].pid, memory_order_relaxed) == (int32_t)pid) {
+            release_game_slot(i);
+        }
+    }
+}
+
+void publish_game_state(int slot, const GameState *game, int move_count) {
+    if (slots == NULL || slot < 0) {
+        return;
+    }
+    store_state(&slots[slot], game, move_count);
+    atomic_store_explicit(&slots[slot].heartbeat_ns, metrics_now_ns(), memory_order_relaxed);
+}
+
+void touch_game_slot(int slot, uint64_t now_ns) {
+    if (slots == NULL || slot < 0) {
+        return;
+    }
+    atomic_store_explicit(&slots[slot].heartbeat_ns, now_ns, memory_order_relaxed);
+}
+
+void publish_player_rtt(int slot, Player player, uint64_t rtt_ns) {
+    if (slots == NULL || slot < 0) {
+        return;
+    }
+    uint64_t rtt_us = rtt_ns / 1000;
+    atomic_store_explicit(&slots[slot].rtt_us[player], rtt_us > UINT32_MAX ? UINT32_MAX : (uint32_t)rtt_us,
+                          memory_order_relaxed);
+}
+
+int read_game_slot(int slot, GameSnapshot *snapshot) {
+    if (slots == NULL || slot < 0 || slot >= slot_count) {
+        return 0;
+    }
+
+    GameSlot *source = &slots[slot];
+    if (atomic_load_explicit(&source->state, memory_order_acquire) != SLOT_CLAIMED) {
+        return 0;
+    }
+
+    for (int attempt = 0; attempt < GAME_TABLE_READ_RETRIES; attempt++) {
+        uint32_t before = atomic_load_explicit(&source->sequence, memory_order_acquire);
+        if (before & 1) {
+            continue;
+        }
+
+        snapshot->game_id = atomic_load_explicit(&source->game_id, memory_order_relaxed);
+        snapshot->current_player = (Player)atomic_load_explicit(&source->current_player, memory_order_relaxed);
+        snapshot->move_count = atomic_load_explicit(&source->move_count, memory_order_relaxed);
+        snapshot->black_count = atomic_load_explicit(&source->black_count, memory_order_relaxed);
+        snapshot->white_count = atomic_load_explicit(&source->white_count, memory_order_relaxed);
+        snapshot->started_ns = atomic_load_explicit(&source->started_ns, memory_order_relaxed);
+        int size = atomic_load_explicit(&source->board_size, memory_order_relaxed);
+        int cells = (size >= BOARD_MIN_SIZE && size <= BOARD_MAX_SIZE) ? size * size : 0;
+        for (int word = 0; word * 8 < cells; word++) {
+            uint64_t packed = atomic_load_explicit(&source->board_words[word], memory_order_relaxed);
+            for (int byte = 0; byte < 8 && word * 8 + byte < cells; byte++) {
+                snapshot->board[word * 8 + byte] = (char)(packed >> (byte * 8));
+            }
+        }
+        atomic_thread_fence(memory_order_acquire);
+
+        if (atomic_load_explicit(&source->sequence, memory_order_relaxed) == before) {
+            snapshot->board_size = size;
+            snapshot->board[cells] = '\0';
+            snapshot->pid = (pid_t)atomic_load_explicit(&source->pid, memory_order_relaxed);
+            snapshot->heartbeat_ns = atomic_load_explicit(&source->heartbeat_ns, memory_order_relaxed);
+            snapshot->rtt_us[PLAYER_BLACK] = atomic_load_explicit(&source->rtt_us[PLAYER_BLACK], memory_order_relaxed);
+            snapshot->rtt_us[PLAYER_WHITE] = atomic_load_explicit(&source->rtt_us[PLAYER_WHITE], memory_order_relaxed);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int count_live_games(void) {
+    int count = 0;
+    if (slots == NULL) {
+        return 0;
+    }
+    for (int i = 0; i < slot_count; i++) {
+        if (atomic_load_explicit(&slots[i].state, memory_order_relaxed) == SLOT_CLAIMED) {
+            count++;
+        }
+    }
+    return count;
+}
+
+pid_t find_game_process(int game_id) {
+    GameSnapshot snapshot;
+    for (int i = 0; i < slot_count; i++) {
+        if (read_game_slot(i, &snapshot) && snapshot.game_id == game_id && snapshot.pid > 0) {
+            return snapshot.pid;
+        }
+    }
+    return -1;
+}
+
+size_t game_table_render_size(void) {
+    return (size_t)(slot_count > 0 ? slot_count : 1) * GAME_TABLE_RENDER_ROW_SIZE;
+}
+
+static double seconds_since(uint64_t now_ns, uint64_t then_ns) {
+    return (now_ns > then_ns) ? (double)(now_ns - then_ns) / 1e9 : 0.0;
+}
+
+size_t render_game_table(char *buffer, size_t buffer_size, uint64_t now_ns) {
+    size_t offset = 0;
+    int written = snprintf(buffer, buffer_size, "# game_id pid turn moves black white age_s idle_s size board rtt_ms (%d live)\n",
+                           count_live_games());
+    if (written < 0 || (size_t)written >= buffer_size) {
+        return 0;
+    }
+    offset = (size_t)written;
+
+    GameSnapshot snapshot;
+    for (int i = 0; i < slot_count; i++) {
+        if (!read_game_slot(i, &snapshot)) {
+            continue;
+        }
+        written = snprintf(buffer + offset, buffer_size - offset, "%d %d %s %d %d %d %.1f %.1f %dx%d %s %.1f/%.1f\n",
+                           snapshot.game_id, (int)snapshot.pid,
+                           snapshot.current_player == PLAYER_BLACK ? "BLACK" : "WHITE",
+                           snapshot.move_count, snapshot.black_count, snapshot.white_count,
+                           seconds_since(now_ns, snapshot.started_ns),
+                           seconds_since(now_ns, snapshot.heartbeat_ns),
+                           snapshot.board_size, snapshot.board_size, snapshot.board,
+                           snapshot.rtt_us[PLAYER_BLACK] / 1000.0, snapshot.rtt_us[PLAYER_WHITE] / 1000.0);
+        if (written < 0 || (size_t)written >= buffer_size - offset) {
+            break;
+        }
+        offset += (size_t)written;
+    }
+    return offset;
+}
@@ -0,0 +1,43 @@
+#ifndef GAMETABLE_H
+#define GAMETABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include "game.h"
+
+#define GAME_TABLE_DEFAULT_SLOTS 1024
+#define GAME_TABLE_CELLS BOARD_MAX_CELLS
+#define GAME_TABLE_BOARD_WORDS ((GAME_TABLE_CELLS + 7) / 8)
+#define GAME_TABLE_READ_RETRIES 64
+#define GAME_TABLE_RENDER_ROW_SIZE 224
+
+typedef struct {
+    int game_id;
+    pid_t pid;
+    Player current_player;
+    int move_count;
+    int black_count;
+    int white_count;
+    int board_size;
+    uint64_t started_ns;
+    uint64_t heartbeat_ns;
+    uint32_t rtt_us[2];
+    char board[GAME_TABLE_CELLS + 1];
+} GameSnapshot;
+
+int initialize_game_table(int slot_count);
+int claim_game_slot(int game_id);
+void assign_game_slot_process(int slot, pid_t pid);
+void release_game_slot(int slot);
+void release_process_slots(pid_t pid);
+void publish_game_state(int slot, const GameState *game, int move_count);
+void touch_game_slot(int slot, uint64_t now_ns);
+void publish_player_rtt(int slot, Player player, uint64_t rtt_ns);
+int read_game_slot(int slot, GameSnapshot *snapshot);
+int count_live_games(void);
+pid_t find_game_process(int game_id);
+size_t game_table_render_size(void);
+size_t render_game_table(char *buffer, size_t buffer_size, uint64_t now_ns);
+
+#endif
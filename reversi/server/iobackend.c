@@ -0,0 +1,439 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include "iobackend.h"
+#include "log.h"
+#include "slab.h"
+
+#define EPOLL_DRAIN_ATTEMPTS 10
+#define EPOLL_DRAIN_TIMEOUT_MS 100
+
+enum {
+    EPOLL_WATCH_ACCEPT,
+    EPOLL_WATCH_READABLE,
+    EPOLL_WATCH_CONNECTION
+};
+
+typedef struct {
+    uint32_t token;
+    int failed;
+    int error_pending;
+    int close_when_idle;
+    char *queue;
+    size_t queue_start;
+    size_t queue_length;
+} EpollConnection;
+
+typedef struct {
+    IoBackend base;
+    struct epoll_event ready[IO_BACKEND_EVENT_BATCH];
+    char buffers[IO_BACKEND_EVENT_BATCH][MAX_MESSAGE_LENGTH];
+    EpollConnection connections[IO_BACKEND_MAX_FDS];
+    int failed_fds[IO_BACKEND_MAX_FDS];
+    int failed_count;
+    int lingering;
+    Slab send_queues;
+} EpollBackend;
+
+static IoBackendKind configured_kind = IO_BACKEND_EPOLL;
+
+void configure_io_backend(IoBackendKind kind) {
+    configured_kind = kind;
+}
+
+int parse_io_backend(const char *text, IoBackendKind *kind) {
+    if (strcmp(text, "epoll") == 0) {
+        *kind = IO_BACKEND_EPOLL;
+        return 0;
+    }
+    if (strcmp(text, "io_uring") == 0 || strcmp(text, "uring") == 0) {
+        *kind = IO_BACKEND_URING;
+        return 0;
+    }
+    return -1;
+}
+
+const char *io_backend_name(IoBackendKind kind) {
+    return (kind == IO_BACKEND_URING) ? "io_uring" : "epoll";
+}
+
+IoBackend *create_io_backend(void) {
+    if (configured_kind == IO_BACKEND_URING) {
+        IoBackend *backend = create_uring_backend();
+        if (backend != NULL) {
+            return backend;
+        }
+        LOG_WARN("io_uring_unavailable", LOG_TEXT("fallback", "epoll"), LOG_INT("errno", errno));
+        configured_kind = IO_BACKEND_EPOLL;
+    }
+    return create_epoll_backend();
+}
+
+void destroy_io_backend(IoBackend *backend) {
+    if (backend != NULL) {
+        backend->ops->destroy(backend);
+    }
+}
+
+int io_backend_fd(const IoBackend *backend) {
+    return backend->fd;
+}
+
+int io_backend_watch_accept(IoBackend *backend, int listen_fd, uint32_t token) {
+    return backend->ops->watch_accept(backend, listen_fd, token);
+}
+
+int io_backend_watch_readable(IoBackend *backend, int fd, uint32_t token) {
+    return backend->ops->watch_readable(backend, fd, token);
+}
+
+int io_backend_add_connection(IoBackend *backend, int fd, uint32_t token) {
+    return backend->ops->add_connection(backend, fd, token);
+}
+
+void io_backend_remove(IoBackend *backend, int fd) {
+    backend->ops->remove(backend, fd);
+}
+
+void io_backend_close(IoBackend *backend, int fd) {
+    backend->ops->close(backend, fd);
+}
+
+ssize_t io_backend_send(IoBackend *backend, int fd, const char *data, size_t length) {
+    return backend->ops->send(backend, fd, data, length);
+}
+
+int io_backend_wait(IoBackend *backend, IoEvent *events, int max_events, int timeout_ms) {
+    return backend->ops->wait(backend, events, max_events, timeout_ms);
+}
+
+static uint64_t epoll_data(int watch, int fd, uint32_t token) {
+    return ((uint64_t)watch << 62) | ((uint64_t)(uint32_t)fd << 32) | token;
+}
+
+static int epoll_watch(IoBackend *backend, int watch, int fd, uint32_t token) {
+    struct epoll_event event = { .events = EPOLLIN, .data.u64 = epoll_data(watch, fd, token) };
+    return epoll_ctl(backend->fd, EPOLL_CTL_ADD, fd, &event);
+}
+
+static int epoll_watch_accept(IoBackend *backend, int listen_fd, uint32_t token) {
+    return epoll_watch(backend, EPOLL_WATCH_ACCEPT, listen_fd, token);
+}
+
+static int epoll_watch_readable(IoBackend *backend, int fd, uint32_t token) {
+    return epoll_watch(backend, EPOLL_WATCH_READABLE, fd, token);
+}
+
+static int epoll_add_connection(IoBackend *backend, int fd, uint32_t token) {
+    EpollBackend *epoll = (EpollBackend *)backend;
+    if (fd < 0 || fd >= IO_BACKEND_MAX_FDS) {
+        errno = EMFILE;
+        return -1;
+    }
+
+    EpollConnection *connection = &epoll->connections[fd];
+    connection->token = token;
+    uint32_t events = (connection->queue_length > 0) ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+    struct epoll_event event = { .events = events, .data.u64 = epoll_data(EPOLL_WATCH_CONNECTION, fd, token) };
+    return epoll_ctl(backend->fd, EPOLL_CTL_ADD, fd, &event);
+}
+
+static void set_connection_interest(EpollBackend *epoll, int fd, uint32_t events) {
+    EpollConnection *connection = &epoll->connections[fd];
+    struct epoll_event event = { .events = events,
+                                 .data.u64 = epoll_data(EPOLL_WATCH_CONNECTION, fd, connection->token) };
+    if (epoll_ctl(epoll->base.fd, EPOLL_CTL_MOD, fd, &event) < 0 && errno == ENOENT &&
+        connection->close_when_idle) {
+        epoll_ctl(epoll->base.fd, EPOLL_CTL_ADD, fd, &event);
+    }
+}
+
+static void release_send_queue(EpollBackend *epoll, EpollConnection *connection) {
+    slab_free(&epoll->send_queues, connection->queue);
+    connection->queue = NULL;
+    connection->queue_start = 0;
+    connection->queue_length = 0;
+}
+
+static void fail_connection(EpollBackend *epoll, int fd, const char *reason) {
+    EpollConnection *connection = &epoll->connections[fd];
+    if (connection->failed) {
+        return;
+    }
+    LOG_WARN("peer_dropped", LOG_INT("fd", fd), LOG_TEXT("reason", reason),
+             LOG_INT("queued", (long long)connection->queue_length));
+    connection->failed = 1;
+    if (connection->queue_length > 0) {
+        set_connection_interest(epoll, fd, EPOLLIN);
+    }
+    release_send_queue(epoll, connection);
+    if (!connection->close_when_idle && !connection->error_pending && epoll->failed_count < IO_BACKEND_MAX_FDS) {
+        connection->error_pending = 1;
+        epoll->failed_fds[epoll->failed_count++] = fd;
+    }
+}
+
+static void finish_close(EpollBackend *epoll, int fd) {
+    EpollConnection *connection = &epoll->connections[fd];
+    if (connection->close_when_idle) {
+        epoll->lingering--;
+    }
+    release_send_queue(epoll, connection);
+    memset(connection, 0, sizeof(*connection));
+    epoll_ctl(epoll->base.fd, EPOLL_CTL_DEL, fd, NULL);
+    close(fd);
+}
+
+static void flush_send_queue(EpollBackend *epoll, int fd) {
+    EpollConnection *connection = &epoll->connections[fd];
+    while (connection->queue_length > 0) {
+        ssize_t sent = send(fd, connection->queue + connection->queue_start, connection->queue_length,
+                            MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return;
+            }
+            if (connection->close_when_idle) {
+                finish_close(epoll, fd);
+            } else {
+                fail_connection(epoll, fd, "send_failed");
+            }
+            return;
+        }
+        connection->queue_start += (size_t)sent;
+        connection->queue_length -= (size_t)sent;
+    }
+
+    release_send_queue(epoll, connection);
+    if (connection->close_when_idle) {
+        finish_close(epoll, fd);
+    } else {
+        set_connection_interest(epoll, fd, EPOLLIN);
+    }
+}
+
+static void epoll_remove(IoBackend *backend, int fd) {
+    epoll_ctl(backend->fd, EPOLL_CTL_DEL, fd, NULL);
+}
+
+static void epoll_close(IoBackend *backend, int fd) {
+    EpollBackend *epoll = (EpollBackend *)backend;
+    if (fd < 0 || fd >= IO_BACKEND_MAX_FDS) {
+        epoll_remove(backend, fd);
+        close(fd);
+        return;
+    }
+
+    EpollConnection *connection = &epoll->connections[fd];
+    connection->error_pending = 0;
+    if (connection->queue_length == 0 || connection->failed) {
+        finish_close(epoll, fd);
+        return;
+    }
+    connection->close_when_idle = 1;
+    epoll->lingering++;
+    set_connection_interest(epoll, fd, EPOLLOUT);
+}
+
+static ssize_t epoll_send(IoBackend *backend, int fd, const char *data, size_t length) {
+    EpollBackend *epoll = (EpollBackend *)backend;
+    if (fd < 0 || fd >= IO_BACKEND_MAX_FDS) {
+        return send(fd, data, length, MSG_NOSIGNAL | MSG_DONTWAIT);
+    }
+
+    EpollConnection *connection = &epoll->connections[fd];
+    if (connection->failed) {
+        errno = EPIPE;
+        return -1;
+    }
+
+    size_t sent = 0;
+    while (connection->queue_length == 0 && sent < length) {
+        ssize_t bytes = send(fd, data + sent, length - sent, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (bytes < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            int saved_errno = errno;
+            fail_connection(epoll, fd, "send_failed");
+            errno = saved_errno;
+            return -1;
+        }
+        sent += (size_t)bytes;
+    }
+    if (sent == length) {
+        return (ssize_t)length;
+    }
+
+    size_t remaining = length - sent;
+    if (connection->queue == NULL && (connection->queue = slab_alloc(&epoll->send_queues)) == NULL) {
+        fail_connection(epoll, fd, "send_queue_unavailable");
+        errno = ENOBUFS;
+        return -1;
+    }
+    if (connection->queue_length + remaining > IO_BACKEND_SEND_QUEUE_SIZE) {
+        fail_connection(epoll, fd, "send_queue_full");
+        errno = ENOBUFS;
+        return -1;
+    }
+    if (connection->queue_start + connection->queue_length + remaining > IO_BACKEND_SEND_QUEUE_SIZE) {
+        memmove(connection->queue, connection->queue + connection->queue_start, connection->queue_length);
+        connection->queue_start = 0;
+    }
+
+    int was_empty = connection->queue_length == 0;
+    memcpy(connection->queue + connection->queue_start + connection->queue_length, data + sent, remaining);
+    connection->queue_length += remaining;
+    if (was_empty) {
+        set_connection_interest(epoll, fd, EPOLLIN | EPOLLOUT);
+    }
+    return (ssize_t)length;
+}
+
+static int take_failed_connections(EpollBackend *epoll, IoEvent *events, int max_events) {
+    int count = 0;
+    int kept = 0;
+    for (int i = 0; i < epoll->failed_count; i++) {
+        int fd = epoll->failed_fds[i];
+        EpollConnection *connection = &epoll->connections[fd];
+        if (!connection->error_pending) {
+            continue;
+        }
+        if (count == max_events) {
+            epoll->failed_fds[kept++] = fd;
+            continue;
+        }
+        connection->error_pending = 0;
+        events[count++] = (IoEvent){ .type = IO_EVENT_DATA, .token = connection->token, .fd = fd, .length = -1 };
+    }
+    epoll->failed_count = kept;
+    return count;
+}
+
+static int epoll_accept_ready(int listen_fd, uint32_t token, IoEvent *events, int max_events) {
+    int count = 0;
+    while (count < max_events) {
+        int client_fd = accept4(listen_fd, NULL, NULL, SOCK_CLOEXEC);
+        if (client_fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                LOG_WARN("accept_failed", LOG_INT("errno", errno));
+            }
+            break;
+        }
+        events[count++] = (IoEvent){ .type = IO_EVENT_ACCEPT, .token = token, .fd = client_fd };
+    }
+    return count;
+}
+
+static int epoll_wait_events(IoBackend *backend, IoEvent *events, int max_events, int timeout_ms) {
+    EpollBackend *epoll = (EpollBackend *)backend;
+    if (max_events > IO_BACKEND_EVENT_BATCH) {
+        max_events = IO_BACKEND_EVENT_BATCH;
+    }
+
+    int count = take_failed_connections(epoll, events, max_events);
+    if (count == max_events) {
+        return count;
+    }
+    int ready = epoll_wait(backend->fd, epoll->ready, max_events - count, count > 0 ? 0 : timeout_ms);
+    if (ready < 0) {
+        return (errno == EINTR) ? count : -1;
+    }
+
+    for (int i = 0; i < ready && count < max_events; i++) {
+        uint64_t watch = epoll->ready[i].data.u64;
+        int fd = (int)((watch >> 32) & 0x3fffffff);
+        uint32_t token = (uint32_t)watch;
+
+        switch ((int)(watch >> 62)) {
+            case EPOLL_WATCH_ACCEPT:
+                count += epoll_accept_ready(fd, token, events + count, max_events - count);
+                break;
+            case EPOLL_WATCH_READABLE:
+                events[count++] = (IoEvent){ .type = IO_EVENT_READABLE, .token = token, .fd = fd };
+                break;
+            default: {
+                int lingering = epoll->connections[fd].close_when_idle;
+                if ((epoll->ready[i].events & (EPOLLOUT | EPOLLERR | EPOLLHUP)) &&
+                    epoll->connections[fd].queue_length > 0) {
+                    flush_send_queue(epoll, fd);
+                }
+                if (lingering || !(epoll->ready[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))) {
+                    break;
+                }
+                char *buffer = epoll->buffers[count];
+                ssize_t length = recv(fd, buffer, MAX_MESSAGE_LENGTH - 1, MSG_DONTWAIT);
+                if (length < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+                    break;
+                }
+                events[count++] = (IoEvent){ .type = IO_EVENT_DATA, .token = token, .fd = fd,
+                                             .data = buffer, .length = length };
+                break;
+            }
+        }
+    }
+    return count + take_failed_connections(epoll, events + count, max_events - count);
+}
+
+static void epoll_destroy(IoBackend *backend) {
+    EpollBackend *epoll = (EpollBackend *)backend;
+    IoEvent events[IO_BACKEND_EVENT_BATCH];
+
+    for (int attempt = 0; attempt < EPOLL_DRAIN_ATTEMPTS && epoll->lingering > 0; attempt++) {
+        epoll_wait_events(backend, events, IO_BACKEND_EVENT_BATCH, EPOLL_DRAIN_TIMEOUT_MS);
+    }
+    for (int fd = 0; fd < IO_BACKEND_MAX_FDS; fd++) {
+        if (epoll->connections[fd].close_when_idle) {
+            close(fd);
+        }
+    }
+    slab_destroy(&epoll->send_queues);
+    close(backend->fd);
+    free(backend);
+}
+
+static const IoBackendOps epoll_ops = {
+    .watch_accept = epoll_watch_accept,
+    .watch_readable = epoll_watch_readable,
+    .add_connection = epoll_add_connection,
+    .remove = epoll_remove,
+    .close = epoll_close,
+    .send = epoll_send,
+    .wait = epoll_wait_events,
+    .destroy = epoll_destroy
+};
+
+IoBackend *create_epoll_backend(void) {
+    EpollBackend *epoll = calloc(1, sizeof(*epoll));
+    if (epoll == NULL) {
+        return NULL;
+    }
+
+    epoll->base.fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll->base.fd < 0) {
+        LOG_ERROR("epoll_create_failed", LOG_INT("errno", errno));
+        free(epoll);
+        return NULL;
+    }
+    if (slab_init(&epoll->send_queues, IO_BACKEND_SEND_QUEUE_SIZE, IO_BACKEND_MAX_FDS) < 0) {
+        close(epoll->base.fd);
+        free(epoll);
+        return NULL;
+    }
+    epoll->base.ops = &epoll_ops;
+    epoll->base.kind = IO_BACKEND_EPOLL;
+    return &epoll->base;
+}
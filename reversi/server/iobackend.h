@@ -0,0 +1,72 @@
+#ifndef IOBACKEND_H
+#define IOBACKEND_H
+
+#include <stdint.h>
+#include <sys/types.h>
+#include "../common/protocol.h"
+
+#define IO_BACKEND_EVENT_BATCH 64
+#define IO_BACKEND_MAX_FDS 4096
+#define IO_BACKEND_SEND_QUEUE_MESSAGES 32
+#define IO_BACKEND_SEND_QUEUE_SIZE (IO_BACKEND_SEND_QUEUE_MESSAGES * MAX_MESSAGE_LENGTH)
+#define IO_URING_QUEUE_DEPTH 256
+#define IO_URING_RECV_BUFFERS 256
+#define IO_URING_RECV_BUFFER_SIZE (MAX_MESSAGE_LENGTH - 1)
+#define IO_URING_BUFFER_GROUP 1
+
+typedef enum {
+    IO_BACKEND_EPOLL,
+    IO_BACKEND_URING
+} IoBackendKind;
+
+typedef enum {
+    IO_EVENT_ACCEPT,
+    IO_EVENT_READABLE,
+    IO_EVENT_DATA
+} IoEventType;
+
+typedef struct {
+    IoEventType type;
+    uint32_t token;
+    int fd;
+    const char *data;
+    ssize_t length;
+} IoEvent;
+
+typedef struct IoBackend IoBackend;
+
+typedef struct {
+    int (*watch_accept)(IoBackend *backend, int listen_fd, uint32_t token);
+    int (*watch_readable)(IoBackend *backend, int fd, uint32_t token);
+    int (*add_connection)(IoBackend *backend, int fd, uint32_t token);
+    void (*remove)(IoBackend *backend, int fd);
+    void (*close)(IoBackend *backend, int fd);
+    ssize_t (*send)(IoBackend *backend, int fd, const char *data, size_t length);
+    int (*wait)(IoBackend *backend, IoEvent *events, int max_events, int timeout_ms);
+    void (*destroy)(IoBackend *backend);
+} IoBackendOps;
+
+struct IoBackend {
+    const IoBackendOps *ops;
+    IoBackendKind kind;
+    int fd;
+};
+
+void configure_io_backend(IoBackendKind kind);
+int parse_io_backend(const char *text, IoBackendKind *kind);
+const char *io_backend_name(IoBackendKind kind);
+IoBackend *create_io_backend(void);
+IoBackend *create_epoll_backend(void);
+IoBackend *create_uring_backend(void);
+void destroy_io_backend(IoBackend *backend);
+
+int io_backend_fd(const IoBackend *backend);
+int io_backend_watch_accept(IoBackend *backend, int listen_fd, uint32_t token);
+int io_backend_watch_readable(IoBackend *backend, int fd, uint32_t token);
+int io_backend_add_connection(IoBackend *backend, int fd, uint32_t token);
+void io_backend_remove(IoBackend *backend, int fd);
+void io_backend_close(IoBackend *backend, int fd);
+ssize_t io_backend_send(IoBackend *backend, int fd, const char *data, size_t length);
+int io_backend_wait(IoBackend *backend, IoEvent *events, int max_events, int timeout_ms);
+
+#endif
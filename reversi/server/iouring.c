@@ -0,0 +1,734 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/utsname.h>
+#include <linux/io_uring.h>
+#include "iobackend.h"
+#include "log.h"
+#include "slab.h"
+
+#define URING_OP_SHIFT 60
+#define URING_GENERATION_MASK 0x0fffffffU
+#define URING_MIN_KERNEL 600
+#define URING_DRAIN_ATTEMPTS 10
+#define URING_DRAIN_TIMEOUT_MS 100
+#define URING_SEND_SLOTS (IO_BACKEND_MAX_FDS * IO_BACKEND_SEND_QUEUE_MESSAGES)
+
+enum {
+    URING_OP_NONE,
+    URING_OP_ACCEPT,
+    URING_OP_POLL,
+    URING_OP_RECV,
+    URING_OP_SEND,
+    URING_OP_CANCEL
+};
+
+typedef struct SendSlot {
+    struct SendSlot *next;
+    uint32_t index;
+    int fd;
+    size_t length;
+    char data[MAX_MESSAGE_LENGTH];
+} SendSlot;
+
+typedef struct {
+    uint32_t token;
+    uint32_t generation;
+    int watch;
+    int in_flight;
+    int queued;
+    int dirty;
+    int failed;
+    int error_pending;
+    int close_when_idle;
+    SendSlot *queue_head;
+    SendSlot *queue_tail;
+} UringFile;
+
+typedef struct {
+    IoBackend base;
+
+    void *sq_ring;
+    size_t sq_ring_size;
+    void *cq_ring;
+    size_t cq_ring_size;
+    struct io_uring_sqe *sqes;
+    size_t sqes_size;
+
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned sq_mask;
+    unsigned sq_entries;
+    unsigned sqe_tail;
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned cq_mask;
+    struct io_uring_cqe *cqes;
+
+    struct io_uring_buf_ring *buffer_ring;
+    size_t buffer_ring_size;
+    char *buffer_memory;
+    uint16_t buffer_tail;
+    uint16_t lent_buffers[IO_BACKEND_EVENT_BATCH];
+    int lent_count;
+
+    UringFile files[IO_BACKEND_MAX_FDS];
+    int dirty_fds[IO_BACKEND_MAX_FDS];
+    int dirty_count;
+    int failed_fds[IO_BACKEND_MAX_FDS];
+    int failed_count;
+
+    Slab send_slots;
+    int sends_in_flight;
+} UringBackend;
+
+static uint64_t pack_user_data(int op, uint32_t generation, uint32_t value) {
+    return ((uint64_t)op << URING_OP_SHIFT) |
+           ((uint64_t)(generation & URING_GENERATION_MASK) << 32) | value;
+}
+
+static int kernel_supports_multishot(void) {
+    struct utsname name;
+    int major = 0, minor = 0;
+    if (uname(&name) != 0 || sscanf(name.release, "%d.%d", &major, &minor) != 2) {
+        return 0;
+    }
+    return major * 100 + minor >= URING_MIN_KERNEL;
+}
+
+static int enter_ring(UringBackend *ring, unsigned min_complete, int timeout_ms) {
+    unsigned to_submit = ring->sqe_tail - *ring->sq_tail;
+    unsigned flags = 0;
+    struct __kernel_timespec timeout;
+    struct io_uring_getevents_arg arg;
+    void *argp = NULL;
+    size_t argsz = 0;
+
+    __atomic_store_n(ring->sq_tail, ring->sqe_tail, __ATOMIC_RELEASE);
+    if (min_complete > 0) {
+        flags |= IORING_ENTER_GETEVENTS;
+        if (timeout_ms >= 0) {
+            timeout.tv_sec = timeout_ms / 1000;
+            timeout.tv_nsec = (long long)(timeout_ms % 1000) * 1000000LL;
+            memset(&arg, 0, sizeof(arg));
+            arg.ts = (uint64_t)(uintptr_t)&timeout;
+            flags |= IORING_ENTER_EXT_ARG;
+            argp = &arg;
+            argsz = sizeof(arg);
+        }
+    }
+    if (to_submit == 0 && min_complete == 0) {
+        return 0;
+    }
+
+    if (syscall(__NR_io_uring_enter, ring->base.fd, to_submit, min_complete, flags, argp, argsz) < 0 &&
+        errno != EINTR && errno != ETIME && errno != EBUSY) {
+        return -1;
+    }
+    return 0;
+}
+
+static unsigned free_sqes(const UringBackend *ring) {
+    return ring->sq_entries - (ring->sqe_tail - __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE));
+}
+
+static struct io_uring_sqe *get_sqe(UringBackend *ring) {
+    if (free_sqes(ring) == 0 && (enter_ring(ring, 0, 0) < 0 || free_sqes(ring) == 0)) {
+        return NULL;
+    }
+    struct io_uring_sqe *sqe = &ring->sqes[ring->sqe_tail & ring->sq_mask];
+    memset(sqe, 0, sizeof(*sqe));
+    ring->sqe_tail++;
+    return sqe;
+}
+
+static void provide_buffer(UringBackend *ring, uint16_t bid) {
+    struct io_uring_buf *buffer = &ring->buffer_ring->bufs[ring->buffer_tail & (IO_URING_RECV_BUFFERS - 1)];
+    buffer->addr = (uint64_t)(uintptr_t)(ring->buffer_memory + (size_t)bid * IO_URING_RECV_BUFFER_SIZE);
+    buffer->len = IO_URING_RECV_BUFFER_SIZE;
+    buffer->bid = bid;
+    ring->buffer_tail++;
+    __atomic_store_n(&ring->buffer_ring->tail, ring->buffer_tail, __ATOMIC_RELEASE);
+}
+
+static int arm_watch(UringBackend *ring, int fd) {
+    UringFile *file = &ring->files[fd];
+    struct io_uring_sqe *sqe = get_sqe(ring);
+    if (sqe == NULL) {
+        errno = EBUSY;
+        return -1;
+    }
+
+    sqe->fd = fd;
+    sqe->user_data = pack_user_data(file->watch, file->generation, (uint32_t)fd);
+    switch (file->watch) {
+        case URING_OP_ACCEPT:
+            sqe->opcode = IORING_OP_ACCEPT;
+            sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+            sqe->accept_flags = SOCK_CLOEXEC;
+            break;
+        case URING_OP_POLL:
+            sqe->opcode = IORING_OP_POLL_ADD;
+            sqe->len = IORING_POLL_ADD_MULTI;
+            sqe->poll32_events = POLLIN;
+            break;
+        default:
+            sqe->opcode = IORING_OP_RECV;
+            sqe->ioprio = IORING_RECV_MULTISHOT;
+            sqe->flags = IOSQE_BUFFER_SELECT;
+            sqe->buf_group = IO_URING_BUFFER_GROUP;
+            break;
+    }
+    return 0;
+}
+
+static int uring_watch(IoBackend *backend, int op, int fd, uint32_t token) {
+    UringBackend *ring = (UringBackend *)backend;
+    if (fd < 0 || fd >= IO_BACKEND_MAX_FDS) {
+        errno = EMFILE;
+        return -1;
+    }
+
+    UringFile *file = &ring->files[fd];
+    file->generation++;
+    file->token = token;
+    file->watch = op;
+    file->close_when_idle = 0;
+    if (arm_watch(ring, fd) < 0) {
+        file->watch = URING_OP_NONE;
+        return -1;
+    }
+    return 0;
+}
+
+static int uring_watch_accept(IoBackend *backend, int listen_fd, uint32_t token) {
+    if (uring_watch(backend, URING_OP_ACCEPT, listen_fd, token) < 0) {
+        return -1;
+    }
+    return enter_ring((UringBackend *)backend, 0, 0);
+}
+
+static int uring_watch_readable(IoBackend *backend, int fd, uint32_t token) {
+    if (uring_watch(backend, URING_OP_POLL, fd, token) < 0) {
+        return -1;
+    }
+    return enter_ring((UringBackend *)backend, 0, 0);
+}
+
+static int uring_add_connection(IoBackend *backend, int fd, uint32_t token) {
+    return uring_watch(backend, URING_OP_RECV, fd, token);
+}
+
+static void cancel_watch(UringBackend *ring, int fd) {
+    UringFile *file = &ring->files[fd];
+    if (file->watch != URING_OP_NONE) {
+        struct io_uring_sqe *sqe = get_sqe(ring);
+        if (sqe != NULL) {
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->fd = -1;
+            sqe->addr = pack_user_data(file->watch, file->generation, (uint32_t)fd);
+            sqe->user_data = pack_user_data(URING_OP_CANCEL, 0, 0);
+        }
+    }
+    file->watch = URING_OP_NONE;
+    file->generation++;
+}
+
+static void uring_remove(IoBackend *backend, int fd) {
+    UringBackend *ring = (UringBackend *)backend;
+    if (fd < 0 || fd >= IO_BACKEND_MAX_FDS) {
+        return;
+    }
+    cancel_watch(ring, fd);
+    enter_ring(ring, 0, 0);
+}
+
+static void close_file(UringBackend *ring, int fd) {
+    UringFile *file = &ring->files[fd];
+    file->close_when_idle = 0;
+    file->failed = 0;
+    file->error_pending = 0;
+    close(fd);
+}
+
+static void uring_close(IoBackend *backend, int fd) {
+    UringBackend *ring = (UringBackend *)backend;
+    if (fd < 0 || fd >= IO_BACKEND_MAX_FDS) {
+        close(fd);
+        return;
+    }
+
+    UringFile *file = &ring->files[fd];
+    cancel_watch(ring, fd);
+    file->error_pending = 0;
+    if (file->in_flight == 0 && file->queue_head == NULL) {
+        close_file(ring, fd);
+    } else {
+        file->close_when_idle = 1;
+    }
+}
+
+static SendSlot *acquire_slot(UringBackend *ring) {
+    SendSlot *slot = slab_alloc(&ring->send_slots);
+    if (slot != NULL) {
+        slot->next = NULL;
+        slot->index = slab_index(&ring->send_slots, slot);
+    }
+    return slot;
+}
+
+static void mark_dirty(UringBackend *ring, int fd) {
+    UringFile *file = &ring->files[fd];
+    if (!file->dirty) {
+        file->dirty = 1;
+        ring->dirty_fds[ring->dirty_count++] = fd;
+    }
+}
+
+static void fail_file(UringBackend *ring, int fd, const char *reason) {
+    UringFile *file = &ring->files[fd];
+    if (file->failed) {
+        return;
+    }
+    LOG_WARN("peer_dropped", LOG_INT("fd", fd), LOG_TEXT("reason", reason), LOG_INT("queued", file->queued));
+    file->failed = 1;
+    while (file->queue_head != NULL) {
+        SendSlot *slot = file->queue_head;
+        file->queue_head = slot->next;
+        file->queued--;
+        slab_free(&ring->send_slots, slot);
+    }
+    file->queue_tail = NULL;
+    if (!file->close_when_idle && !file->error_pending && ring->failed_count < IO_BACKEND_MAX_FDS) {
+        file->error_pending = 1;
+        ring->failed_fds[ring->failed_count++] = fd;
+    }
+}
+
+static ssize_t uring_send(IoBackend *backend, int fd, const char *data, size_t length) {
+    UringBackend *ring = (UringBackend *)backend;
+    if (fd < 0 || fd >= IO_BACKEND_MAX_FDS || length > MAX_MESSAGE_LENGTH) {
+        return send(fd, data, length, MSG_NOSIGNAL | MSG_DONTWAIT);
+    }
+
+    UringFile *file = &ring->files[fd];
+    if (file->failed) {
+        errno = EPIPE;
+        return -1;
+    }
+    if (file->queue_tail != NULL && file->queue_tail->length + length <= MAX_MESSAGE_LENGTH) {
+        memcpy(file->queue_tail->data + file->queue_tail->length, data, length);
+        file->queue_tail->length += length;
+        return (ssize_t)length;
+    }
+    SendSlot *slot = (file->queued < IO_BACKEND_SEND_QUEUE_MESSAGES) ? acquire_slot(ring) : NULL;
+    if (slot == NULL) {
+        fail_file(ring, fd, file->queued < IO_BACKEND_SEND_QUEUE_MESSAGES ? "send_queue_unavailable"
+                                                                          : "send_queue_full");
+        errno = ENOBUFS;
+        return -1;
+    }
+    memcpy(slot->data, data, length);
+    slot->fd = fd;
+    slot->length = length;
+
+    file->queued++;
+    if (file->queue_tail != NULL) {
+        file->queue_tail->next = slot;
+    } else {
+        file->queue_head = slot;
+    }
+    file->queue_tail = slot;
+    if (file->in_flight == 0) {
+        mark_dirty(ring, fd);
+    }
+    return (ssize_t)length;
+}
+
+static void emit_send_chain(UringBackend *ring, int fd) {
+    UringFile *file = &ring->files[fd];
+    struct io_uring_sqe *previous = NULL;
+    unsigned available = free_sqes(ring);
+
+    while (file->queue_head != NULL && available > 0) {
+        SendSlot *slot = file->queue_head;
+        file->queue_head = slot->next;
+        if (file->queue_head == NULL) {
+            file->queue_tail = NULL;
+        }
+        slot->next = NULL;
+
+        struct io_uring_sqe *sqe = get_sqe(ring);
+        available--;
+        if (previous != NULL) {
+            previous->flags |= IOSQE_IO_LINK;
+        }
+        sqe->opcode = IORING_OP_SEND;
+        sqe->fd = fd;
+        sqe->addr = (uint64_t)(uintptr_t)slot->data;
+        sqe->len = (uint32_t)slot->length;
+        sqe->msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+        sqe->user_data = pack_user_data(URING_OP_SEND, 0, slot->index);
+        file->in_flight++;
+        ring->sends_in_flight++;
+        previous = sqe;
+    }
+}
+
+static void flush_sends(UringBackend *ring) {
+    int pending = 0;
+    for (int i = 0; i < ring->dirty_count; i++) {
+        int fd = ring->dirty_fds[i];
+        UringFile *file = &ring->files[fd];
+
+        if (file->in_flight == 0) {
+            if (free_sqes(ring) == 0) {
+                enter_ring(ring, 0, 0);
+            }
+            emit_send_chain(ring, fd);
+        }
+        if (file->in_flight == 0 && file->queue_head != NULL) {
+            ring->dirty_fds[pending++] = fd;
+        } else {
+            file->dirty = 0;
+        }
+    }
+    ring->dirty_count = pending;
+}
+
+static void complete_send(UringBackend *ring, const struct io_uring_cqe *cqe, uint32_t index) {
+    SendSlot *slot = slab_object(&ring->send_slots, index);
+    if (slot == NULL) {
+        return;
+    }
+
+    UringFile *file = &ring->files[slot->fd];
+    if (cqe->res < 0 || (size_t)cqe->res < slot->length) {
+        fail_file(ring, slot->fd, cqe->res == -ECANCELED ? "send_cancelled" : "send_failed");
+    }
+    file->in_flight--;
+    file->queued--;
+    ring->sends_in_flight--;
+    if (file->in_flight == 0) {
+        if (file->queue_head != NULL) {
+            mark_dirty(ring, slot->fd);
+        } else if (file->close_when_idle) {
+            close_file(ring, slot->fd);
+        }
+    }
+    slab_free(&ring->send_slots, slot);
+}
+
+static int reap_completion(UringBackend *ring, const struct io_uring_cqe *cqe, IoEvent *event) {
+    int op = (int)(cqe->user_data >> URING_OP_SHIFT);
+    uint32_t generation = (uint32_t)(cqe->user_data >> 32) & URING_GENERATION_MASK;
+    uint32_t value = (uint32_t)cqe->user_data;
+    int has_buffer = (cqe->flags & IORING_CQE_F_BUFFER) != 0;
+    uint16_t bid = (uint16_t)(cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+
+    if (op == URING_OP_SEND) {
+        complete_send(ring, cqe, value);
+        return 0;
+    }
+    if (op == URING_OP_CANCEL || value >= IO_BACKEND_MAX_FDS) {
+        return 0;
+    }
+
+    int fd = (int)value;
+    UringFile *file = &ring->files[fd];
+    int live = file->watch == op && (file->generation & URING_GENERATION_MASK) == generation;
+    int rearm = live && !(cqe->flags & IORING_CQE_F_MORE);
+
+    switch (op) {
+        case URING_OP_ACCEPT:
+            if (rearm) {
+                arm_watch(ring, fd);
+            }
+            if (cqe->res < 0) {
+                return 0;
+            }
+            *event = (IoEvent){ .type = IO_EVENT_ACCEPT, .token = file->token, .fd = cqe->res };
+            return 1;
+        case URING_OP_POLL:
+            if (rearm) {
+                arm_watch(ring, fd);
+            }
+            if (!live || cqe->res < 0) {
+                return 0;
+            }
+            *event = (IoEvent){ .type = IO_EVENT_READABLE, .token = file->token, .fd = fd };
+            return 1;
+        case URING_OP_RECV:
+            if (!live) {
+                if (has_buffer) {
+                    provide_buffer(ring, bid);
+                }
+                return 0;
+            }
+            if (cqe->res == -ENOBUFS || (cqe->res > 0 && rearm)) {
+                arm_watch(ring, fd);
+            }
+            if (cqe->res > 0 && has_buffer) {
+                ring->lent_buffers[ring->lent_count++] = bid;
+                *event = (IoEvent){ .type = IO_EVENT_DATA, .token = file->token, .fd = fd,
+                                    .data = ring->buffer_memory + (size_t)bid * IO_URING_RECV_BUFFER_SIZE,
+                                    .length = cqe->res };
+                return 1;
+            }
+            if (has_buffer) {
+                provide_buffer(ring, bid);
+            }
+            if (cqe->res == -ENOBUFS) {
+                return 0;
+            }
+            file->watch = URING_OP_NONE;
+            *event = (IoEvent){ .type = IO_EVENT_DATA, .token = file->token, .fd = fd,
+                                .length = cqe->res < 0 ? -1 : 0 };
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static int reap_completions(UringBackend *ring, IoEvent *events, int max_events) {
+    unsigned head = *ring->cq_head;
+    unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+    int count = 0;
+
+    while (head != tail && count < max_events) {
+        const struct io_uring_cqe *cqe = &ring->cqes[head & ring->cq_mask];
+        count += reap_completion(ring, cqe, &events[count]);
+        head++;
+    }
+    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+    return count;
+}
+
+static int take_failed_files(UringBackend *ring, IoEvent *events, int max_events) {
+    int count = 0;
+    int kept = 0;
+    for (int i = 0; i < ring->failed_count; i++) {
+        int fd = ring->failed_fds[i];
+        UringFile *file = &ring->files[fd];
+        if (!file->error_pending) {
+            continue;
+        }
+        if (count == max_events) {
+            ring->failed_fds[kept++] = fd;
+            continue;
+        }
+        file->error_pending = 0;
+        events[count++] = (IoEvent){ .type = IO_EVENT_DATA, .token = file->token, .fd = fd, .length = -1 };
+    }
+    ring->failed_count = kept;
+    return count;
+}
+
+static int uring_wait(IoBackend *backend, IoEvent *events, int max_events, int timeout_ms) {
+    UringBackend *ring = (UringBackend *)backend;
+    if (max_events > IO_BACKEND_EVENT_BATCH) {
+        max_events = IO_BACKEND_EVENT_BATCH;
+    }
+
+    for (int i = 0; i < ring->lent_count; i++) {
+        provide_buffer(ring, ring->lent_buffers[i]);
+    }
+    ring->lent_count = 0;
+
+    int count = take_failed_files(ring, events, max_events);
+    if (count > 0) {
+        timeout_ms = 0;
+    }
+    for (;;) {
+        flush_sends(ring);
+        int ready = *ring->cq_head != __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+        if (enter_ring(ring, (ready || timeout_ms == 0) ? 0 : 1, timeout_ms) < 0) {
+            return (count > 0) ? count : -1;
+        }
+
+        count += reap_completions(ring, events + count, max_events - count);
+        count += take_failed_files(ring, events + count, max_events - count);
+        if (count > 0 || timeout_ms >= 0) {
+            enter_ring(ring, 0, 0);
+            return count;
+        }
+    }
+}
+
+static void uring_destroy(IoBackend *backend) {
+    UringBackend *ring = (UringBackend *)backend;
+    IoEvent events[IO_BACKEND_EVENT_BATCH];
+
+    for (int attempt = 0; attempt < URING_DRAIN_ATTEMPTS; attempt++) {
+        flush_sends(ring);
+        if (ring->sends_in_flight == 0 && ring->dirty_count == 0) {
+            break;
+        }
+        enter_ring(ring, 1, URING_DRAIN_TIMEOUT_MS);
+        reap_completions(ring, events, IO_BACKEND_EVENT_BATCH);
+        for (int i = 0; i < ring->lent_count; i++) {
+            provide_buffer(ring, ring->lent_buffers[i]);
+        }
+        ring->lent_count = 0;
+    }
+    for (int fd = 0; fd < IO_BACKEND_MAX_FDS; fd++) {
+        if (ring->files[fd].close_when_idle) {
+            close(fd);
+        }
+    }
+
+    close(backend->fd);
+    munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_ring != ring->sq_ring) {
+        munmap(ring->cq_ring, ring->cq_ring_size);
+    }
+    munmap(ring->sq_ring, ring->sq_ring_size);
+    if (ring->buffer_ring != NULL) {
+        munmap(ring->buffer_ring, ring->buffer_ring_size);
+    }
+    free(ring->buffer_memory);
+    slab_destroy(&ring->send_slots);
+    free(ring);
+}
+
+static const IoBackendOps uring_ops = {
+    .watch_accept = uring_watch_accept,
+    .watch_readable = uring_watch_readable,
+    .add_connection = uring_add_connection,
+    .remove = uring_remove,
+    .close = uring_close,
+    .send = uring_send,
+    .wait = uring_wait,
+    .destroy = uring_destroy
+};
+
+static int map_rings(UringBackend *ring, const struct io_uring_params *params) {
+    ring->sq_ring_size = params->sq_off.array + params->sq_entries * sizeof(unsigned);
+    ring->cq_ring_size = params->cq_off.cqes + params->cq_entries * sizeof(struct io_uring_cqe);
+    if (params->features & IORING_FEAT_SINGLE_MMAP) {
+        if (ring->cq_ring_size > ring->sq_ring_size) {
+            ring->sq_ring_size = ring->cq_ring_size;
+        }
+        ring->cq_ring_size = ring->sq_ring_size;
+    }
+
+    ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ring->base.fd, IORING_OFF_SQ_RING);
+    if (ring->sq_ring == MAP_FAILED) {
+        return -1;
+    }
+    ring->cq_ring = ring->sq_ring;
+    if (!(params->features & IORING_FEAT_SINGLE_MMAP)) {
+        ring->cq_ring = mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             ring->base.fd, IORING_OFF_CQ_RING);
+        if (ring->cq_ring == MAP_FAILED) {
+            munmap(ring->sq_ring, ring->sq_ring_size);
+            return -1;
+        }
+    }
+    ring->sqes_size = params->sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ring->base.fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        if (ring->cq_ring != ring->sq_ring) {
+            munmap(ring->cq_ring, ring->cq_ring_size);
+        }
+        munmap(ring->sq_ring, ring->sq_ring_size);
+        return -1;
+    }
+
+    char *sq = ring->sq_ring;
+    char *cq = ring->cq_ring;
+    ring->sq_head = (unsigned *)(sq + params->sq_off.head);
+    ring->sq_tail = (unsigned *)(sq + params->sq_off.tail);
+    ring->sq_mask = *(unsigned *)(sq + params->sq_off.ring_mask);
+    ring->sq_entries = params->sq_entries;
+    ring->sqe_tail = *ring->sq_tail;
+    ring->cq_head = (unsigned *)(cq + params->cq_off.head);
+    ring->cq_tail = (unsigned *)(cq + params->cq_off.tail);
+    ring->cq_mask = *(unsigned *)(cq + params->cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)(cq + params->cq_off.cqes);
+
+    unsigned *array = (unsigned *)(sq + params->sq_off.array);
+    for (unsigned i = 0; i < params->sq_entries; i++) {
+        array[i] = i;
+    }
+    return 0;
+}
+
+static int register_buffer_ring(UringBackend *ring) {
+    ring->buffer_ring_size = IO_URING_RECV_BUFFERS * sizeof(struct io_uring_buf);
+    ring->buffer_ring = mmap(NULL, ring->buffer_ring_size, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ring->buffer_ring == MAP_FAILED) {
+        ring->buffer_ring = NULL;
+        return -1;
+    }
+    ring->buffer_memory = malloc((size_t)IO_URING_RECV_BUFFERS * IO_URING_RECV_BUFFER_SIZE);
+    if (ring->buffer_memory == NULL) {
+        return -1;
+    }
+
+    struct io_uring_buf_reg registration;
+    memset(&registration, 0, sizeof(registration));
+    registration.ring_addr = (uint64_t)(uintptr_t)ring->buffer_ring;
+    registration.ring_entries = IO_URING_RECV_BUFFERS;
+    registration.bgid = IO_URING_BUFFER_GROUP;
+    if (syscall(__NR_io_uring_register, ring->base.fd, IORING_REGISTER_PBUF_RING, &registration, 1) < 0) {
+        return -1;
+    }
+
+    for (uint16_t bid = 0; bid < IO_URING_RECV_BUFFERS; bid++) {
+        provide_buffer(ring, bid);
+    }
+    return 0;
+}
+
+IoBackend *create_uring_backend(void) {
+    if (!kernel_supports_multishot()) {
+        errno = ENOSYS;
+        return NULL;
+    }
+
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = (int)syscall(__NR_io_uring_setup, IO_URING_QUEUE_DEPTH, &params);
+    if (fd < 0) {
+        return NULL;
+    }
+    if (!(params.features & IORING_FEAT_EXT_ARG) || !(params.features & IORING_FEAT_NODROP)) {
+        close(fd);
+        errno = ENOSYS;
+        return NULL;
+    }
+
+    UringBackend *ring = calloc(1, sizeof(*ring));
+    if (ring == NULL) {
+        close(fd);
+        return NULL;
+    }
+    ring->base.ops = &uring_ops;
+    ring->base.kind = IO_BACKEND_URING;
+    ring->base.fd = fd;
+
+    if (map_rings(ring, &params) < 0) {
+        int saved_errno = errno;
+        close(fd);
+        free(ring);
+        errno = saved_errno;
+        return NULL;
+    }
+    if (slab_init(&ring->send_slots, sizeof(SendSlot), URING_SEND_SLOTS) < 0 || register_buffer_ring(ring) < 0) {
+        int saved_errno = errno;
+        uring_destroy(&ring->base);
+        errno = saved_errno;
+        return NULL;
+    }
+    return &ring->base;
+}
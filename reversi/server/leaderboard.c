@@ -0,0 +1,458 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <limits.h>
+#include "leaderboard.h"
+#include "log.h"
+
+typedef struct LeaderboardNode LeaderboardNode;
+
+typedef struct {
+    LeaderboardNode *next;
+    int span;
+} SkipLink;
+
+struct LeaderboardNode {
+    char name[PLAYER_NAME_LENGTH];
+    double rating;
+    int wins;
+    int losses;
+    int draws;
+    LeaderboardNode *hash_next;
+    int level;
+    SkipLink links[];
+};
+
+static LeaderboardNode *head = NULL;
+static int list_level = 1;
+static int list_length = 0;
+static LeaderboardNode **hash_buckets = NULL;
+static size_t hash_bucket_count = 0;
+static uint64_t level_random_state = 0x2545F4914F6CDD1DULL;
+
+static char snapshot_path[PATH_MAX];
+static uint64_t snapshot_interval_ns = 0;
+static uint64_t next_snapshot_ns = 0;
+static int snapshot_dirty = 0;
+
+static LeaderboardNode *allocate_node(int level) {
+    LeaderboardNode *node = calloc(1, sizeof(LeaderboardNode) + (size_t)level * sizeof(SkipLink));
+    if (node != NULL) {
+        node->level = level;
+    }
+    return node;
+}
+
+static int random_level(void) {
+    int level = 1;
+    while (level < LEADERBOARD_MAX_LEVEL) {
+        level_random_state ^= level_random_state << 13;
+        level_random_state ^= level_random_state >> 7;
+        level_random_state ^= level_random_state << 17;
+        if ((level_random_state & 3) != 0) {
+            break;
+        }
+        level++;
+    }
+    return level;
+}
+
+static uint64_t hash_name(const char *name) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (; *name != '\0'; name++) {
+        hash ^= (uint8_t)*name;
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+static LeaderboardNode *find_node(const char *name) {
+    if (hash_bucket_count == 0) {
+        return NULL;
+    }
+    LeaderboardNode *node = hash_buckets[hash_name(name) & (hash_bucket_count - 1)];
+    while (node != NULL && strcmp(node->name, name) != 0) {
+        node = node->hash_next;
+    }
+    return node;
+}
+
+static int grow_hash_buckets(void) {
+    size_t new_count = hash_bucket_count == 0 ? 256 : hash_bucket_count * 2;
+    LeaderboardNode **new_buckets = calloc(new_count, sizeof(LeaderboardNode *));
+    if (new_buckets == NULL) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < hash_bucket_count; i++) {
+        LeaderboardNode *node = hash_buckets[i];
+        while (node != NULL) {
+            LeaderboardNode *next = node->hash_next;
+            size_t bucket = hash_name(node->name) & (new_count - 1);
+            node->hash_next = new_buckets[bucket];
+            new_buckets[bucket] = node;
+            node = next;
+        }
+    }
+
+    free(hash_buckets);
+    hash_buckets = new_buckets;
+    hash_bucket_count = new_count;
+    return 0;
+}
+
+static int orders_before(const LeaderboardNode *node, const LeaderboardNode *target) {
+    if (node->rating != target->rating) {
+        return node->rating > target->rating;
+    }
+    return strcmp(node->name, target->name) < 0;
+}
+
+static void link_node(LeaderboardNode *node) {
+    LeaderboardNode *update[LEADERBOARD_MAX_LEVEL];
+    int rank[LEADERBOARD_MAX_LEVEL];
+    LeaderboardNode *cursor = head;
+
+    for (int i = list_level - 1; i >= 0; i--) {
+        rank[i] = (i == list_level - 1) ? 0 : rank[i + 1];
+        while (cursor->links[i].next != NULL && orders_before(cursor->links[i].next, node)) {
+            rank[i] += cursor->links[i].span;
+            cursor = cursor->links[i].next;
+        }
+        update[i] = cursor;
+    }
+
+    if (node->level > list_level) {
+        for (int i = list_level; i < node->level; i++) {
+            rank[i] = 0;
+            update[i] = head;
+            head->links[i].span = list_length;
+        }
+        list_level = node->level;
+    }
+
+    for (int i = 0; i < node->level; i++) {
+        node->links[i].next = update[i]->links[i].next;
+        update[i]->links[i].next = node;
+        node->links[i].span = update[i]->links[i].span - (rank[0] - rank[i]);
+        update[i]->links[i].span = (rank[0] - rank[i]) + 1;
+    }
+    for (int i = node->level; i < list_level; i++) {
+        update[i]->links[i].span++;
+    }
+    list_length++;
+}
+
+static void unlink_node(LeaderboardNode *node) {
+    LeaderboardNode *update[LEADERBOARD_MAX_LEVEL];
+    LeaderboardNode *cursor = head;
+
+    for (int i = list_level - 1; i >= 0; i--) {
+        while (cursor->links[i].next != NULL && orders_before(cursor->links[i].next, node)) {
+            cursor = cursor->links[i].next;
+        }
+        update[i] = cursor;
+    }
+
+    for (int i = 0; i < list_level; i++) {
+        if (update[i]->links[i].next == node) {
+            update[i]->links[i].span += node->links[i].span - 1;
+            update[i]->links[i].next = node->links[i].next;
+        } else {
+            update[i]->links[i].span--;
+        }
+    }
+    while (list_level > 1 && head->links[list_level - 1].next == NULL) {
+        list_level--;
+    }
+    list_length--;
+}
+
+static int rank_of(const LeaderboardNode *node) {
+    const LeaderboardNode *cursor = head;
+    int rank = 0;
+
+    for (int i = list_level - 1; i >= 0; i--) {
+        while (cursor->links[i].next != NULL &&
+               (cursor->links[i].next == node || orders_before(cursor->links[i].next, node))) {
+            rank += cursor->links[i].span;
+            cursor = cursor->links[i].next;
+        }
+        if (cursor == node) {
+            return rank;
+        }
+    }
+    return 0;
+}
+
+static LeaderboardNode *node_at(int rank) {
+    LeaderboardNode *cursor = head;
+    int traversed = 0;
+
+    if (rank < 1 || rank > list_length) {
+        return NULL;
+    }
+    for (int i = list_level - 1; i >= 0; i--) {
+        while (cursor->links[i].next != NULL && traversed + cursor->links[i].span <= rank) {
+            traversed += cursor->links[i].span;
+            cursor = cursor->links[i].next;
+        }
+        if (traversed == rank) {
+            return cursor;
+        }
+    }
+    return NULL;
+}
+
+static LeaderboardNode *create_node(const char *name, double rating) {
+    if ((size_t)list_length >= hash_bucket_count && grow_hash_buckets() < 0) {
+        return NULL;
+    }
+
+    LeaderboardNode *node = allocate_node(random_level());
+    if (node == NULL) {
+        return NULL;
+    }
+    snprintf(node->name, sizeof(node->name), "%s", name);
+    node->rating = rating;
+
+    size_t bucket = hash_name(name) & (hash_bucket_count - 1);
+    node->hash_next = hash_buckets[bucket];
+    hash_buckets[bucket] = node;
+    link_node(node);
+    return node;
+}
+
+static LeaderboardNode *find_or_create_node(const char *name) {
+    LeaderboardNode *node = find_node(name);
+    return node != NULL ? node : create_node(name, LEADERBOARD_INITIAL_RATING);
+}
+
+static void fill_entry(const LeaderboardNode *node, int rank, LeaderboardEntry *entry) {
+    memcpy(entry->name, node->name, sizeof(entry->name));
+    entry->rating = node->rating;
+    entry->rank = rank;
+    entry->wins = node->wins;
+    entry->losses = node->losses;
+    entry->draws = node->draws;
+}
+
+void initialize_leaderboard(void) {
+    if (head == NULL) {
+        head = allocate_node(LEADERBOARD_MAX_LEVEL);
+        if (head == NULL) {
+            perror("leaderboard allocation failed");
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+void reset_leaderboard(void) {
+    if (head != NULL) {
+        LeaderboardNode *node = head->links[0].next;
+        while (node != NULL) {
+            LeaderboardNode *next = node->links[0].next;
+            free(node);
+            node = next;
+        }
+        free(head);
+    }
+    free(hash_buckets);
+    head = NULL;
+    hash_buckets = NULL;
+    hash_bucket_count = 0;
+    list_level = 1;
+    list_length = 0;
+    initialize_leaderboard();
+}
+
+int leaderboard_size(void) {
+    return list_length;
+}
+
+int record_leaderboard_result(const GameResult *result) {
+    double black_score;
+
+    if (head == NULL || !is_valid_player_name(result->black_name) || !is_valid_player_name(result->white_name) ||
+        strcmp(result->black_name, result->white_name) == 0) {
+        return 0;
+    }
+
+    switch (result->outcome) {
+        case GAME_OUTCOME_BLACK_WINS:
+        case GAME_OUTCOME_WHITE_LEFT:
+            black_score = 1.0;
+            break;
+        case GAME_OUTCOME_WHITE_WINS:
+        case GAME_OUTCOME_BLACK_LEFT:
+            black_score = 0.0;
+            break;
+        case GAME_OUTCOME_DRAW:
+            black_score = 0.5;
+            break;
+        default:
+            return 0;
+    }
+
+    LeaderboardNode *black = find_or_create_node(result->black_name);
+    LeaderboardNode *white = find_or_create_node(result->white_name);
+    if (black == NULL || white == NULL) {
+        return 0;
+    }
+
+    unlink_node(black);
+    unlink_node(white);
+
+    double black_expected = 1.0 / (1.0 + pow(10.0, (white->rating - black->rating) / 400.0));
+    black->rating += LEADERBOARD_K_FACTOR * (black_score - black_expected);
+    white->rating += LEADERBOARD_K_FACTOR * (black_expected - black_score);
+
+    if (black_score == 1.0) {
+        black->wins++;
+        white->losses++;
+    } else if (black_score == 0.0) {
+        black->losses++;
+        white->wins++;
+    } else {
+        black->draws++;
+        white->draws++;
+    }
+
+    link_node(black);
+    link_node(white);
+    snapshot_dirty = 1;
+    return 1;
+}
+
+int leaderboard_lookup(const char *name, LeaderboardEntry *entry) {
+    LeaderboardNode *node = find_node(name);
+    if (node == NULL) {
+        return -1;
+    }
+    fill_entry(node, rank_of(node), entry);
+    return 0;
+}
+
+int leaderboard_entry_at(int rank, LeaderboardEntry *entry) {
+    LeaderboardNode *node = (head != NULL) ? node_at(rank) : NULL;
+    if (node == NULL) {
+        return -1;
+    }
+    fill_entry(node, rank, entry);
+    return 0;
+}
+
+size_t render_leaderboard(char *buffer, size_t buffer_size, int top) {
+    size_t offset = 0;
+    int written = snprintf(buffer, buffer_size, "# rank name rating wins losses draws (%d players)\n", list_length);
+    if (written < 0 || (size_t)written >= buffer_size) {
+        return 0;
+    }
+    offset = (size_t)written;
+
+    const LeaderboardNode *node = (head != NULL) ? head->links[0].next : NULL;
+    for (int rank = 1; node != NULL && rank <= top; rank++, node = node->links[0].next) {
+        written = snprintf(buffer + offset, buffer_size - offset, "%d %s %.1f %d %d %d\n",
+                           rank, node->name, node->rating, node->wins, node->losses, node->draws);
+        if (written < 0 || (size_t)written >= buffer_size - offset) {
+            break;
+        }
+        offset += (size_t)written;
+    }
+    return offset;
+}
+
+void configure_leaderboard_snapshots(const char *path, int interval_seconds) {
+    snprintf(snapshot_path, sizeof(snapshot_path), "%s", path != NULL ? path : "");
+    snapshot_interval_ns = (uint64_t)interval_seconds * 1000000000ULL;
+    next_snapshot_ns = 0;
+}
+
+int load_leaderboard_snapshot(void) {
+    if (snapshot_path[0] == '\0') {
+        return 0;
+    }
+
+    FILE *file = fopen(snapshot_path, "r");
+    if (file == NULL) {
+        return errno == ENOENT ? 0 : -1;
+    }
+
+    char name[PLAYER_NAME_LENGTH];
+    double rating;
+    int wins;
+    int losses;
+    int draws;
+    int loaded = 0;
+
+    while (fscanf(file, "%23s %lf %d %d %d", name, &rating, &wins, &losses, &draws) == 5) {
+        if (!is_valid_player_name(name) || find_node(name) != NULL) {
+            continue;
+        }
+        LeaderboardNode *node = create_node(name, rating);
+        if (node == NULL) {
+            break;
+        }
+        node->wins = wins;
+        node->losses = losses;
+        node->draws = draws;
+        loaded++;
+    }
+    fclose(file);
+
+    LOG_INFO("leaderboard_loaded", LOG_TEXT("path", snapshot_path), LOG_INT("players", loaded));
+    return loaded;
+}
+
+int save_leaderboard_snapshot(void) {
+    if (snapshot_path[0] == '\0' || head == NULL) {
+        return 0;
+    }
+
+    char temporary_path[PATH_MAX + 8];
+    snprintf(temporary_path, sizeof(temporary_path), "%s.tmp", snapshot_path);
+
+    FILE *file = fopen(temporary_path, "w");
+    if (file == NULL) {
+        LOG_ERROR("leaderboard_snapshot_failed", LOG_INT("errno", errno));
+        return -1;
+    }
+
+    for (const LeaderboardNode *node = head->links[0].next; node != NULL; node = node->links[0].next) {
+        fprintf(file, "%s %.6f %d %d %d\n", node->name, node->rating, node->wins, node->losses, node->draws);
+    }
+
+    if (fclose(file) != 0 || rename(temporary_path, snapshot_path) < 0) {
+        LOG_ERROR("leaderboard_snapshot_failed", LOG_INT("errno", errno));
+        return -1;
+    }
+
+    snapshot_dirty = 0;
+    LOG_DEBUG("leaderboard_snapshot_saved", LOG_INT("players", list_length));
+    return 0;
+}
+
+int leaderboard_snapshot_timeout_ms(uint64_t now_ns) {
+    if (snapshot_path[0] == '\0' || snapshot_interval_ns == 0) {
+        return -1;
+    }
+    if (next_snapshot_ns == 0) {
+        next_snapshot_ns = now_ns + snapshot_interval_ns;
+    }
+    if (now_ns >= next_snapshot_ns) {
+        return 0;
+    }
+    return (int)((next_snapshot_ns - now_ns + 999999ULL) / 1000000ULL);
+}
+
+void maybe_save_leaderboard_snapshot(uint64_t now_ns) {
+    if (leaderboard_snapshot_timeout_ms(now_ns) != 0) {
+        return;
+    }
+    if (snapshot_dirty) {
+        save_leaderboard_snapshot();
+    }
+    next_snapshot_ns = now_ns + snapshot_interval_ns;
+}
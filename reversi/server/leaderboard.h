@@ -0,0 +1,37 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "results.h"
+
+#define LEADERBOARD_MAX_LEVEL 24
+#define LEADERBOARD_INITIAL_RATING 1500.0
+#define LEADERBOARD_K_FACTOR 32.0
+#define LEADERBOARD_DEFAULT_SNAPSHOT_SECONDS 60
+#define LEADERBOARD_DEFAULT_TOP 100
+
+typedef struct {
+    char name[PLAYER_NAME_LENGTH];
+    double rating;
+    int rank;
+    int wins;
+    int losses;
+    int draws;
+} LeaderboardEntry;
+
+void initialize_leaderboard(void);
+void reset_leaderboard(void);
+int leaderboard_size(void);
+int record_leaderboard_result(const GameResult *result);
+int leaderboard_lookup(const char *name, LeaderboardEntry *entry);
+int leaderboard_entry_at(int rank, LeaderboardEntry *entry);
+size_t render_leaderboard(char *buffer, size_t buffer_size, int top);
+
+void configure_leaderboard_snapshots(const char *path, int interval_seconds);
+int load_leaderboard_snapshot(void);
+int save_leaderboard_snapshot(void);
+int leaderboard_snapshot_timeout_ms(uint64_t now_ns);
+void maybe_save_leaderboard_snapshot(uint64_t now_ns);
+
+#endif
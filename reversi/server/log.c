@@ -0,0 +1,291 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include "log.h"
+
+typedef struct {
+    const char *key;
+    LogFieldType type;
+    union {
+        int64_t integer;
+        char text[LOG_TEXT_LENGTH];
+    } value;
+} LogRecordField;
+
+typedef struct {
+    _Atomic uint64_t sequence;
+    uint64_t timestamp_ns;
+    const char *event;
+    int32_t pid;
+    uint8_t level;
+    uint8_t field_count;
+    LogRecordField fields[LOG_MAX_FIELDS];
+} LogSlot;
+
+typedef struct {
+    LogControl control;
+    _Alignas(64) _Atomic uint64_t enqueue_position;
+    _Alignas(64) uint64_t dequeue_position;
+    LogSlot slots[LOG_RING_CAPACITY];
+} LogRing;
+
+static const char *LEVEL_NAMES[] = { "debug", "info", "warn", "error", "off" };
+
+LogControl *log_control = NULL;
+
+static LogRing *log_ring = NULL;
+static int log_output_fd = -1;
+static pthread_t flusher_thread;
+static pid_t flusher_owner_pid = -1;
+static pid_t cached_pid = -1;
+static _Atomic int flusher_running = 0;
+static char flush_buffer[LOG_FLUSH_BUFFER_SIZE];
+
+const char *log_level_name(LogLevel level) {
+    if (level < LOG_LEVEL_DEBUG || level > LOG_LEVEL_OFF) {
+        return "unknown";
+    }
+    return LEVEL_NAMES[level];
+}
+
+int parse_log_level(const char *text, LogLevel *level) {
+    for (int i = LOG_LEVEL_DEBUG; i <= LOG_LEVEL_OFF; i++) {
+        if (strcasecmp(text, LEVEL_NAMES[i]) == 0) {
+            *level = (LogLevel)i;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+void log_set_level(LogLevel level) {
+    if (log_control != NULL) {
+        atomic_store_explicit(&log_control->level, (int)level, memory_order_relaxed);
+    }
+}
+
+LogLevel log_get_level(void) {
+    if (log_control == NULL) {
+        return LOG_LEVEL_OFF;
+    }
+    return (LogLevel)atomic_load_explicit(&log_control->level, memory_order_relaxed);
+}
+
+void log_write(LogLevel level, const char *event, const LogField *fields, int field_count) {
+    LogRing *ring = log_ring;
+    if (ring == NULL) {
+        return;
+    }
+
+    uint64_t position = atomic_load_explicit(&ring->enqueue_position, memory_order_relaxed);
+    LogSlot *slot;
+
+    while (1) {
+        slot = &ring->slots[position & (LOG_RING_CAPACITY - 1)];
+        uint64_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        int64_t difference = (int64_t)(sequence - position);
+
+        if (difference == 0) {
+            if (atomic_compare_exchange_weak_explicit(&ring->enqueue_position, &position, position + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            atomic_fetch_add_explicit(&ring->control.dropped, 1, memory_order_relaxed);
+            return;
+        } else {
+            position = atomic_load_explicit(&ring->enqueue_position, memory_order_relaxed);
+        }
+    }
+
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    slot->timestamp_ns = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+    slot->event = event;
+    slot->pid = (int32_t)cached_pid;
+    slot->level = (uint8_t)level;
+
+    if (field_count > LOG_MAX_FIELDS) {
+        field_count = LOG_MAX_FIELDS;
+    }
+    slot->field_count = (uint8_t)field_count;
+
+    for (int i = 0; i < field_count; i++) {
+        LogRecordField *record_field = &slot->fields[i];
+        record_field->key = fields[i].key;
+        record_field->type = fields[i].type;
+        if (fields[i].type == LOG_FIELD_INT) {
+            record_field->value.integer = fields[i].value.integer;
+        } else {
+            const char *text = fields[i].value.text != NULL ? fields[i].value.text : "";
+            size_t length = strnlen(text, LOG_TEXT_LENGTH - 1);
+            memcpy(record_field->value.text, text, length);
+            record_field->value.text[length] = '\0';
+        }
+    }
+
+    atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+}
+
+static size_t append_text_value(char *buffer, size_t offset, const char *text) {
+    int needs_quotes = text[0] == '\0' || strpbrk(text, " =\"") != NULL;
+
+    if (needs_quotes) {
+        buffer[offset++] = '"';
+    }
+    for (const char *character = text; *character != '\0'; character++) {
+        buffer[offset++] = (*character == '"') ? '\'' : *character;
+    }
+    if (needs_quotes) {
+        buffer[offset++] = '"';
+    }
+    return offset;
+}
+
+static size_t format_slot(const LogSlot *slot, char *buffer, size_t buffer_size) {
+    time_t seconds = (time_t)(slot->timestamp_ns / 1000000000ULL);
+    long microseconds = (long)((slot->timestamp_ns % 1000000000ULL) / 1000ULL);
+    struct tm calendar_time;
+    gmtime_r(&seconds, &calendar_time);
+
+    int written = snprintf(buffer, buffer_size,
+                           "ts=%04d-%02d-%02dT%02d:%02d:%02d.%06ldZ level=%s pid=%d event=%s",
+                           calendar_time.tm_year + 1900, calendar_time.tm_mon + 1, calendar_time.tm_mday,
+                           calendar_time.tm_hour, calendar_time.tm_min, calendar_time.tm_sec, microseconds,
+                           log_level_name((LogLevel)slot->level), slot->pid, slot->event);
+    size_t offset = (size_t)written;
+
+    for (int i = 0; i < slot->field_count; i++) {
+        const LogRecordField *field = &slot->fields[i];
+        if (field->type == LOG_FIELD_INT) {
+            offset += (size_t)snprintf(buffer + offset, buffer_size - offset, " %s=%lld",
+                                       field->key, (long long)field->value.integer);
+        } else {
+            offset += (size_t)snprintf(buffer + offset, buffer_size - offset, " %s=", field->key);
+            offset = append_text_value(buffer, offset, field->value.text);
+        }
+    }
+
+    buffer[offset++] = '\n';
+    return offset;
+}
+
+static void write_all(int fd, const char *data, size_t length) {
+    while (length > 0) {
+        ssize_t bytes_written = write(fd, data, length);
+        if (bytes_written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        data += bytes_written;
+        length -= (size_t)bytes_written;
+    }
+}
+
+int log_flush_pending(void) {
+    LogRing *ring = log_ring;
+    if (ring == NULL) {
+        return 0;
+    }
+
+    int flushed = 0;
+    size_t buffer_used = 0;
+    const size_t max_line_length = 256 + LOG_MAX_FIELDS * (LOG_TEXT_LENGTH + 64);
+
+    uint64_t dropped = atomic_exchange_explicit(&ring->control.dropped, 0, memory_order_relaxed);
+    if (dropped > 0) {
+        buffer_used += (size_t)snprintf(flush_buffer, sizeof(flush_buffer),
+                                        "level=warn pid=%d event=log_dropped count=%llu\n",
+                                        (int)getpid(), (unsigned long long)dropped);
+    }
+
+    while (1) {
+        uint64_t position = ring->dequeue_position;
+        LogSlot *slot = &ring->slots[position & (LOG_RING_CAPACITY - 1)];
+        uint64_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+
+        if (sequence != position + 1) {
+            break;
+        }
+
+        if (buffer_used + max_line_length > sizeof(flush_buffer)) {
+            write_all(log_output_fd, flush_buffer, buffer_used);
+            buffer_used = 0;
+        }
+
+        buffer_used += format_slot(slot, flush_buffer + buffer_used, sizeof(flush_buffer) - buffer_used);
+        atomic_store_explicit(&slot->sequence, position + LOG_RING_CAPACITY, memory_order_release);
+        ring->dequeue_position = position + 1;
+        flushed++;
+    }
+
+    if (buffer_used > 0) {
+        write_all(log_output_fd, flush_buffer, buffer_used);
+    }
+    return flushed;
+}
+
+static void refresh_cached_pid(void) {
+    cached_pid = getpid();
+}
+
+static void *run_flusher(void *argument) {
+    (void)argument;
+    struct timespec idle_sleep = { .tv_sec = 0, .tv_nsec = LOG_FLUSH_IDLE_SLEEP_NS };
+
+    while (atomic_load_explicit(&flusher_running, memory_order_relaxed)) {
+        if (log_flush_pending() == 0) {
+            nanosleep(&idle_sleep, NULL);
+        }
+    }
+    return NULL;
+}
+
+int initialize_logging(LogLevel level, int output_fd) {
+    void *memory = mmap(NULL, sizeof(LogRing), PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        perror("log mmap failed");
+        return -1;
+    }
+
+    LogRing *ring = memory;
+    for (uint64_t i = 0; i < LOG_RING_CAPACITY; i++) {
+        atomic_init(&ring->slots[i].sequence, i);
+    }
+    atomic_init(&ring->control.level, (int)level);
+
+    log_ring = ring;
+    log_control = &ring->control;
+    log_output_fd = output_fd;
+
+    refresh_cached_pid();
+    pthread_atfork(NULL, NULL, refresh_cached_pid);
+    flusher_owner_pid = cached_pid;
+    atomic_store(&flusher_running, 1);
+    int error = pthread_create(&flusher_thread, NULL, run_flusher, NULL);
+    if (error != 0) {
+        fprintf(stderr, "log flusher thread failed: %s\n", strerror(error));
+        atomic_store(&flusher_running, 0);
+        return -1;
+    }
+    return 0;
+}
+
+void shutdown_logging(void) {
+    if (flusher_owner_pid != getpid()) {
+        return;
+    }
+    if (atomic_exchange(&flusher_running, 0)) {
+        pthread_join(flusher_thread, NULL);
+    }
+    log_flush_pending();
+}
@@ -0,0 +1,76 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#define LOG_RING_CAPACITY 4096
+#define LOG_MAX_FIELDS 4
+#define LOG_TEXT_LENGTH 24
+#define LOG_FLUSH_BUFFER_SIZE 65536
+#define LOG_FLUSH_IDLE_SLEEP_NS 5000000L
+
+typedef enum {
+    LOG_LEVEL_DEBUG,
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_WARN,
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_OFF
+} LogLevel;
+
+typedef enum {
+    LOG_FIELD_INT,
+    LOG_FIELD_TEXT
+} LogFieldType;
+
+typedef struct {
+    const char *key;
+    LogFieldType type;
+    union {
+        int64_t integer;
+        const char *text;
+    } value;
+} LogField;
+
+typedef struct {
+    _Atomic int level;
+    _Atomic uint64_t dropped;
+} LogControl;
+
+extern LogControl *log_control;
+
+static inline bool log_level_enabled(LogLevel level) {
+    return log_control != NULL &&
+           (int)level >= atomic_load_explicit(&log_control->level, memory_order_relaxed);
+}
+
+#define LOG_INT(field_key, field_value) \
+    { .key = (field_key), .type = LOG_FIELD_INT, .value.integer = (int64_t)(field_value) }
+#define LOG_TEXT(field_key, field_value) \
+    { .key = (field_key), .type = LOG_FIELD_TEXT, .value.text = (field_value) }
+
+#define LOG_EVENT(level, event, ...)                                                   \
+    do {                                                                               \
+        if (log_level_enabled(level)) {                                                \
+            const LogField log_fields_[] = { __VA_ARGS__ };                            \
+            log_write((level), (event), log_fields_,                                   \
+                      (int)(sizeof(log_fields_) / sizeof(log_fields_[0])));            \
+        }                                                                              \
+    } while (0)
+
+#define LOG_DEBUG(event, ...) LOG_EVENT(LOG_LEVEL_DEBUG, event, __VA_ARGS__)
+#define LOG_INFO(event, ...) LOG_EVENT(LOG_LEVEL_INFO, event, __VA_ARGS__)
+#define LOG_WARN(event, ...) LOG_EVENT(LOG_LEVEL_WARN, event, __VA_ARGS__)
+#define LOG_ERROR(event, ...) LOG_EVENT(LOG_LEVEL_ERROR, event, __VA_ARGS__)
+
+int initialize_logging(LogLevel level, int output_fd);
+void shutdown_logging(void);
+void log_set_level(LogLevel level);
+LogLevel log_get_level(void);
+int parse_log_level(const char *text, LogLevel *level);
+const char *log_level_name(LogLevel level);
+void log_write(LogLevel level, const char *event, const LogField *fields, int field_count);
+int log_flush_pending(void);
+
+#endif
@@ -5,21 +5,47 @@
 #include <string.h>
 #include <unistd.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <sys/wait.h>
 #include <signal.h>
+#include <poll.h>
 #include "server.h"
 #include "network.h"
 #include "matchmaking.h"
+#include "metrics.h"
+#include "admin.h"
+#include "log.h"
+#include "restart.h"
+#include "admission.h"
+#include "results.h"
+#include "tournament.h"
+#include "leaderboard.h"
+#include "gametable.h"
+#include "workers.h"
+#include "iobackend.h"
+#include "trace.h"
+
+#define MAIN_POLL_FIXED_FDS 3
 
 void handle_sigchld(int signal) {
     (void)signal;
-    while (waitpid(-1, NULL, WNOHANG) > 0);
+    int saved_errno = errno;
+    pid_t child_process_id;
+    while ((child_process_id = waitpid(-1, NULL, WNOHANG)) > 0) {
+        if (child_process_id == replacement_process_id()) {
+            continue;
+        }
+        note_worker_exited(child_process_id);
+    }
+    errno = saved_errno;
 }
 
-int create_server_socket(uint16_t port) {
+static int create_listening_socket(in_addr_t address, uint16_t port, int backlog) {
     int server_socket = socket(AF_INET, SOCK_STREAM, 0);
     if (server_socket < 0) {
         perror("socket creation failed");
@@ -36,7 +62,7 @@ int create_server_socket(uint16_t port) {
     struct sockaddr_in server_address;
     memset(&server_address, 0, sizeof(server_address));
     server_address.sin_family = AF_INET;
-    server_address.sin_addr.s_addr = INADDR_ANY;
+    server_address.sin_addr.s_addr = htonl(address);
     server_address.sin_port = htons(port);
 
     if (bind(server_socket, (struct sockaddr *)&server_address, sizeof(server_address)) < 0) {
@@ -45,7 +71,7 @@ int create_server_socket(uint16_t port) {
         exit(EXIT_FAILURE);
     }
 
-    if (listen(server_socket, BACKLOG_SIZE) < 0) {
+    if (listen(server_socket, backlog) < 0) {
         perror("listen failed");
         close(server_socket);
         exit(EXIT_FAILURE);
@@ -54,7 +80,201 @@ int create_server_socket(uint16_t port) {
     return server_socket;
 }
 
-void accept_clients(int server_socket) {
+int create_server_socket(uint16_t port, int backlog) {
+    return create_listening_socket(INADDR_ANY, port, backlog);
+}
+
+static void remove_stale_unix_socket(const struct sockaddr_un *address) {
+    struct stat existing;
+    if (lstat(address->sun_path, &existing) < 0 || !S_ISSOCK(existing.st_mode)) {
+        return;
+    }
+
+    int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probe < 0) {
+        return;
+    }
+    if (connect(probe, (const struct sockaddr *)address, sizeof(*address)) < 0 && errno == ECONNREFUSED) {
+        unlink(address->sun_path);
+    }
+    close(probe);
+}
+
+int create_unix_socket(const char *path, int backlog) {
+    struct sockaddr_un server_address;
+    memset(&server_address, 0, sizeof(server_address));
+    server_address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(server_address.sun_path)) {
+        fprintf(stderr, "UNIX socket path too long\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(server_address.sun_path, path, strlen(path));
+
+    int server_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server_socket < 0) {
+        perror("socket creation failed");
+        exit(EXIT_FAILURE);
+    }
+
+    remove_stale_unix_socket(&server_address);
+    if (bind(server_socket, (struct sockaddr *)&server_address, sizeof(server_address)) < 0) {
+        perror("bind failed");
+        close(server_socket);
+        exit(EXIT_FAILURE);
+    }
+
+    if (listen(server_socket, backlog) < 0) {
+        perror("listen failed");
+        close(server_socket);
+        exit(EXIT_FAILURE);
+    }
+
+    return server_socket;
+}
+
+int create_admin_socket(uint16_t port) {
+    return create_listening_socket(INADDR_LOOPBACK, port, BACKLOG_SIZE);
+}
+
+static void reject_game_client(int client_socket, const struct sockaddr_in *client_address,
+                               AdmissionDecision decision) {
+    metrics_increment(decision == ADMISSION_OVER_CAPACITY ? METRIC_CONNECTIONS_OVER_CAPACITY
+                                                          : METRIC_CONNECTIONS_RATE_LIMITED);
+    LOG_DEBUG("client_rejected",
+              LOG_TEXT("address", client_address != NULL ? inet_ntoa(client_address->sin_addr) : "unix"),
+              LOG_TEXT("reason", admission_decision_name(decision)));
+    send_error_message(client_socket, admission_decision_name(decision));
+    close(client_socket);
+}
+
+static void admit_game_client(int client_socket, const struct sockaddr_in *client_address) {
+    int open_connections = count_waiting_players() + 2 * count_running_games() + count_tournament_entrants();
+    AdmissionDecision decision = (client_address != NULL)
+                                     ? admit_connection(ntohl(client_address->sin_addr.s_addr), open_connections,
+                                                        metrics_now_ns())
+                                     : admit_local_connection(open_connections);
+    if (decision != ADMISSION_ACCEPTED) {
+        reject_game_client(client_socket, client_address, decision);
+        return;
+    }
+
+    if (client_address != NULL) {
+        LOG_INFO("client_connected",
+                 LOG_TEXT("address", inet_ntoa(client_address->sin_addr)),
+                 LOG_INT("port", ntohs(client_address->sin_port)),
+                 LOG_TEXT("transport", "tcp"),
+                 LOG_INT("fd", client_socket));
+    } else {
+        LOG_INFO("client_connected", LOG_TEXT("transport", "unix"), LOG_INT("fd", client_socket));
+    }
+    metrics_increment(METRIC_CONNECTIONS_ACCEPTED);
+
+    if (tournament_enabled()) {
+        register_tournament_entrant(client_socket);
+    } else {
+        handle_new_connection(client_socket);
+    }
+}
+
+static void accept_game_clients(IoBackend *acceptor) {
+    IoEvent events[ACCEPT_BATCH_SIZE];
+    int accepted = io_backend_wait(acceptor, events, ACCEPT_BATCH_SIZE, 0);
+    if (accepted < 0) {
+        LOG_WARN("accept_failed", LOG_INT("errno", errno));
+        return;
+    }
+
+    for (int i = 0; i < accepted; i++) {
+        struct sockaddr_in client_address;
+        socklen_t client_address_length = sizeof(client_address);
+        if (events[i].token == UNIX_LISTENER_TOKEN) {
+            admit_game_client(events[i].fd, NULL);
+            continue;
+        }
+        if (getpeername(events[i].fd, (struct sockaddr *)&client_address, &client_address_length) < 0) {
+            close(events[i].fd);
+            continue;
+        }
+        admit_game_client(events[i].fd, &client_address);
+    }
+}
+
+static int watch_game_listeners(IoBackend *acceptor, const server_config *config) {
+    if (io_backend_watch_accept(acceptor, config->socket_fd, TCP_LISTENER_TOKEN) < 0) {
+        return -1;
+    }
+    if (config->unix_socket_fd >= 0 &&
+        io_backend_watch_accept(acceptor, config->unix_socket_fd, UNIX_LISTENER_TOKEN) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+static void unwatch_game_listeners(IoBackend *acceptor, const server_config *config) {
+    io_backend_remove(acceptor, config->socket_fd);
+    if (config->unix_socket_fd >= 0) {
+        io_backend_remove(acceptor, config->unix_socket_fd);
+    }
+}
+
+static void set_listener_nonblocking(int listener_fd) {
+    int listener_flags = fcntl(listener_fd, F_GETFL, 0);
+    if (listener_flags < 0 || fcntl(listener_fd, F_SETFL, listener_flags | O_NONBLOCK) < 0) {
+        perror("fcntl failed");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void handle_game_results(void) {
+    GameResult result;
+    while (read_game_result(&result)) {
+        note_game_finished(&result);
+        record_leaderboard_result(&result);
+        record_tournament_result(&result);
+    }
+}
+
+static void collect_exited_workers(void) {
+    if (game_workers_exited()) {
+        handle_game_results();
+        note_games_abandoned(reap_game_workers());
+    }
+}
+
+static int earliest_timeout_ms(int first, int second) {
+    if (first < 0 || (second >= 0 && second < first)) {
+        return second;
+    }
+    return first;
+}
+
+static int next_poll_timeout_ms(void) {
+    uint64_t now_ns = metrics_now_ns();
+    int timeout = earliest_timeout_ms(leaderboard_snapshot_timeout_ms(now_ns), worker_pool_timeout_ms(now_ns));
+    timeout = earliest_timeout_ms(timeout, admin_timeout_ms(now_ns));
+    return earliest_timeout_ms(timeout, tournament_timeout_ms(now_ns));
+}
+
+static void drain_running_games(void) {
+    LOG_INFO("draining_games", LOG_INT("running_games", count_running_games()));
+
+    struct pollfd drain_fds[1 + MAX_GAME_WORKERS];
+    drain_fds[0].fd = results_fd();
+    drain_fds[0].events = POLLIN;
+    while (count_running_games() > 0) {
+        int worker_count = collect_worker_fds(drain_fds + 1, MAX_GAME_WORKERS);
+        if (poll(drain_fds, (nfds_t)worker_count + 1, RESTART_DRAIN_POLL_MS) > 0) {
+            handle_worker_requests(drain_fds + 1, worker_count);
+            handle_game_results();
+        }
+        collect_exited_workers();
+    }
+
+    shutdown_worker_pool();
+    LOG_INFO("drain_complete", LOG_INT("pid", getpid()));
+}
+
+void accept_clients(const server_config *config) {
     struct sigaction signal_action;
     memset(&signal_action, 0, sizeof(signal_action));
     signal_action.sa_handler = handle_sigchld;
@@ -66,46 +286,347 @@ void accept_clients(int server_socket) {
         exit(EXIT_FAILURE);
     }
 
-    printf("Server listening on port...\n");
+    signal_action.sa_handler = handle_restart_signal;
+    signal_action.sa_flags = 0;
+    if (sigaction(SIGHUP, &signal_action, NULL) < 0) {
+        perror("sigaction failed");
+        exit(EXIT_FAILURE);
+    }
+
+    set_listener_nonblocking(config->socket_fd);
+    if (config->admin_socket_fd >= 0) {
+        set_listener_nonblocking(config->admin_socket_fd);
+    }
+    if (config->unix_socket_fd >= 0) {
+        set_listener_nonblocking(config->unix_socket_fd);
+    }
+
+    LOG_INFO("server_listening", LOG_INT("port", config->port), LOG_INT("admin_port", config->admin_port),
+             LOG_TEXT("unix_path", config->unix_socket_path != NULL ? config->unix_socket_path : ""),
+             LOG_INT("backlog", config->listen_backlog));
     initialize_matchmaking();
+    if (start_worker_pool() < 0) {
+        fprintf(stderr, "Failed to start game workers\n");
+        exit(EXIT_FAILURE);
+    }
+    adopt_inherited_players();
+
+    IoBackend *acceptor = create_io_backend();
+    if (acceptor == NULL || watch_game_listeners(acceptor, config) < 0) {
+        perror("io backend setup failed");
+        exit(EXIT_FAILURE);
+    }
+    LOG_INFO("io_backend_ready", LOG_TEXT("backend", io_backend_name(acceptor->kind)));
+    notify_replacement_ready();
+
+    struct pollfd listeners[MAIN_POLL_FIXED_FDS + MAX_GAME_WORKERS + ADMIN_MAX_CLIENTS];
+    nfds_t listener_count = 0;
+    nfds_t admin_index = 0;
+
+    listeners[listener_count].fd = io_backend_fd(acceptor);
+    listeners[listener_count].events = POLLIN;
+    listener_count++;
+
+    if (config->admin_socket_fd >= 0) {
+        admin_index = listener_count;
+        listeners[listener_count].fd = config->admin_socket_fd;
+        listeners[listener_count].events = POLLIN;
+        listener_count++;
+    }
 
+    nfds_t results_index = listener_count;
+    listeners[results_index].fd = results_fd();
+    listeners[results_index].events = POLLIN;
+    nfds_t worker_index = results_index + 1;
+
+    int restart_deferred = 0;
     while (1) {
-        struct sockaddr_in client_address;
-        socklen_t client_address_length = sizeof(client_address);
+        if (restart_pending() && tournament_active()) {
+            if (!restart_deferred) {
+                LOG_INFO("restart_deferred", LOG_TEXT("reason", "tournament_active"));
+                restart_deferred = 1;
+            }
+        } else if (restart_requested()) {
+            restart_deferred = 0;
+            save_leaderboard_snapshot();
+            unwatch_game_listeners(acceptor, config);
+            accept_game_clients(acceptor);
+            if (hand_off_to_replacement(config) == 0) {
+                break;
+            }
+            watch_game_listeners(acceptor, config);
+        }
 
-        int client_socket = accept(server_socket, (struct sockaddr *)&client_address, &client_address_length);
-        if (client_socket < 0) {
+        int worker_count = collect_worker_fds(listeners + worker_index, MAX_GAME_WORKERS);
+        struct pollfd *admin_fds = listeners + worker_index + worker_count;
+        int admin_count = collect_admin_fds(admin_fds, ADMIN_MAX_CLIENTS);
+        int ready = poll(listeners, worker_index + (nfds_t)(worker_count + admin_count), next_poll_timeout_ms());
+        if (ready < 0) {
             if (errno == EINTR) {
                 continue;
             }
-            perror("accept failed");
+            LOG_ERROR("poll_failed", LOG_INT("errno", errno));
             continue;
         }
 
-        printf("Client connected from %s:%d\n",
-               inet_ntoa(client_address.sin_addr),
-               ntohs(client_address.sin_port));
+        if (listeners[0].revents & POLLIN) {
+            accept_game_clients(acceptor);
+        }
 
-        handle_new_connection(client_socket);
+        handle_admin_clients(admin_fds, admin_count, metrics_now_ns());
+        if (admin_index > 0 && (listeners[admin_index].revents & POLLIN)) {
+            handle_admin_connection(config->admin_socket_fd);
+        }
+
+        handle_worker_requests(listeners + worker_index, worker_count);
+        if (listeners[results_index].revents & POLLIN) {
+            handle_game_results();
+        }
+
+        collect_exited_workers();
+        maintain_worker_pool(metrics_now_ns());
+        retry_tournament_games(metrics_now_ns());
+        maybe_save_leaderboard_snapshot(metrics_now_ns());
+    }
+
+    close_admin_clients();
+    destroy_io_backend(acceptor);
+    close(config->socket_fd);
+    if (config->unix_socket_fd >= 0) {
+        close(config->unix_socket_fd);
+    }
+    for (nfds_t i = 1; i < listener_count; i++) {
+        close(listeners[i].fd);
+    }
+    drop_waiting_players();
+    drain_running_games();
+}
+
+static int parse_port(const char *text, uint16_t *port) {
+    char *endptr;
+    long port_number = strtol(text, &endptr, 10);
+    if (*text == '\0' || *endptr != '\0' || port_number <= 0 || port_number > 65535) {
+        return -1;
     }
+    *port = (uint16_t)port_number;
+    return 0;
+}
+
+static int parse_limit(const char *text, long minimum, long maximum, long *value) {
+    char *endptr;
+    long number = strtol(text, &endptr, 10);
+    if (*text == '\0' || *endptr != '\0' || number < minimum || number > maximum) {
+        return -1;
+    }
+    *value = number;
+    return 0;
+}
+
+static void print_usage(const char *program_name) {
+    fprintf(stderr, "Usage: %s [-a admin_port] [-L debug|info|warn|error|off] [-b listen_backlog] "
+                    "[-m max_connections] [-r connects_per_second] [-B connect_burst] "
+                    "[-T swiss|roundrobin -N entrants [-R rounds]] [-S leaderboard_file [-I snapshot_seconds]] "
+                    "[-w min_workers] [-W max_workers] [-H heartbeat_seconds] [-s 6|8|10] [-i epoll|io_uring] "
+                    "[-u unix_socket_path] <port>\n", program_name);
 }
 
 int main(int argc, char *argv[]) {
-    if (argc != 2) {
-        fprintf(stderr, "Usage: %s <port>\n", argv[0]);
+    server_config config;
+    memset(&config, 0, sizeof(config));
+    config.admin_socket_fd = -1;
+    config.unix_socket_fd = -1;
+    config.listen_backlog = DEFAULT_LISTEN_BACKLOG;
+    LogLevel log_level = LOG_LEVEL_INFO;
+    admission_config admission = {
+        .max_connections = DEFAULT_MAX_CONNECTIONS,
+        .connect_rate = DEFAULT_CONNECT_RATE,
+        .connect_burst = DEFAULT_CONNECT_BURST
+    };
+    tournament_config tournament = { .format = TOURNAMENT_NONE, .entrants = 0, .rounds = 0 };
+    const char *leaderboard_path = NULL;
+    int snapshot_seconds = LEADERBOARD_DEFAULT_SNAPSHOT_SECONDS;
+    worker_pool_config worker_pool = { .min_workers = DEFAULT_MIN_WORKERS, .max_workers = DEFAULT_MAX_WORKERS,
+                                       .heartbeat_interval_ms = DEFAULT_HEARTBEAT_INTERVAL_MS };
+    int board_size = BOARD_DEFAULT_SIZE;
+    IoBackendKind io_backend = IO_BACKEND_EPOLL;
+    long limit;
+
+    int option;
+    while ((option = getopt(argc, argv, "a:L:b:m:r:B:T:N:R:S:I:w:W:H:s:i:u:")) != -1) {
+        switch (option) {
+            case 'a':
+                if (parse_port(optarg, &config.admin_port) < 0) {
+                    fprintf(stderr, "Invalid admin port number\n");
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'L':
+                if (parse_log_level(optarg, &log_level) < 0) {
+                    fprintf(stderr, "Invalid log level\n");
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'b':
+                if (parse_limit(optarg, 1, MAX_LISTEN_BACKLOG, &limit) < 0) {
+                    fprintf(stderr, "Invalid listen backlog\n");
+                    return EXIT_FAILURE;
+                }
+                config.listen_backlog = (int)limit;
+                break;
+            case 'm':
+                if (parse_limit(optarg, 0, 1000000, &limit) < 0) {
+                    fprintf(stderr, "Invalid connection limit\n");
+                    return EXIT_FAILURE;
+                }
+                admission.max_connections = (int)limit;
+                break;
+            case 'r':
+                if (parse_limit(optarg, 0, ADMISSION_MAX_CONNECT_RATE, &limit) < 0) {
+                    fprintf(stderr, "Invalid connect rate\n");
+                    return EXIT_FAILURE;
+                }
+                admission.connect_rate = (uint32_t)limit;
+                break;
+            case 'B':
+                if (parse_limit(optarg, 1, 1000000, &limit) < 0) {
+                    fprintf(stderr, "Invalid connect burst\n");
+                    return EXIT_FAILURE;
+                }
+                admission.connect_burst = (uint32_t)limit;
+                break;
+            case 'T':
+                if (parse_tournament_format(optarg, &tournament.format) < 0) {
+                    fprintf(stderr, "Invalid tournament format\n");
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'N':
+                if (parse_limit(optarg, 2, MAX_TOURNAMENT_ENTRANTS, &limit) < 0) {
+                    fprintf(stderr, "Invalid number of entrants\n");
+                    return EXIT_FAILURE;
+                }
+                tournament.entrants = (int)limit;
+                break;
+            case 'R':
+                if (parse_limit(optarg, 1, MAX_TOURNAMENT_ENTRANTS, &limit) < 0) {
+                    fprintf(stderr, "Invalid number of rounds\n");
+                    return EXIT_FAILURE;
+                }
+                tournament.rounds = (int)limit;
+                break;
+            case 'S':
+                leaderboard_path = optarg;
+                break;
+            case 'I':
+                if (parse_limit(optarg, 1, 86400, &limit) < 0) {
+                    fprintf(stderr, "Invalid snapshot interval\n");
+                    return EXIT_FAILURE;
+                }
+                snapshot_seconds = (int)limit;
+                break;
+            case 'w':
+                if (parse_limit(optarg, 1, MAX_GAME_WORKERS, &limit) < 0) {
+                    fprintf(stderr, "Invalid minimum worker count\n");
+                    return EXIT_FAILURE;
+                }
+                worker_pool.min_workers = (int)limit;
+                break;
+            case 'W':
+                if (parse_limit(optarg, 1, MAX_GAME_WORKERS, &limit) < 0) {
+                    fprintf(stderr, "Invalid maximum worker count\n");
+                    return EXIT_FAILURE;
+                }
+                worker_pool.max_workers = (int)limit;
+                break;
+            case 'H':
+                if (parse_limit(optarg, 0, 3600, &limit) < 0) {
+                    fprintf(stderr, "Invalid heartbeat interval\n");
+                    return EXIT_FAILURE;
+                }
+                worker_pool.heartbeat_interval_ms = (int)limit * 1000;
+                break;
+            case 's':
+                if (parse_limit(optarg, BOARD_MIN_SIZE, BOARD_MAX_SIZE, &limit) < 0 || !is_supported_board_size((int)limit)) {
+                    fprintf(stderr, "Invalid board size\n");
+                    return EXIT_FAILURE;
+                }
+                board_size = (int)limit;
+                break;
+            case 'i':
+                if (parse_io_backend(optarg, &io_backend) < 0) {
+                    fprintf(stderr, "Invalid I/O backend\n");
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'u':
+                if (optarg[0] == '\0') {
+                    fprintf(stderr, "Invalid UNIX socket path\n");
+                    return EXIT_FAILURE;
+                }
+                config.unix_socket_path = optarg;
+                break;
+            default:
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if ((tournament.format == TOURNAMENT_NONE) != (tournament.entrants == 0)) {
+        fprintf(stderr, "Tournament mode needs both -T and -N\n");
         return EXIT_FAILURE;
     }
 
-    char *endptr;
-    long port_number = strtol(argv[1], &endptr, 10);
-    if (*endptr != '\0' || port_number <= 0 || port_number > 65535) {
+    if (worker_pool.min_workers > worker_pool.max_workers) {
+        fprintf(stderr, "Minimum worker count exceeds the maximum\n");
+        return EXIT_FAILURE;
+    }
+
+    if (argc - optind != 1) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (parse_port(argv[optind], &config.port) < 0) {
         fprintf(stderr, "Invalid port number\n");
         return EXIT_FAILURE;
     }
 
-    int server_socket = create_server_socket((uint16_t)port_number);
-    accept_clients(server_socket);
-    close(server_socket);
+    if (initialize_metrics() < 0 || initialize_logging(log_level, STDOUT_FILENO) < 0 || initialize_results() < 0 ||
+        initialize_game_table(worker_pool.max_workers * WORKER_MAX_GAMES) < 0 || initialize_tracing() < 0) {
+        return EXIT_FAILURE;
+    }
+
+    configure_admission(&admission);
+    configure_tournament(&tournament);
+    configure_worker_pool(&worker_pool);
+    set_game_board_size(board_size);
+    configure_io_backend(io_backend);
+    initialize_leaderboard();
+    configure_leaderboard_snapshots(leaderboard_path, snapshot_seconds);
+    if (load_leaderboard_snapshot() < 0) {
+        perror("leaderboard snapshot load failed");
+        return EXIT_FAILURE;
+    }
+    remember_command_line(argv);
+    if (inherit_listening_sockets(&config)) {
+        LOG_INFO("inherited_listeners", LOG_INT("game_fd", config.socket_fd),
+                 LOG_INT("admin_fd", config.admin_socket_fd), LOG_INT("unix_fd", config.unix_socket_fd));
+        listen(config.socket_fd, config.listen_backlog);
+        if (config.unix_socket_fd >= 0) {
+            listen(config.unix_socket_fd, config.listen_backlog);
+        }
+    } else {
+        config.socket_fd = create_server_socket(config.port, config.listen_backlog);
+        if (config.admin_port != 0) {
+            config.admin_socket_fd = create_admin_socket(config.admin_port);
+        }
+    }
+    if (config.unix_socket_fd < 0 && config.unix_socket_path != NULL) {
+        config.unix_socket_fd = create_unix_socket(config.unix_socket_path, config.listen_backlog);
+    }
+
+    accept_clients(&config);
+    shutdown_logging();
 
     return EXIT_SUCCESS;
 }
@@ -1,9 +1,21 @@
 #ifndef MATCHMAKING_H
 #define MATCHMAKING_H
 
+#include "results.h"
+
 void initialize_matchmaking(void);
+void set_game_board_size(int size);
 void add_waiting_player(int client_socket);
 int has_waiting_players(void);
+int count_waiting_players(void);
 void handle_new_connection(int client_socket);
+void adopt_waiting_player(int client_socket);
+int get_waiting_player_sockets(int *sockets, int max_sockets);
+void drop_waiting_players(void);
+void note_game_finished(const GameResult *result);
+void note_games_abandoned(int count);
+int count_running_games(void);
+int spawn_game(int black_player_socket, int white_player_socket, int flags);
+int start_rematch(int previous_game_id, int *slot);
 
 #endif
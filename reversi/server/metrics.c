@@ -0,0 +1,276 @@
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "metrics.h"
+
+typedef struct {
+    _Atomic uint64_t buckets[METRICS_HISTOGRAM_BUCKETS];
+    _Atomic uint64_t count;
+    _Atomic uint64_t sum;
+} HistogramShard;
+
+typedef struct {
+    _Alignas(64) _Atomic uint64_t counters[METRIC_COUNTER_COUNT];
+    _Atomic int64_t gauges[METRIC_GAUGE_COUNT];
+    _Atomic uint64_t invalid_moves[INVALID_REASON_COUNT];
+    HistogramShard histograms[METRIC_HISTOGRAM_COUNT];
+} MetricsShard;
+
+typedef struct {
+    MetricsShard shards[METRICS_SHARD_COUNT];
+} MetricsRegistry;
+
+static const char *COUNTER_NAMES[METRIC_COUNTER_COUNT] = {
+    "reversi_connections_accepted_total",
+    "reversi_connections_over_capacity_total",
+    "reversi_connections_rate_limited_total",
+    "reversi_disconnects_total",
+    "reversi_games_started_total",
+    "reversi_games_finished_total",
+    "reversi_moves_total",
+    "reversi_premoves_total",
+    "reversi_heartbeat_timeouts_total",
+    "reversi_bytes_received_total",
+    "reversi_bytes_sent_total"
+};
+
+static const char *GAUGE_NAMES[METRIC_GAUGE_COUNT] = {
+    "reversi_active_games",
+    "reversi_waiting_players",
+    "reversi_game_workers"
+};
+
+static const char *HISTOGRAM_NAMES[METRIC_HISTOGRAM_COUNT] = {
+    "reversi_move_latency_seconds",
+    "reversi_queue_wait_seconds",
+    "reversi_peer_rtt_seconds"
+};
+
+static const char *INVALID_REASON_NAMES[INVALID_REASON_COUNT] = {
+    "out_of_bounds",
+    "occupied",
+    "no_flip",
+    "has_legal_moves",
+    "unknown_command",
+    "other"
+};
+
+static MetricsRegistry *registry = NULL;
+static MetricsShard *local_shard = NULL;
+
+int initialize_metrics(void) {
+    void *memory = mmap(NULL, sizeof(MetricsRegistry), PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        perror("metrics mmap failed");
+        return -1;
+    }
+
+    registry = memory;
+    metrics_attach_process();
+    return 0;
+}
+
+void metrics_attach_process(void) {
+    if (registry == NULL) {
+        return;
+    }
+    local_shard = &registry->shards[getpid() % METRICS_SHARD_COUNT];
+}
+
+uint64_t metrics_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+void metrics_add(MetricCounter counter, uint64_t value) {
+    if (local_shard == NULL) {
+        return;
+    }
+    atomic_fetch_add_explicit(&local_shard->counters[counter], value, memory_order_relaxed);
+}
+
+void metrics_increment(MetricCounter counter) {
+    metrics_add(counter, 1);
+}
+
+void metrics_gauge_add(MetricGauge gauge, int64_t delta) {
+    if (local_shard == NULL) {
+        return;
+    }
+    atomic_fetch_add_explicit(&local_shard->gauges[gauge], delta, memory_order_relaxed);
+}
+
+int metrics_histogram_bucket(uint64_t nanoseconds) {
+    if (nanoseconds < (1ULL << METRICS_HISTOGRAM_MIN_SHIFT)) {
+        return 0;
+    }
+
+    int most_significant_bit = 63 - __builtin_clzll(nanoseconds);
+    if (most_significant_bit > METRICS_HISTOGRAM_MAX_SHIFT) {
+        return METRICS_HISTOGRAM_BUCKETS - 1;
+    }
+
+    int sub_bucket = (int)(nanoseconds >> (most_significant_bit - METRICS_HISTOGRAM_SUB_BUCKET_BITS)) &
+                     ((1 << METRICS_HISTOGRAM_SUB_BUCKET_BITS) - 1);
+    return 1 + ((most_significant_bit - METRICS_HISTOGRAM_MIN_SHIFT) << METRICS_HISTOGRAM_SUB_BUCKET_BITS) + sub_bucket;
+}
+
+uint64_t metrics_histogram_upper_bound(int bucket) {
+    if (bucket == 0) {
+        return (1ULL << METRICS_HISTOGRAM_MIN_SHIFT) - 1;
+    }
+
+    int most_significant_bit = METRICS_HISTOGRAM_MIN_SHIFT + ((bucket - 1) >> METRICS_HISTOGRAM_SUB_BUCKET_BITS);
+    uint64_t sub_bucket = (uint64_t)((bucket - 1) & ((1 << METRICS_HISTOGRAM_SUB_BUCKET_BITS) - 1));
+    uint64_t step_count = (1ULL << METRICS_HISTOGRAM_SUB_BUCKET_BITS) + sub_bucket + 1;
+    return (step_count << (most_significant_bit - METRICS_HISTOGRAM_SUB_BUCKET_BITS)) - 1;
+}
+
+void metrics_record_latency(MetricHistogram histogram, uint64_t nanoseconds) {
+    if (local_shard == NULL) {
+        return;
+    }
+
+    HistogramShard *shard = &local_shard->histograms[histogram];
+    atomic_fetch_add_explicit(&shard->buckets[metrics_histogram_bucket(nanoseconds)], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&shard->count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&shard->sum, nanoseconds, memory_order_relaxed);
+}
+
+void metrics_record_invalid_move(const char *reason) {
+    if (local_shard == NULL) {
+        return;
+    }
+
+    int reason_index = INVALID_REASON_OTHER;
+    for (int i = 0; i < INVALID_REASON_OTHER; i++) {
+        if (strcmp(reason, INVALID_REASON_NAMES[i]) == 0) {
+            reason_index = i;
+            break;
+        }
+    }
+    atomic_fetch_add_explicit(&local_shard->invalid_moves[reason_index], 1, memory_order_relaxed);
+}
+
+static uint64_t sum_counter(MetricCounter counter) {
+    uint64_t total = 0;
+    for (int i = 0; i < METRICS_SHARD_COUNT; i++) {
+        total += atomic_load_explicit(&registry->shards[i].counters[counter], memory_order_relaxed);
+    }
+    return total;
+}
+
+static int64_t sum_gauge(MetricGauge gauge) {
+    int64_t total = 0;
+    for (int i = 0; i < METRICS_SHARD_COUNT; i++) {
+        total += atomic_load_explicit(&registry->shards[i].gauges[gauge], memory_order_relaxed);
+    }
+    return total;
+}
+
+static uint64_t sum_invalid_moves(InvalidMoveReason reason) {
+    uint64_t total = 0;
+    for (int i = 0; i < METRICS_SHARD_COUNT; i++) {
+        total += atomic_load_explicit(&registry->shards[i].invalid_moves[reason], memory_order_relaxed);
+    }
+    return total;
+}
+
+static size_t append_text(char *buffer, size_t buffer_size, size_t offset, const char *format, ...) {
+    if (offset >= buffer_size) {
+        return offset;
+    }
+
+    va_list arguments;
+    va_start(arguments, format);
+    int written = vsnprintf(buffer + offset, buffer_size - offset, format, arguments);
+    va_end(arguments);
+
+    if (written < 0) {
+        return offset;
+    }
+    if ((size_t)written >= buffer_size - offset) {
+        return buffer_size;
+    }
+    return offset + (size_t)written;
+}
+
+static size_t render_histogram(char *buffer, size_t buffer_size, size_t offset, MetricHistogram histogram) {
+    const char *name = HISTOGRAM_NAMES[histogram];
+    uint64_t cumulative = 0;
+    uint64_t count = 0;
+    uint64_t sum = 0;
+
+    offset = append_text(buffer, buffer_size, offset, "# TYPE %s histogram\n", name);
+
+    for (int bucket = 0; bucket < METRICS_HISTOGRAM_BUCKETS; bucket++) {
+        for (int i = 0; i < METRICS_SHARD_COUNT; i++) {
+            cumulative += atomic_load_explicit(&registry->shards[i].histograms[histogram].buckets[bucket],
+                                               memory_order_relaxed);
+        }
+        if (bucket == METRICS_HISTOGRAM_BUCKETS - 1) {
+            break;
+        }
+        offset = append_text(buffer, buffer_size, offset, "%s_bucket{le=\"%.9g\"} %llu\n",
+                             name, (double)metrics_histogram_upper_bound(bucket) / 1e9,
+                             (unsigned long long)cumulative);
+    }
+
+    for (int i = 0; i < METRICS_SHARD_COUNT; i++) {
+        count += atomic_load_explicit(&registry->shards[i].histograms[histogram].count, memory_order_relaxed);
+        sum += atomic_load_explicit(&registry->shards[i].histograms[histogram].sum, memory_order_relaxed);
+    }
+
+    offset = append_text(buffer, buffer_size, offset, "%s_bucket{le=\"+Inf\"} %llu\n",
+                         name, (unsigned long long)cumulative);
+    offset = append_text(buffer, buffer_size, offset, "%s_sum %.9f\n", name, (double)sum / 1e9);
+    offset = append_text(buffer, buffer_size, offset, "%s_count %llu\n", name, (unsigned long long)count);
+    return offset;
+}
+
+size_t metrics_render_prometheus(char *buffer, size_t buffer_size) {
+    size_t offset = 0;
+
+    if (buffer_size == 0) {
+        return 0;
+    }
+    buffer[0] = '\0';
+
+    if (registry == NULL) {
+        return 0;
+    }
+
+    for (int counter = 0; counter < METRIC_COUNTER_COUNT; counter++) {
+        offset = append_text(buffer, buffer_size, offset, "# TYPE %s counter\n%s %llu\n",
+                             COUNTER_NAMES[counter], COUNTER_NAMES[counter],
+                             (unsigned long long)sum_counter((MetricCounter)counter));
+    }
+
+    for (int gauge = 0; gauge < METRIC_GAUGE_COUNT; gauge++) {
+        offset = append_text(buffer, buffer_size, offset, "# TYPE %s gauge\n%s %lld\n",
+                             GAUGE_NAMES[gauge], GAUGE_NAMES[gauge],
+                             (long long)sum_gauge((MetricGauge)gauge));
+    }
+
+    offset = append_text(buffer, buffer_size, offset, "# TYPE reversi_invalid_moves_total counter\n");
+    for (int reason = 0; reason < INVALID_REASON_COUNT; reason++) {
+        offset = append_text(buffer, buffer_size, offset, "reversi_invalid_moves_total{reason=\"%s\"} %llu\n",
+                             INVALID_REASON_NAMES[reason],
+                             (unsigned long long)sum_invalid_moves((InvalidMoveReason)reason));
+    }
+
+    for (int histogram = 0; histogram < METRIC_HISTOGRAM_COUNT; histogram++) {
+        offset = render_histogram(buffer, buffer_size, offset, (MetricHistogram)histogram);
+    }
+
+    if (offset >= buffer_size) {
+        offset = buffer_size - 1;
+    }
+    return offset;
+}
@@ -0,0 +1,64 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define METRICS_SHARD_COUNT 16
+#define METRICS_HISTOGRAM_SUB_BUCKET_BITS 2
+#define METRICS_HISTOGRAM_MIN_SHIFT 10
+#define METRICS_HISTOGRAM_MAX_SHIFT 36
+#define METRICS_HISTOGRAM_BUCKETS (1 + (METRICS_HISTOGRAM_MAX_SHIFT - METRICS_HISTOGRAM_MIN_SHIFT + 1) * (1 << METRICS_HISTOGRAM_SUB_BUCKET_BITS))
+
+typedef enum {
+    METRIC_CONNECTIONS_ACCEPTED,
+    METRIC_CONNECTIONS_OVER_CAPACITY,
+    METRIC_CONNECTIONS_RATE_LIMITED,
+    METRIC_DISCONNECTS,
+    METRIC_GAMES_STARTED,
+    METRIC_GAMES_FINISHED,
+    METRIC_MOVES_APPLIED,
+    METRIC_PREMOVES_APPLIED,
+    METRIC_HEARTBEAT_TIMEOUTS,
+    METRIC_BYTES_RECEIVED,
+    METRIC_BYTES_SENT,
+    METRIC_COUNTER_COUNT
+} MetricCounter;
+
+typedef enum {
+    METRIC_ACTIVE_GAMES,
+    METRIC_WAITING_PLAYERS,
+    METRIC_GAME_WORKERS,
+    METRIC_GAUGE_COUNT
+} MetricGauge;
+
+typedef enum {
+    METRIC_MOVE_LATENCY,
+    METRIC_QUEUE_WAIT,
+    METRIC_PEER_RTT,
+    METRIC_HISTOGRAM_COUNT
+} MetricHistogram;
+
+typedef enum {
+    INVALID_REASON_OUT_OF_BOUNDS,
+    INVALID_REASON_OCCUPIED,
+    INVALID_REASON_NO_FLIP,
+    INVALID_REASON_HAS_LEGAL_MOVES,
+    INVALID_REASON_UNKNOWN_COMMAND,
+    INVALID_REASON_OTHER,
+    INVALID_REASON_COUNT
+} InvalidMoveReason;
+
+int initialize_metrics(void);
+void metrics_attach_process(void);
+uint64_t metrics_now_ns(void);
+void metrics_add(MetricCounter counter, uint64_t value);
+void metrics_increment(MetricCounter counter);
+void metrics_gauge_add(MetricGauge gauge, int64_t delta);
+void metrics_record_latency(MetricHistogram histogram, uint64_t nanoseconds);
+void metrics_record_invalid_move(const char *reason);
+int metrics_histogram_bucket(uint64_t nanoseconds);
+uint64_t metrics_histogram_upper_bound(int bucket);
+size_t metrics_render_prometheus(char *buffer, size_t buffer_size);
+
+#endif
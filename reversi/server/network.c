@@ -4,23 +4,48 @@
 #include <string.h>
 #include <unistd.h>
 #include <sys/socket.h>
-#include <ctype.h>
 #include "network.h"
+#include "metrics.h"
+#include "trace.h"
 #include "../common/protocol.h"
 #include "../common/board.h"
 
 #define BUFFER_SIZE 1024
 
+static MessageSender message_sender = NULL;
+
+void set_message_sender(MessageSender sender) {
+    message_sender = sender;
+}
+
+static size_t clamp_formatted_length(int written, size_t buffer_size) {
+    if (written < 0) {
+        return 0;
+    }
+    if ((size_t)written >= buffer_size) {
+        return buffer_size - 1;
+    }
+    return (size_t)written;
+}
+
 ssize_t receive_message(int socket_fd, char *buffer, size_t buffer_size) {
     ssize_t bytes_received = recv(socket_fd, buffer, buffer_size - 1, 0);
     if (bytes_received > 0) {
         buffer[bytes_received] = '\0';
+        metrics_add(METRIC_BYTES_RECEIVED, (uint64_t)bytes_received);
     }
     return bytes_received;
 }
 
 ssize_t send_message(int socket_fd, const char *message, size_t message_length) {
-    return send(socket_fd, message, message_length, 0);
+    TraceSpan span = trace_begin(TRACE_SEND);
+    ssize_t bytes_sent = (message_sender != NULL) ? message_sender(socket_fd, message, message_length)
+                                                  : send(socket_fd, message, message_length, MSG_NOSIGNAL);
+    if (bytes_sent > 0) {
+        metrics_add(METRIC_BYTES_SENT, (uint64_t)bytes_sent);
+    }
+    trace_end(&span, message, message_length);
+    return bytes_sent;
 }
 
 void handle_client_connection(int client_socket) {
@@ -44,122 +69,262 @@ void handle_client_connection(int client_socket) {
     }
 }
 
+size_t format_wait_message(char *buffer, size_t buffer_size) {
+    int written = snprintf(buffer, buffer_size, "%s%s", MESSAGE_WAIT, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
+}
+
 ssize_t send_wait_message(int socket_fd) {
     char message[MAX_MESSAGE_LENGTH];
-    snprintf(message, sizeof(message), "%s%s", MESSAGE_WAIT, PROTOCOL_TERMINATOR);
-    return send_message(socket_fd, message, strlen(message));
+    size_t length = format_wait_message(message, sizeof(message));
+    return send_message(socket_fd, message, length);
+}
+
+size_t format_welcome_message(char *buffer, size_t buffer_size, const char *color) {
+    int written = snprintf(buffer, buffer_size, "%s%s%s%s",
+                           MESSAGE_WELCOME, PROTOCOL_DELIMITER, color, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
 }
 
 ssize_t send_welcome_message(int socket_fd, const char *color) {
     char message[MAX_MESSAGE_LENGTH];
-    snprintf(message, sizeof(message), "%s%s%s%s",
-             MESSAGE_WELCOME, PROTOCOL_DELIMITER, color, PROTOCOL_TERMINATOR);
-    return send_message(socket_fd, message, strlen(message));
+    size_t length = format_welcome_message(message, sizeof(message), color);
+    return send_message(socket_fd, message, length);
 }
 
-ssize_t send_start_message(int socket_fd) {
+size_t format_error_message(char *buffer, size_t buffer_size, const char *reason) {
+    int written = snprintf(buffer, buffer_size, "%s%s%s%s",
+                           MESSAGE_ERROR, PROTOCOL_DELIMITER, reason, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
+}
+
+ssize_t send_error_message(int socket_fd, const char *reason) {
     char message[MAX_MESSAGE_LENGTH];
-    snprintf(message, sizeof(message), "%s%s", MESSAGE_START, PROTOCOL_TERMINATOR);
-    return send_message(socket_fd, message, strlen(message));
+    size_t length = format_error_message(message, sizeof(message), reason);
+    return send_message(socket_fd, message, length);
 }
 
-ssize_t send_board_message(int socket_fd, const GameState *game) {
+size_t format_start_message(char *buffer, size_t buffer_size) {
+    int written = snprintf(buffer, buffer_size, "%s%s", MESSAGE_START, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
+}
+
+ssize_t send_start_message(int socket_fd) {
     char message[MAX_MESSAGE_LENGTH];
-    char board_string[BOARD_SIZE + 1];
+    size_t length = format_start_message(message, sizeof(message));
+    return send_message(socket_fd, message, length);
+}
+
+size_t format_board_message(char *buffer, size_t buffer_size, const GameState *game) {
+    char board_string[BOARD_MAX_CELLS + 1];
     
     int index = 0;
-    for (int row = 0; row < BOARD_HEIGHT; row++) {
-        for (int col = 0; col < BOARD_WIDTH; col++) {
+    for (int row = 0; row < game->size; row++) {
+        for (int col = 0; col < game->size; col++) {
             board_string[index++] = game->board[row][col];
         }
     }
-    board_string[BOARD_SIZE] = '\0';
+    board_string[index] = '\0';
     
-    snprintf(message, sizeof(message), "%s%s%s%s",
-             MESSAGE_BOARD, PROTOCOL_DELIMITER, board_string, PROTOCOL_TERMINATOR);
-    return send_message(socket_fd, message, strlen(message));
+    int written = snprintf(buffer, buffer_size, "%s%s%d%s%d%s%s%s",
+                           MESSAGE_BOARD, PROTOCOL_DELIMITER, game->size, PROTOCOL_DELIMITER,
+                           game->size, PROTOCOL_DELIMITER, board_string, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
+}
+
+ssize_t send_board_message(int socket_fd, const GameState *game) {
+    char message[MAX_MESSAGE_LENGTH];
+    size_t length = format_board_message(message, sizeof(message), game);
+    return send_message(socket_fd, message, length);
+}
+
+size_t format_your_turn_message(char *buffer, size_t buffer_size) {
+    int written = snprintf(buffer, buffer_size, "%s%s", MESSAGE_YOUR_TURN, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
 }
 
 ssize_t send_your_turn_message(int socket_fd) {
     char message[MAX_MESSAGE_LENGTH];
-    snprintf(message, sizeof(message), "%s%s", MESSAGE_YOUR_TURN, PROTOCOL_TERMINATOR);
-    return send_message(socket_fd, message, strlen(message));
+    size_t length = format_your_turn_message(message, sizeof(message));
+    return send_message(socket_fd, message, length);
+}
+
+size_t format_opponent_turn_message(char *buffer, size_t buffer_size) {
+    int written = snprintf(buffer, buffer_size, "%s%s", MESSAGE_OPPONENT_TURN, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
 }
 
 ssize_t send_opponent_turn_message(int socket_fd) {
     char message[MAX_MESSAGE_LENGTH];
-    snprintf(message, sizeof(message), "%s%s", MESSAGE_OPPONENT_TURN, PROTOCOL_TERMINATOR);
-    return send_message(socket_fd, message, strlen(message));
+    size_t length = format_opponent_turn_message(message, sizeof(message));
+    return send_message(socket_fd, message, length);
+}
+
+size_t format_valid_message(char *buffer, size_t buffer_size) {
+    int written = snprintf(buffer, buffer_size, "%s%s", MESSAGE_VALID, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
 }
 
 ssize_t send_valid_message(int socket_fd) {
     char message[MAX_MESSAGE_LENGTH];
-    snprintf(message, sizeof(message), "%s%s", MESSAGE_VALID, PROTOCOL_TERMINATOR);
-    return send_message(socket_fd, message, strlen(message));
+    size_t length = format_valid_message(message, sizeof(message));
+    return send_message(socket_fd, message, length);
+}
+
+size_t format_invalid_message(char *buffer, size_t buffer_size, const char *reason) {
+    int written = snprintf(buffer, buffer_size, "%s%s%s%s",
+                           MESSAGE_INVALID, PROTOCOL_DELIMITER, reason, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
 }
 
 ssize_t send_invalid_message(int socket_fd, const char *reason) {
+    metrics_record_invalid_move(reason);
     char message[MAX_MESSAGE_LENGTH];
-    snprintf(message, sizeof(message), "%s%s%s%s",
-             MESSAGE_INVALID, PROTOCOL_DELIMITER, reason, PROTOCOL_TERMINATOR);
-    return send_message(socket_fd, message, strlen(message));
+    size_t length = format_invalid_message(message, sizeof(message), reason);
+    return send_message(socket_fd, message, length);
+}
+
+size_t format_opponent_move_message(char *buffer, size_t buffer_size, int row, int col) {
+    int written = snprintf(buffer, buffer_size, "%s%s%d%s%d%s",
+                           MESSAGE_OPPONENT_MOVE, PROTOCOL_DELIMITER, row, PROTOCOL_DELIMITER, col, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
 }
 
 ssize_t send_opponent_move_message(int socket_fd, int row, int col) {
     char message[MAX_MESSAGE_LENGTH];
-    snprintf(message, sizeof(message), "%s%s%d%s%d%s",
-             MESSAGE_OPPONENT_MOVE, PROTOCOL_DELIMITER, row, PROTOCOL_DELIMITER, col, PROTOCOL_TERMINATOR);
-    return send_message(socket_fd, message, strlen(message));
+    size_t length = format_opponent_move_message(message, sizeof(message), row, col);
+    return send_message(socket_fd, message, length);
+}
+
+size_t format_opponent_pass_message(char *buffer, size_t buffer_size) {
+    int written = snprintf(buffer, buffer_size, "%s%s", MESSAGE_OPPONENT_PASS, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
 }
 
 ssize_t send_opponent_pass_message(int socket_fd) {
     char message[MAX_MESSAGE_LENGTH];
-    snprintf(message, sizeof(message), "%s%s", MESSAGE_OPPONENT_PASS, PROTOCOL_TERMINATOR);
-    return send_message(socket_fd, message, strlen(message));
+    size_t length = format_opponent_pass_message(message, sizeof(message));
+    return send_message(socket_fd, message, length);
+}
+
+size_t format_game_over_message(char *buffer, size_t buffer_size, const char *result, const char *winner_color,
+                                int black_count, int white_count) {
+    int written = snprintf(buffer, buffer_size, "%s%s%s%s%s%s%d%s%d%s",
+                           MESSAGE_GAME_OVER, PROTOCOL_DELIMITER, result, PROTOCOL_DELIMITER, winner_color,
+                           PROTOCOL_DELIMITER, black_count, PROTOCOL_DELIMITER, white_count, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
 }
 
 ssize_t send_game_over_message(int socket_fd, const char *result, const char *winner_color, int black_count, int white_count) {
     char message[MAX_MESSAGE_LENGTH];
-    snprintf(message, sizeof(message), "%s%s%s%s%s%s%d%s%d%s",
-             MESSAGE_GAME_OVER, PROTOCOL_DELIMITER, result, PROTOCOL_DELIMITER, winner_color,
-             PROTOCOL_DELIMITER, black_count, PROTOCOL_DELIMITER, white_count, PROTOCOL_TERMINATOR);
-    return send_message(socket_fd, message, strlen(message));
+    size_t length = format_game_over_message(message, sizeof(message), result, winner_color, black_count, white_count);
+    return send_message(socket_fd, message, length);
+}
+
+size_t format_opponent_left_message(char *buffer, size_t buffer_size) {
+    int written = snprintf(buffer, buffer_size, "%s%s", MESSAGE_OPPONENT_LEFT, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
 }
 
 ssize_t send_opponent_left_message(int socket_fd) {
     char message[MAX_MESSAGE_LENGTH];
-    snprintf(message, sizeof(message), "%s%s", MESSAGE_OPPONENT_LEFT, PROTOCOL_TERMINATOR);
-    return send_message(socket_fd, message, strlen(message));
+    size_t length = format_opponent_left_message(message, sizeof(message));
+    return send_message(socket_fd, message, length);
 }
 
-int parse_move_message(const char *message, int *row, int *col) {
-    char command[32];
-    if (sscanf(message, "%[^|]|%d|%d", command, row, col) == 3) {
-        if (strcasecmp(command, MESSAGE_MOVE) == 0) {
-            return 1;
-        }
-    }
-    return 0;
+size_t format_round_message(char *buffer, size_t buffer_size, int round, int total_rounds) {
+    int written = snprintf(buffer, buffer_size, "%s%s%d%s%d%s",
+                           MESSAGE_ROUND, PROTOCOL_DELIMITER, round, PROTOCOL_DELIMITER, total_rounds, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
 }
 
-int is_pass_message(const char *message) {
-    char trimmed[MAX_MESSAGE_LENGTH];
-    int i = 0;
-    while (message[i] && !isspace((unsigned char)message[i]) && i < MAX_MESSAGE_LENGTH - 1) {
-        trimmed[i] = message[i];
-        i++;
-    }
-    trimmed[i] = '\0';
-    return strcasecmp(trimmed, MESSAGE_PASS) == 0;
+ssize_t send_round_message(int socket_fd, int round, int total_rounds) {
+    char message[MAX_MESSAGE_LENGTH];
+    size_t length = format_round_message(message, sizeof(message), round, total_rounds);
+    return send_message(socket_fd, message, length);
 }
 
-int is_quit_message(const char *message) {
-    char trimmed[MAX_MESSAGE_LENGTH];
-    int i = 0;
-    while (message[i] && !isspace((unsigned char)message[i]) && i < MAX_MESSAGE_LENGTH - 1) {
-        trimmed[i] = message[i];
-        i++;
-    }
-    trimmed[i] = '\0';
-    return strcasecmp(trimmed, MESSAGE_QUIT) == 0;
+size_t format_bye_message(char *buffer, size_t buffer_size) {
+    int written = snprintf(buffer, buffer_size, "%s%s", MESSAGE_BYE, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
+}
+
+ssize_t send_bye_message(int socket_fd) {
+    char message[MAX_MESSAGE_LENGTH];
+    size_t length = format_bye_message(message, sizeof(message));
+    return send_message(socket_fd, message, length);
+}
+
+size_t format_tournament_over_message(char *buffer, size_t buffer_size, int rank, int entrants, const char *score) {
+    int written = snprintf(buffer, buffer_size, "%s%s%d%s%d%s%s%s",
+                           MESSAGE_TOURNAMENT_OVER, PROTOCOL_DELIMITER, rank, PROTOCOL_DELIMITER, entrants,
+                           PROTOCOL_DELIMITER, score, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
+}
+
+ssize_t send_tournament_over_message(int socket_fd, int rank, int entrants, const char *score) {
+    char message[MAX_MESSAGE_LENGTH];
+    size_t length = format_tournament_over_message(message, sizeof(message), rank, entrants, score);
+    return send_message(socket_fd, message, length);
+}
+
+size_t format_rank_message(char *buffer, size_t buffer_size, const LeaderboardEntry *entry, int players) {
+    int written = snprintf(buffer, buffer_size, "%s%s%s%s%d%s%.0f%s%d%s%d%s%d%s%d%s",
+                           MESSAGE_RANK, PROTOCOL_DELIMITER, entry->name, PROTOCOL_DELIMITER, entry->rank,
+                           PROTOCOL_DELIMITER, entry->rating, PROTOCOL_DELIMITER, entry->wins,
+                           PROTOCOL_DELIMITER, entry->losses, PROTOCOL_DELIMITER, entry->draws,
+                           PROTOCOL_DELIMITER, players, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
+}
+
+ssize_t send_rank_message(int socket_fd, const LeaderboardEntry *entry, int players) {
+    char message[MAX_MESSAGE_LENGTH];
+    size_t length = format_rank_message(message, sizeof(message), entry, players);
+    return send_message(socket_fd, message, length);
+}
+
+size_t format_undo_request_message(char *buffer, size_t buffer_size) {
+    int written = snprintf(buffer, buffer_size, "%s%s", MESSAGE_UNDO, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
+}
+
+ssize_t send_undo_request_message(int socket_fd) {
+    char message[MAX_MESSAGE_LENGTH];
+    size_t length = format_undo_request_message(message, sizeof(message));
+    return send_message(socket_fd, message, length);
+}
+
+size_t format_undo_answer_message(char *buffer, size_t buffer_size, int accepted) {
+    int written = snprintf(buffer, buffer_size, "%s%s",
+                           accepted ? MESSAGE_UNDO_ACCEPT : MESSAGE_UNDO_DECLINE, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
+}
+
+ssize_t send_undo_answer_message(int socket_fd, int accepted) {
+    char message[MAX_MESSAGE_LENGTH];
+    size_t length = format_undo_answer_message(message, sizeof(message), accepted);
+    return send_message(socket_fd, message, length);
+}
+
+size_t format_rematch_offer_message(char *buffer, size_t buffer_size) {
+    int written = snprintf(buffer, buffer_size, "%s%s", MESSAGE_REMATCH, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
+}
+
+ssize_t send_rematch_message(int socket_fd) {
+    char message[MAX_MESSAGE_LENGTH];
+    size_t length = format_rematch_offer_message(message, sizeof(message));
+    return send_message(socket_fd, message, length);
+}
+
+size_t format_ping_message(char *buffer, size_t buffer_size, uint64_t timestamp_ns) {
+    int written = snprintf(buffer, buffer_size, "%s%s%llu%s", MESSAGE_PING, PROTOCOL_DELIMITER,
+                           (unsigned long long)timestamp_ns, PROTOCOL_TERMINATOR);
+    return clamp_formatted_length(written, buffer_size);
+}
+
+ssize_t send_ping_message(int socket_fd, uint64_t timestamp_ns) {
+    char message[MAX_MESSAGE_LENGTH];
+    size_t length = format_ping_message(message, sizeof(message), timestamp_ns);
+    return send_message(socket_fd, message, length);
 }
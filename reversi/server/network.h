@@ -2,14 +2,45 @@
 #define NETWORK_H
 
 #include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
 #include "game.h"
+#include "leaderboard.h"
 
+typedef ssize_t (*MessageSender)(int socket_fd, const char *message, size_t message_length);
+
+void set_message_sender(MessageSender sender);
 void handle_client_connection(int client_socket);
 ssize_t receive_message(int socket_fd, char *buffer, size_t buffer_size);
 ssize_t send_message(int socket_fd, const char *message, size_t message_length);
+
+size_t format_wait_message(char *buffer, size_t buffer_size);
+size_t format_welcome_message(char *buffer, size_t buffer_size, const char *color);
+size_t format_start_message(char *buffer, size_t buffer_size);
+size_t format_error_message(char *buffer, size_t buffer_size, const char *reason);
+size_t format_board_message(char *buffer, size_t buffer_size, const GameState *game);
+size_t format_your_turn_message(char *buffer, size_t buffer_size);
+size_t format_opponent_turn_message(char *buffer, size_t buffer_size);
+size_t format_valid_message(char *buffer, size_t buffer_size);
+size_t format_invalid_message(char *buffer, size_t buffer_size, const char *reason);
+size_t format_opponent_move_message(char *buffer, size_t buffer_size, int row, int col);
+size_t format_opponent_pass_message(char *buffer, size_t buffer_size);
+size_t format_game_over_message(char *buffer, size_t buffer_size, const char *result, const char *winner_color,
+                                int black_count, int white_count);
+size_t format_opponent_left_message(char *buffer, size_t buffer_size);
+size_t format_round_message(char *buffer, size_t buffer_size, int round, int total_rounds);
+size_t format_bye_message(char *buffer, size_t buffer_size);
+size_t format_tournament_over_message(char *buffer, size_t buffer_size, int rank, int entrants, const char *score);
+size_t format_rank_message(char *buffer, size_t buffer_size, const LeaderboardEntry *entry, int players);
+size_t format_undo_request_message(char *buffer, size_t buffer_size);
+size_t format_undo_answer_message(char *buffer, size_t buffer_size, int accepted);
+size_t format_rematch_offer_message(char *buffer, size_t buffer_size);
+size_t format_ping_message(char *buffer, size_t buffer_size, uint64_t timestamp_ns);
+
 ssize_t send_wait_message(int socket_fd);
 ssize_t send_welcome_message(int socket_fd, const char *color);
 ssize_t send_start_message(int socket_fd);
+ssize_t send_error_message(int socket_fd, const char *reason);
 
 ssize_t send_board_message(int socket_fd, const GameState *game);
 ssize_t send_your_turn_message(int socket_fd);
@@ -20,9 +51,13 @@ ssize_t send_opponent_move_message(int socket_fd, int row, int col);
 ssize_t send_opponent_pass_message(int socket_fd);
 ssize_t send_game_over_message(int socket_fd, const char *result, const char *winner_color, int black_count, int white_count);
 ssize_t send_opponent_left_message(int socket_fd);
-
-int parse_move_message(const char *message, int *row, int *col);
-int is_pass_message(const char *message);
-int is_quit_message(const char *message);
+ssize_t send_round_message(int socket_fd, int round, int total_rounds);
+ssize_t send_bye_message(int socket_fd);
+ssize_t send_tournament_over_message(int socket_fd, int rank, int entrants, const char *score);
+ssize_t send_rank_message(int socket_fd, const LeaderboardEntry *entry, int players);
+ssize_t send_undo_request_message(int socket_fd);
+ssize_t send_undo_answer_message(int socket_fd, int accepted);
+ssize_t send_rematch_message(int socket_fd);
+ssize_t send_ping_message(int socket_fd, uint64_t timestamp_ns);
 
 #endif
@@ -0,0 +1,236 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "restart.h"
+#include "matchmaking.h"
+#include "log.h"
+
+static char **saved_argv = NULL;
+static volatile sig_atomic_t restart_flag = 0;
+static volatile pid_t replacement_pid = -1;
+static int inherited_waiting_start = -1;
+static int inherited_waiting_count = 0;
+static int inherited_ready_fd = -1;
+
+void remember_command_line(char **argv) {
+    saved_argv = argv;
+}
+
+void handle_restart_signal(int signal) {
+    (void)signal;
+    restart_flag = 1;
+}
+
+int restart_requested(void) {
+    if (restart_flag) {
+        restart_flag = 0;
+        return 1;
+    }
+    return 0;
+}
+
+int restart_pending(void) {
+    return restart_flag;
+}
+
+pid_t replacement_process_id(void) {
+    return replacement_pid;
+}
+
+static int read_environment_int(const char *name, int fallback) {
+    const char *value = getenv(name);
+    if (value == NULL || *value == '\0') {
+        return fallback;
+    }
+
+    char *endptr;
+    long number = strtol(value, &endptr, 10);
+    if (*endptr != '\0' || number < 0 || number > 65535) {
+        return fallback;
+    }
+    return (int)number;
+}
+
+int inherit_listening_sockets(server_config *config) {
+    const char *listen_pid = getenv("LISTEN_PID");
+    int listen_fds = read_environment_int("LISTEN_FDS", 0);
+
+    if (listen_pid == NULL || strtol(listen_pid, NULL, 10) != (long)getpid() || listen_fds <= 0) {
+        return 0;
+    }
+
+    const char *names = getenv("LISTEN_FDNAMES");
+    config->socket_fd = LISTEN_FDS_START;
+    config->admin_socket_fd = (listen_fds > 1 && names == NULL) ? LISTEN_FDS_START + 1 : -1;
+    config->unix_socket_fd = -1;
+
+    for (int i = 0; names != NULL && i < listen_fds; i++) {
+        size_t length = strcspn(names, ":");
+        if (length == 5 && strncmp(names, "admin", length) == 0) {
+            config->admin_socket_fd = LISTEN_FDS_START + i;
+        } else if (length == 4 && strncmp(names, "unix", length) == 0) {
+            config->unix_socket_fd = LISTEN_FDS_START + i;
+        }
+        names = (names[length] == ':') ? names + length + 1 : NULL;
+    }
+
+    inherited_waiting_count = read_environment_int("REVERSI_WAITING_FDS", 0);
+    inherited_waiting_start = LISTEN_FDS_START + listen_fds;
+    inherited_ready_fd = read_environment_int("REVERSI_READY_FD", -1);
+
+    for (int fd = LISTEN_FDS_START; fd < inherited_waiting_start + inherited_waiting_count; fd++) {
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    if (inherited_ready_fd >= 0) {
+        fcntl(inherited_ready_fd, F_SETFD, FD_CLOEXEC);
+    }
+
+    unsetenv("LISTEN_PID");
+    unsetenv("LISTEN_FDS");
+    unsetenv("LISTEN_FDNAMES");
+    unsetenv("REVERSI_WAITING_FDS");
+    unsetenv("REVERSI_READY_FD");
+    return 1;
+}
+
+void adopt_inherited_players(void) {
+    for (int i = 0; i < inherited_waiting_count; i++) {
+        adopt_waiting_player(inherited_waiting_start + i);
+    }
+    if (inherited_waiting_count > 0) {
+        LOG_INFO("inherited_waiting_players", LOG_INT("count", inherited_waiting_count));
+    }
+    inherited_waiting_count = 0;
+}
+
+void notify_replacement_ready(void) {
+    if (inherited_ready_fd < 0) {
+        return;
+    }
+
+    char ready = 1;
+    ssize_t bytes_written;
+    do {
+        bytes_written = write(inherited_ready_fd, &ready, 1);
+    } while (bytes_written < 0 && errno == EINTR);
+
+    close(inherited_ready_fd);
+    inherited_ready_fd = -1;
+}
+
+static void exec_replacement(const int *handoff_fds, int listen_count, const char *listen_names, int waiting_count,
+                             int ready_fd) {
+    int total = listen_count + waiting_count + 1;
+    int staged[MAX_HANDOFF_SOCKETS + 4];
+    int staging_base = LISTEN_FDS_START + total;
+
+    for (int i = 0; i < total; i++) {
+        int source = (i < total - 1) ? handoff_fds[i] : ready_fd;
+        staged[i] = fcntl(source, F_DUPFD, staging_base);
+        if (staged[i] < 0) {
+            _exit(127);
+        }
+    }
+
+    for (int i = 0; i < total; i++) {
+        if (dup2(staged[i], LISTEN_FDS_START + i) < 0) {
+            _exit(127);
+        }
+        close(staged[i]);
+    }
+    close_range(LISTEN_FDS_START + total, ~0U, 0);
+
+    char value[32];
+    snprintf(value, sizeof(value), "%d", (int)getpid());
+    setenv("LISTEN_PID", value, 1);
+    snprintf(value, sizeof(value), "%d", listen_count);
+    setenv("LISTEN_FDS", value, 1);
+    setenv("LISTEN_FDNAMES", listen_names, 1);
+    snprintf(value, sizeof(value), "%d", waiting_count);
+    setenv("REVERSI_WAITING_FDS", value, 1);
+    snprintf(value, sizeof(value), "%d", LISTEN_FDS_START + total - 1);
+    setenv("REVERSI_READY_FD", value, 1);
+
+    execvp(saved_argv[0], saved_argv);
+    _exit(127);
+}
+
+static int wait_for_replacement(int ready_fd) {
+    struct pollfd ready_poll = { .fd = ready_fd, .events = POLLIN };
+    int remaining_ms = RESTART_READY_TIMEOUT_MS;
+
+    while (remaining_ms > 0) {
+        int result = poll(&ready_poll, 1, 100);
+        if (result < 0 && errno != EINTR) {
+            return -1;
+        }
+        if (result > 0) {
+            char ready;
+            return read(ready_fd, &ready, 1) == 1 ? 0 : -1;
+        }
+        remaining_ms -= 100;
+    }
+    return -1;
+}
+
+int hand_off_to_replacement(const server_config *config) {
+    if (saved_argv == NULL) {
+        return -1;
+    }
+
+    int handoff_fds[MAX_HANDOFF_SOCKETS + 3];
+    char listen_names[32] = "game";
+    int listen_count = 0;
+
+    handoff_fds[listen_count++] = config->socket_fd;
+    if (config->admin_socket_fd >= 0) {
+        handoff_fds[listen_count++] = config->admin_socket_fd;
+        strcat(listen_names, ":admin");
+    }
+    if (config->unix_socket_fd >= 0) {
+        handoff_fds[listen_count++] = config->unix_socket_fd;
+        strcat(listen_names, ":unix");
+    }
+
+    int waiting_count = get_waiting_player_sockets(handoff_fds + listen_count, MAX_HANDOFF_SOCKETS);
+
+    int ready_pipe[2];
+    if (pipe(ready_pipe) < 0) {
+        LOG_ERROR("restart_pipe_failed", LOG_INT("errno", errno));
+        return -1;
+    }
+
+    pid_t child_process_id = fork();
+    if (child_process_id < 0) {
+        LOG_ERROR("restart_fork_failed", LOG_INT("errno", errno));
+        close(ready_pipe[0]);
+        close(ready_pipe[1]);
+        return -1;
+    }
+
+    if (child_process_id == 0) {
+        close(ready_pipe[0]);
+        exec_replacement(handoff_fds, listen_count, listen_names, waiting_count, ready_pipe[1]);
+    }
+
+    replacement_pid = child_process_id;
+    close(ready_pipe[1]);
+    int result = wait_for_replacement(ready_pipe[0]);
+    close(ready_pipe[0]);
+
+    if (result < 0) {
+        LOG_ERROR("restart_replacement_failed", LOG_INT("pid", child_process_id));
+        kill(child_process_id, SIGKILL);
+        return -1;
+    }
+
+    LOG_INFO("restart_handed_off", LOG_INT("pid", child_process_id),
+             LOG_INT("listeners", listen_count), LOG_INT("waiting_players", waiting_count));
+    return 0;
+}
@@ -0,0 +1,22 @@
+#ifndef RESTART_H
+#define RESTART_H
+
+#include <sys/types.h>
+#include "server.h"
+
+#define LISTEN_FDS_START 3
+#define RESTART_READY_TIMEOUT_MS 5000
+#define RESTART_DRAIN_POLL_MS 1000
+#define MAX_HANDOFF_SOCKETS 256
+
+void remember_command_line(char **argv);
+int inherit_listening_sockets(server_config *config);
+void adopt_inherited_players(void);
+void notify_replacement_ready(void);
+int hand_off_to_replacement(const server_config *config);
+pid_t replacement_process_id(void);
+void handle_restart_signal(int signal);
+int restart_requested(void);
+int restart_pending(void);
+
+#endif
@@ -0,0 +1,77 @@
+#include <stdio.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include "results.h"
+#include "log.h"
+
+_Static_assert(sizeof(GameResult) <= PIPE_BUF, "game results must be written atomically");
+
+static int results_pipe[2] = { -1, -1 };
+
+int initialize_results(void) {
+    if (pipe2(results_pipe, O_CLOEXEC) < 0) {
+        perror("results pipe failed");
+        return -1;
+    }
+
+    int flags = fcntl(results_pipe[0], F_GETFL, 0);
+    if (flags < 0 || fcntl(results_pipe[0], F_SETFL, flags | O_NONBLOCK) < 0) {
+        perror("results pipe fcntl failed");
+        return -1;
+    }
+    return 0;
+}
+
+int results_fd(void) {
+    return results_pipe[0];
+}
+
+int results_writer_fd(void) {
+    return results_pipe[1];
+}
+
+void publish_game_result(const GameResult *result) {
+    if (results_pipe[1] < 0) {
+        return;
+    }
+
+    ssize_t bytes_written;
+    do {
+        bytes_written = write(results_pipe[1], result, sizeof(*result));
+    } while (bytes_written < 0 && errno == EINTR);
+
+    if (bytes_written != (ssize_t)sizeof(*result)) {
+        LOG_ERROR("result_write_failed", LOG_INT("game_id", result->game_id), LOG_INT("errno", errno));
+    }
+}
+
+int read_game_result(GameResult *result) {
+    if (results_pipe[0] < 0) {
+        return 0;
+    }
+
+    ssize_t bytes_read;
+    do {
+        bytes_read = read(results_pipe[0], result, sizeof(*result));
+    } while (bytes_read < 0 && errno == EINTR);
+
+    return bytes_read == (ssize_t)sizeof(*result);
+}
+
+int is_valid_player_name(const char *name) {
+    size_t length = 0;
+    if (name == NULL) {
+        return 0;
+    }
+    for (; name[length] != '\0'; length++) {
+        char character = name[length];
+        int allowed = (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z') ||
+                      (character >= '0' && character <= '9') || character == '_' || character == '-';
+        if (!allowed || length + 1 >= PLAYER_NAME_LENGTH) {
+            return 0;
+        }
+    }
+    return length > 0;
+}
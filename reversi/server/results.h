@@ -0,0 +1,35 @@
+#ifndef RESULTS_H
+#define RESULTS_H
+
+#include <stdint.h>
+
+#define PLAYER_NAME_LENGTH 24
+
+typedef enum {
+    GAME_OUTCOME_BLACK_WINS,
+    GAME_OUTCOME_WHITE_WINS,
+    GAME_OUTCOME_DRAW,
+    GAME_OUTCOME_BLACK_LEFT,
+    GAME_OUTCOME_WHITE_LEFT,
+    GAME_OUTCOME_ABORTED
+} GameOutcome;
+
+typedef struct {
+    int32_t game_id;
+    int32_t slot;
+    int32_t worker_pid;
+    int32_t outcome;
+    int32_t black_count;
+    int32_t white_count;
+    char black_name[PLAYER_NAME_LENGTH];
+    char white_name[PLAYER_NAME_LENGTH];
+} GameResult;
+
+int initialize_results(void);
+int results_fd(void);
+int results_writer_fd(void);
+void publish_game_result(const GameResult *result);
+int read_game_result(GameResult *result);
+int is_valid_player_name(const char *name);
+
+#endif
@@ -4,13 +4,25 @@
 #include <stdint.h>
 
 #define BACKLOG_SIZE 10
+#define DEFAULT_LISTEN_BACKLOG 1024
+#define MAX_LISTEN_BACKLOG 65535
+#define ACCEPT_BATCH_SIZE 64
+#define TCP_LISTENER_TOKEN 0
+#define UNIX_LISTENER_TOKEN 1
 
 typedef struct {
     int socket_fd;
     uint16_t port;
+    int unix_socket_fd;
+    const char *unix_socket_path;
+    int admin_socket_fd;
+    uint16_t admin_port;
+    int listen_backlog;
 } server_config;
 
-int create_server_socket(uint16_t port);
-void accept_clients(int server_socket);
+int create_server_socket(uint16_t port, int backlog);
+int create_unix_socket(const char *path, int backlog);
+int create_admin_socket(uint16_t port);
+void accept_clients(const server_config *config);
 
 #endif
@@ -0,0 +1,654 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include "session.h"
+#include "network.h"
+#include "metrics.h"
+#include "log.h"
+#include "gametable.h"
+#include "slab.h"
+#include "trace.h"
+#include "../common/protocol.h"
+#include "../common/message.h"
+
+#define REMATCH_BOTH_PLAYERS ((1 << PLAYER_BLACK) | (1 << PLAYER_WHITE))
+
+static RankQueryHandler rank_query_handler = NULL;
+static Slab game_states;
+static Slab partial_lines;
+
+int initialize_game_states(uint32_t capacity) {
+    slab_destroy(&game_states);
+    slab_destroy(&partial_lines);
+    if (slab_init(&game_states, sizeof(GameState), capacity) < 0) {
+        return -1;
+    }
+    return slab_init(&partial_lines, MAX_MESSAGE_LENGTH, capacity * 2);
+}
+
+void set_rank_query_handler(RankQueryHandler handler) {
+    rank_query_handler = handler;
+}
+
+void answer_rank_query(int socket_fd, const LeaderboardEntry *entry, int players) {
+    if (entry != NULL) {
+        send_rank_message(socket_fd, entry, players);
+    } else {
+        send_error_message(socket_fd, "unknown_player");
+    }
+}
+
+static Player opponent_of(Player player) {
+    return (player == PLAYER_BLACK) ? PLAYER_WHITE : PLAYER_BLACK;
+}
+
+static char *player_name(GameSession *session, Player player) {
+    return (player == PLAYER_BLACK) ? session->result.black_name : session->result.white_name;
+}
+
+static void report_disconnect(int socket_fd, const char *reason) {
+    LOG_INFO("player_disconnected", LOG_INT("fd", socket_fd), LOG_TEXT("reason", reason));
+    metrics_increment(METRIC_DISCONNECTS);
+}
+
+static const char *const OUTCOME_LABELS[] = {
+    [GAME_OUTCOME_BLACK_WINS] = "black_wins", [GAME_OUTCOME_WHITE_WINS] = "white_wins",
+    [GAME_OUTCOME_DRAW] = "draw", [GAME_OUTCOME_BLACK_LEFT] = "black_left",
+    [GAME_OUTCOME_WHITE_LEFT] = "white_left", [GAME_OUTCOME_ABORTED] = "aborted"
+};
+
+static void finish_session(GameSession *session, GameOutcome outcome) {
+    session->result.outcome = outcome;
+    session->finished = 1;
+    trace_instant(TRACE_GAME_FINISHED, OUTCOME_LABELS[outcome], strlen(OUTCOME_LABELS[outcome]));
+    slab_free(&game_states, session->game);
+    session->game = NULL;
+    publish_game_result(&session->result);
+}
+
+static void end_with_departure(GameSession *session, Player departed, const char *reason) {
+    report_disconnect(session->sockets[departed], reason);
+    send_opponent_left_message(session->sockets[opponent_of(departed)]);
+    finish_session(session, departed == PLAYER_BLACK ? GAME_OUTCOME_BLACK_LEFT : GAME_OUTCOME_WHITE_LEFT);
+}
+
+static void advance_session(GameSession *session);
+
+static void cancel_undo_request(GameSession *session) {
+    if (session->undo_requester != NO_UNDO_REQUEST) {
+        send_undo_answer_message(session->sockets[session->undo_requester], 0);
+        session->undo_requester = NO_UNDO_REQUEST;
+    }
+}
+
+static void clear_premoves(GameSession *session) {
+    session->premoves[PLAYER_BLACK] = NO_PREMOVE;
+    session->premoves[PLAYER_WHITE] = NO_PREMOVE;
+}
+
+static void take_back_move(GameSession *session, Player requester) {
+    while (session->game->history_length > 0) {
+        const MoveRecord *last = &session->game->history[session->game->history_length - 1];
+        int requester_move = last->square != MOVE_PASS && last->player == (uint8_t)requester;
+        if (last->square != MOVE_PASS) {
+            session->move_count--;
+        }
+        undo_move(session->game);
+        if (requester_move) {
+            break;
+        }
+    }
+
+    LOG_INFO("move_taken_back", LOG_INT("game_id", session->result.game_id),
+             LOG_INT("move_count", session->move_count));
+    publish_game_state(session->result.slot, session->game, session->move_count);
+    clear_premoves(session);
+    send_undo_answer_message(session->sockets[requester], 1);
+    send_board_message(session->sockets[PLAYER_BLACK], session->game);
+    send_board_message(session->sockets[PLAYER_WHITE], session->game);
+    session->turn_announced = 0;
+    advance_session(session);
+}
+
+static void handle_undo_message(GameSession *session, Player player, MessageType type) {
+    int socket_fd = session->sockets[player];
+
+    if (type == MESSAGE_TYPE_UNDO) {
+        if (!(session->flags & SESSION_ALLOW_TAKEBACKS) || session->undo_requester != NO_UNDO_REQUEST ||
+            count_moves_by(session->game, player) == 0) {
+            send_error_message(socket_fd, "undo_unavailable");
+            return;
+        }
+        session->undo_requester = (int)player;
+        send_undo_request_message(session->sockets[opponent_of(player)]);
+        return;
+    }
+
+    if (session->undo_requester != (int)opponent_of(player)) {
+        send_error_message(socket_fd, "no_undo_request");
+        return;
+    }
+
+    if (type == MESSAGE_TYPE_UNDO_DECLINE) {
+        cancel_undo_request(session);
+        return;
+    }
+
+    session->undo_requester = NO_UNDO_REQUEST;
+    take_back_move(session, opponent_of(player));
+}
+
+static void record_pong(GameSession *session, Player player, const ParsedMessage *message) {
+    const char *stamp = message_field(message, 0);
+    uint64_t now_ns = metrics_now_ns();
+    char *end;
+
+    if (stamp == NULL) {
+        return;
+    }
+    unsigned long long sent_at = strtoull(stamp, &end, 10);
+    if (*end != '\0' || sent_at == 0 || sent_at > now_ns) {
+        return;
+    }
+
+    session->rtt_ns[player] = now_ns - sent_at;
+    metrics_record_latency(METRIC_PEER_RTT, session->rtt_ns[player]);
+    if (!session->finished) {
+        publish_player_rtt(session->result.slot, player, session->rtt_ns[player]);
+    }
+}
+
+static int handle_player_request(GameSession *session, Player player, const ParsedMessage *message) {
+    int socket_fd = session->sockets[player];
+    char *own_name = player_name(session, player);
+    const char *name = message_field(message, 0);
+
+    if (message->type == MESSAGE_TYPE_PONG) {
+        record_pong(session, player, message);
+        return 1;
+    }
+
+    if (message->type == MESSAGE_TYPE_NAME) {
+        if (name == NULL || !is_valid_player_name(name)) {
+            send_error_message(socket_fd, "invalid_name");
+        } else if (own_name[0] == '\0') {
+            snprintf(own_name, PLAYER_NAME_LENGTH, "%s", name);
+        } else if (strcmp(own_name, name) != 0) {
+            send_error_message(socket_fd, "name_already_set");
+        }
+        return 1;
+    }
+
+    if (message->type == MESSAGE_TYPE_RANK) {
+        if (name == NULL || name[0] == '\0') {
+            name = own_name;
+        }
+        if (rank_query_handler != NULL) {
+            rank_query_handler(session, player, name);
+        } else {
+            LeaderboardEntry entry;
+            int found = leaderboard_lookup(name, &entry) == 0;
+            answer_rank_query(socket_fd, found ? &entry : NULL, leaderboard_size());
+        }
+        return 1;
+    }
+
+    if (message->type == MESSAGE_TYPE_UNDO || message->type == MESSAGE_TYPE_UNDO_ACCEPT ||
+        message->type == MESSAGE_TYPE_UNDO_DECLINE) {
+        handle_undo_message(session, player, message->type);
+        return 1;
+    }
+
+    if (message->type == MESSAGE_TYPE_PREMOVE && player != session->game->current_player) {
+        int row, col;
+        if (parse_message_coordinates(message, &row, &col) < 0 || row < 0 || row >= session->game->size ||
+            col < 0 || col >= session->game->size) {
+            send_error_message(socket_fd, "invalid_premove");
+        } else {
+            session->premoves[player] = row * BOARD_MAX_SIZE + col;
+        }
+        return 1;
+    }
+
+    return 0;
+}
+
+static char *next_message_line(char **cursor) {
+    while (**cursor != '\0') {
+        char *line = *cursor;
+        char *line_end = strchr(line, '\n');
+        if (line_end != NULL) {
+            *line_end = '\0';
+            *cursor = line_end + 1;
+        } else {
+            *cursor = line + strlen(line);
+        }
+
+        if (line[0] != '\0' && line[0] != '\r') {
+            return line;
+        }
+    }
+    return NULL;
+}
+
+static int next_game_message(GameSession *session, Player player, char **cursor, ParsedMessage *message) {
+    char *line;
+    while (!session->finished && (line = next_message_line(cursor)) != NULL) {
+        tokenize_message(line, message);
+        trace_instant(TRACE_MESSAGE_RECEIVED, message->opcode, message->opcode_length);
+        if (!handle_player_request(session, player, message)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void finish_completed_game(GameSession *session) {
+    int black_count, white_count;
+    count_pieces(session->game, &black_count, &white_count);
+    session->result.black_count = black_count;
+    session->result.white_count = white_count;
+    GameStatus status = determine_winner(session->game);
+
+    const char *result;
+    const char *winner_color;
+
+    if (status == GAME_STATUS_BLACK_WINS) {
+        result = "WIN";
+        winner_color = COLOR_BLACK;
+    } else if (status == GAME_STATUS_WHITE_WINS) {
+        result = "WIN";
+        winner_color = COLOR_WHITE;
+    } else {
+        result = "DRAW";
+        winner_color = "NONE";
+    }
+
+    send_game_over_message(session->sockets[PLAYER_BLACK], result, winner_color, black_count, white_count);
+    send_game_over_message(session->sockets[PLAYER_WHITE], result, winner_color, black_count, white_count);
+    metrics_increment(METRIC_GAMES_FINISHED);
+    LOG_INFO("game_over", LOG_INT("game_id", session->result.game_id), LOG_TEXT("winner", winner_color),
+             LOG_INT("black_count", black_count), LOG_INT("white_count", white_count));
+
+    if (status == GAME_STATUS_BLACK_WINS) {
+        finish_session(session, GAME_OUTCOME_BLACK_WINS);
+    } else if (status == GAME_STATUS_WHITE_WINS) {
+        finish_session(session, GAME_OUTCOME_WHITE_WINS);
+    } else {
+        finish_session(session, GAME_OUTCOME_DRAW);
+    }
+
+    if (session->flags & SESSION_ALLOW_REMATCH) {
+        session->rematch_deadline_ns = metrics_now_ns() + (uint64_t)REMATCH_WINDOW_SECONDS * 1000000000ULL;
+    }
+}
+
+static int apply_move(GameSession *session, int row, int col, uint64_t received_at);
+
+static int play_premove(GameSession *session, Player player) {
+    int square = session->premoves[player];
+    session->premoves[player] = NO_PREMOVE;
+    if (square == NO_PREMOVE) {
+        return 0;
+    }
+    if (!apply_move(session, square / BOARD_MAX_SIZE, square % BOARD_MAX_SIZE, metrics_now_ns())) {
+        return 0;
+    }
+    metrics_increment(METRIC_PREMOVES_APPLIED);
+    return 1;
+}
+
+static void advance_session(GameSession *session) {
+    while (!is_game_over(session->game)) {
+        Player current = session->game->current_player;
+        Player opponent = opponent_of(current);
+
+        TraceSpan legal_span = trace_begin(TRACE_LEGAL_MOVES);
+        int can_move = has_legal_moves(session->game, current);
+        const char *legal_label = can_move ? "has_moves" : "no_moves";
+        trace_end(&legal_span, legal_label, strlen(legal_label));
+        if (!can_move) {
+            if (send_opponent_pass_message(session->sockets[opponent]) < 0) {
+                end_with_departure(session, opponent, "send_failed");
+                return;
+            }
+            session->premoves[current] = NO_PREMOVE;
+            pass_turn(session->game);
+            publish_game_state(session->result.slot, session->game, session->move_count);
+            session->turn_announced = 0;
+            continue;
+        }
+
+        if (!session->turn_announced) {
+            if (play_premove(session, current)) {
+                return;
+            }
+            send_your_turn_message(session->sockets[current]);
+            if (send_opponent_turn_message(session->sockets[opponent]) < 0) {
+                end_with_departure(session, opponent, "send_failed");
+                return;
+            }
+            session->turn_announced = 1;
+        }
+        return;
+    }
+
+    finish_completed_game(session);
+}
+
+static int apply_move(GameSession *session, int row, int col, uint64_t received_at) {
+    Player current = session->game->current_player;
+    int current_socket = session->sockets[current];
+
+    if (row < 0 || row >= session->game->size || col < 0 || col >= session->game->size) {
+        send_invalid_message(current_socket, "out_of_bounds");
+        return 0;
+    }
+
+    if (session->game->board[row][col] != CELL_EMPTY) {
+        send_invalid_message(current_socket, "occupied");
+        return 0;
+    }
+
+    TraceSpan move_span = trace_begin(TRACE_EXECUTE_MOVE);
+    int applied = is_valid_move(session->game, row, col) && execute_move(session->game, row, col);
+    const char *move_label = applied ? "applied" : "no_flip";
+    trace_end(&move_span, move_label, strlen(move_label));
+    if (!applied) {
+        send_invalid_message(current_socket, "no_flip");
+        return 0;
+    }
+
+    cancel_undo_request(session);
+    publish_game_state(session->result.slot, session->game, ++session->move_count);
+    send_valid_message(current_socket);
+    if (send_opponent_move_message(session->sockets[opponent_of(current)], row, col) < 0) {
+        end_with_departure(session, opponent_of(current), "send_failed");
+        return 1;
+    }
+    if (send_board_message(session->sockets[PLAYER_BLACK], session->game) < 0) {
+        end_with_departure(session, PLAYER_BLACK, "send_failed");
+        return 1;
+    }
+    if (send_board_message(session->sockets[PLAYER_WHITE], session->game) < 0) {
+        end_with_departure(session, PLAYER_WHITE, "send_failed");
+        return 1;
+    }
+    metrics_increment(METRIC_MOVES_APPLIED);
+    metrics_record_latency(METRIC_MOVE_LATENCY, metrics_now_ns() - received_at);
+    session->turn_announced = 0;
+    advance_session(session);
+    return 1;
+}
+
+static void apply_game_message(GameSession *session, const ParsedMessage *message, uint64_t received_at) {
+    Player current = session->game->current_player;
+    int current_socket = session->sockets[current];
+    int row, col;
+
+    if (message->type == MESSAGE_TYPE_QUIT) {
+        end_with_departure(session, current, "quit");
+        return;
+    }
+
+    if (message->type == MESSAGE_TYPE_PASS) {
+        if (has_legal_moves(session->game, current)) {
+            send_invalid_message(current_socket, "has_legal_moves");
+            return;
+        }
+        cancel_undo_request(session);
+        send_valid_message(current_socket);
+        if (send_opponent_pass_message(session->sockets[opponent_of(current)]) < 0) {
+            end_with_departure(session, opponent_of(current), "send_failed");
+            return;
+        }
+        pass_turn(session->game);
+        publish_game_state(session->result.slot, session->game, session->move_count);
+        session->turn_announced = 0;
+        advance_session(session);
+        return;
+    }
+
+    if ((message->type == MESSAGE_TYPE_MOVE || message->type == MESSAGE_TYPE_PREMOVE) &&
+        parse_message_coordinates(message, &row, &col) == 0) {
+        apply_move(session, row, col, received_at);
+    } else {
+        send_invalid_message(current_socket, "unknown_command");
+    }
+}
+
+void start_game_session(GameSession *session, int game_id, int slot, pid_t worker_pid, int flags,
+                        int board_size, int black_socket, int white_socket) {
+    trace_set_game(game_id);
+    trace_instant(TRACE_GAME_STARTED, NULL, 0);
+    memset(session, 0, sizeof(*session));
+    session->flags = flags;
+    session->board_size = board_size;
+    session->undo_requester = NO_UNDO_REQUEST;
+    clear_premoves(session);
+    session->sockets[PLAYER_BLACK] = black_socket;
+    session->sockets[PLAYER_WHITE] = white_socket;
+    session->last_heard_ns[PLAYER_BLACK] = metrics_now_ns();
+    session->last_heard_ns[PLAYER_WHITE] = session->last_heard_ns[PLAYER_BLACK];
+    session->result.game_id = game_id;
+    session->result.slot = slot;
+    session->result.worker_pid = worker_pid;
+
+    if ((session->game = slab_alloc(&game_states)) == NULL) {
+        send_error_message(black_socket, "server_busy");
+        send_error_message(white_socket, "server_busy");
+        finish_session(session, GAME_OUTCOME_ABORTED);
+        trace_set_game(0);
+        return;
+    }
+
+    char *test_mode = getenv("REVERSI_TEST_MODE");
+    if (test_mode != NULL && strcmp(test_mode, "1") == 0) {
+        initialize_test_game(session->game);
+    } else {
+        initialize_sized_game(session->game, board_size);
+    }
+
+    publish_game_state(slot, session->game, 0);
+    send_board_message(black_socket, session->game);
+    send_board_message(white_socket, session->game);
+    advance_session(session);
+    trace_set_game(0);
+}
+
+void restart_game_session(GameSession *session, int game_id, int slot) {
+    int black_socket = session->sockets[PLAYER_WHITE];
+    int white_socket = session->sockets[PLAYER_BLACK];
+    int swapped = !session->swapped;
+    GameResult previous = session->result;
+    uint64_t rtt_ns[2] = { session->rtt_ns[PLAYER_WHITE], session->rtt_ns[PLAYER_BLACK] };
+    char *held_lines[2] = { session->partial_lines[PLAYER_WHITE], session->partial_lines[PLAYER_BLACK] };
+
+    send_welcome_message(black_socket, COLOR_BLACK);
+    send_welcome_message(white_socket, COLOR_WHITE);
+    send_start_message(black_socket);
+    send_start_message(white_socket);
+    start_game_session(session, game_id, slot, previous.worker_pid, session->flags, session->board_size,
+                       black_socket, white_socket);
+    session->swapped = swapped;
+    memcpy(session->result.black_name, previous.white_name, sizeof(session->result.black_name));
+    memcpy(session->result.white_name, previous.black_name, sizeof(session->result.white_name));
+    memcpy(session->rtt_ns, rtt_ns, sizeof(session->rtt_ns));
+    memcpy(session->partial_lines, held_lines, sizeof(session->partial_lines));
+}
+
+void release_game_session(GameSession *session) {
+    for (Player player = PLAYER_BLACK; player <= PLAYER_WHITE; player++) {
+        slab_free(&partial_lines, session->partial_lines[player]);
+        session->partial_lines[player] = NULL;
+    }
+}
+
+static int awaiting_rematch(const GameSession *session) {
+    return session->rematch_deadline_ns != 0 || session->rematch_votes == REMATCH_BOTH_PLAYERS;
+}
+
+int session_is_live(const GameSession *session) {
+    return !session->finished || awaiting_rematch(session);
+}
+
+void close_rematch_window(GameSession *session, const char *reason) {
+    send_error_message(session->sockets[PLAYER_BLACK], reason);
+    send_error_message(session->sockets[PLAYER_WHITE], reason);
+    session->rematch_deadline_ns = 0;
+    session->rematch_votes = 0;
+}
+
+static SessionStatus handle_rematch_data(GameSession *session, Player player, char *cursor) {
+    ParsedMessage message;
+    char *line;
+
+    while ((line = next_message_line(&cursor)) != NULL) {
+        tokenize_message(line, &message);
+        trace_instant(TRACE_MESSAGE_RECEIVED, message.opcode, message.opcode_length);
+        if (message.type == MESSAGE_TYPE_QUIT) {
+            send_error_message(session->sockets[opponent_of(player)], "rematch_declined");
+            return SESSION_CLOSED;
+        }
+        if (message.type == MESSAGE_TYPE_PONG) {
+            record_pong(session, player, &message);
+            continue;
+        }
+        if (message.type != MESSAGE_TYPE_REMATCH) {
+            send_error_message(session->sockets[player], "game_over");
+            continue;
+        }
+        if (session->rematch_deadline_ns == 0 || (session->rematch_votes & (1 << player))) {
+            continue;
+        }
+
+        session->rematch_votes |= 1 << player;
+        if (session->rematch_votes == REMATCH_BOTH_PLAYERS) {
+            session->rematch_deadline_ns = 0;
+            return SESSION_REMATCH;
+        }
+        send_rematch_message(session->sockets[opponent_of(player)]);
+    }
+    return SESSION_RUNNING;
+}
+
+static size_t take_partial_line(GameSession *session, Player player, char *buffer) {
+    char *partial = session->partial_lines[player];
+    if (partial == NULL) {
+        return 0;
+    }
+    size_t length = strlen(partial);
+    memcpy(buffer, partial, length);
+    slab_free(&partial_lines, partial);
+    session->partial_lines[player] = NULL;
+    return length;
+}
+
+static void hold_partial_line(GameSession *session, Player player, char *buffer, size_t length) {
+    char *line_end = memrchr(buffer, '\n', length);
+    char *tail = (line_end != NULL) ? line_end + 1 : buffer;
+    size_t tail_length = (size_t)(buffer + length - tail);
+    if (tail_length == 0 || tail_length >= MAX_MESSAGE_LENGTH) {
+        return;
+    }
+
+    char *partial = slab_alloc(&partial_lines);
+    if (partial == NULL) {
+        return;
+    }
+    memcpy(partial, tail, tail_length);
+    partial[tail_length] = '\0';
+    session->partial_lines[player] = partial;
+    *tail = '\0';
+}
+
+static SessionStatus process_session_data(GameSession *session, Player player, const char *data,
+                                          ssize_t length) {
+    char buffer[2 * MAX_MESSAGE_LENGTH];
+    uint64_t received_at = metrics_now_ns();
+
+    if (length <= 0) {
+        if (session->finished) {
+            report_disconnect(session->sockets[player], "closed");
+            send_error_message(session->sockets[opponent_of(player)], "rematch_declined");
+        } else {
+            end_with_departure(session, player, "closed");
+        }
+        return SESSION_CLOSED;
+    }
+    if (length > MAX_MESSAGE_LENGTH - 1) {
+        length = MAX_MESSAGE_LENGTH - 1;
+    }
+    size_t held = take_partial_line(session, player, buffer);
+    memcpy(buffer + held, data, (size_t)length);
+    buffer[held + (size_t)length] = '\0';
+    hold_partial_line(session, player, buffer, held + (size_t)length);
+    metrics_add(METRIC_BYTES_RECEIVED, (uint64_t)length);
+    session->last_heard_ns[player] = received_at;
+
+    if (session->finished) {
+        return handle_rematch_data(session, player, buffer);
+    }
+    touch_game_slot(session->result.slot, received_at);
+
+    ParsedMessage message;
+    char *cursor = buffer;
+    while (next_game_message(session, player, &cursor, &message)) {
+        if (player == session->game->current_player) {
+            apply_game_message(session, &message, received_at);
+        }
+    }
+    return session_is_live(session) ? SESSION_RUNNING : SESSION_CLOSED;
+}
+
+SessionStatus handle_session_data(GameSession *session, Player player, const char *data, ssize_t length) {
+    trace_set_game(session->result.game_id);
+    TraceSpan span = trace_begin(TRACE_SESSION_DATA);
+    SessionStatus status = process_session_data(session, player, data, length);
+    const char *player_label = player == PLAYER_BLACK ? "black" : "white";
+    trace_end(&span, player_label, strlen(player_label));
+    trace_set_game(0);
+    return status;
+}
+
+SessionStatus check_session_heartbeat(GameSession *session, uint64_t now_ns, uint64_t timeout_ns) {
+    for (Player player = PLAYER_BLACK; player <= PLAYER_WHITE; player++) {
+        if (now_ns < session->last_heard_ns[player] + timeout_ns) {
+            continue;
+        }
+
+        metrics_increment(METRIC_HEARTBEAT_TIMEOUTS);
+        if (session->finished) {
+            report_disconnect(session->sockets[player], "heartbeat_timeout");
+            send_error_message(session->sockets[opponent_of(player)], "rematch_declined");
+        } else {
+            end_with_departure(session, player, "heartbeat_timeout");
+        }
+        return SESSION_CLOSED;
+    }
+
+    send_ping_message(session->sockets[PLAYER_BLACK], now_ns);
+    send_ping_message(session->sockets[PLAYER_WHITE], now_ns);
+    return SESSION_RUNNING;
+}
+
+static void abort_session(GameSession *session, const char *reason) {
+    send_error_message(session->sockets[PLAYER_BLACK], reason);
+    send_error_message(session->sockets[PLAYER_WHITE], reason);
+    finish_session(session, GAME_OUTCOME_ABORTED);
+}
+
+void stop_game_session(GameSession *session) {
+    trace_set_game(session->result.game_id);
+    LOG_INFO("game_stopped", LOG_INT("game_id", session->result.game_id));
+    abort_session(session, "game_stopped");
+    trace_set_game(0);
+}
+
+void abort_game_session(GameSession *session, const char *reason) {
+    trace_set_game(session->result.game_id);
+    LOG_WARN("game_aborted", LOG_INT("game_id", session->result.game_id), LOG_TEXT("reason", reason));
+    abort_session(session, reason);
+    trace_set_game(0);
+}
@@ -0,0 +1,57 @@
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <stdint.h>
+#include <sys/types.h>
+#include "game.h"
+#include "results.h"
+#include "leaderboard.h"
+
+#define SESSION_ALLOW_TAKEBACKS 0x1
+#define SESSION_ALLOW_REMATCH 0x2
+#define NO_UNDO_REQUEST -1
+#define NO_PREMOVE -1
+#define REMATCH_WINDOW_SECONDS 15
+
+typedef enum {
+    SESSION_RUNNING,
+    SESSION_CLOSED,
+    SESSION_REMATCH
+} SessionStatus;
+
+typedef struct {
+    int sockets[2];
+    GameState *game;
+    int board_size;
+    int move_count;
+    int turn_announced;
+    int finished;
+    int flags;
+    int undo_requester;
+    int premoves[2];
+    int swapped;
+    int rematch_votes;
+    uint64_t rematch_deadline_ns;
+    uint64_t last_heard_ns[2];
+    uint64_t rtt_ns[2];
+    char *partial_lines[2];
+    GameResult result;
+} GameSession;
+
+typedef void (*RankQueryHandler)(const GameSession *session, Player player, const char *name);
+
+int initialize_game_states(uint32_t capacity);
+void set_rank_query_handler(RankQueryHandler handler);
+void answer_rank_query(int socket_fd, const LeaderboardEntry *entry, int players);
+void start_game_session(GameSession *session, int game_id, int slot, pid_t worker_pid, int flags,
+                        int board_size, int black_socket, int white_socket);
+void restart_game_session(GameSession *session, int game_id, int slot);
+void release_game_session(GameSession *session);
+SessionStatus handle_session_data(GameSession *session, Player player, const char *data, ssize_t length);
+int session_is_live(const GameSession *session);
+SessionStatus check_session_heartbeat(GameSession *session, uint64_t now_ns, uint64_t timeout_ns);
+void close_rematch_window(GameSession *session, const char *reason);
+void stop_game_session(GameSession *session);
+void abort_game_session(GameSession *session, const char *reason);
+
+#endif
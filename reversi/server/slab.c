@@ -0,0 +1,98 @@
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "slab.h"
+
+static size_t round_up(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+int slab_init(Slab *slab, size_t object_size, uint32_t capacity) {
+    memset(slab, 0, sizeof(*slab));
+    if (object_size == 0 || capacity == 0) {
+        return -1;
+    }
+
+    slab->object_size = round_up(object_size, SLAB_ALIGNMENT);
+    slab->chunk_size = round_up(slab->object_size > SLAB_CHUNK_SIZE ? slab->object_size : SLAB_CHUNK_SIZE,
+                                SLAB_CHUNK_SIZE);
+    slab->chunk_objects = (uint32_t)(slab->chunk_size / slab->object_size);
+    if (slab->chunk_objects > capacity) {
+        slab->chunk_objects = capacity;
+        slab->chunk_size = round_up(slab->object_size * capacity, SLAB_ALIGNMENT);
+    }
+    slab->capacity = capacity;
+    slab->chunks = calloc((capacity + slab->chunk_objects - 1) / slab->chunk_objects, sizeof(*slab->chunks));
+    return slab->chunks != NULL ? 0 : -1;
+}
+
+void slab_destroy(Slab *slab) {
+    for (uint32_t i = 0; i < slab->chunk_count; i++) {
+        munmap(slab->chunks[i], slab->chunk_size);
+    }
+    free(slab->chunks);
+    memset(slab, 0, sizeof(*slab));
+}
+
+static void *carve_object(Slab *slab) {
+    if (slab->carved == slab->capacity) {
+        return NULL;
+    }
+
+    uint32_t chunk = slab->carved / slab->chunk_objects;
+    if (chunk == slab->chunk_count) {
+        void *memory = mmap(NULL, slab->chunk_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            return NULL;
+        }
+        slab->chunks[slab->chunk_count++] = memory;
+    }
+    uint32_t index = slab->carved++;
+    return slab_object(slab, index);
+}
+
+void *slab_alloc(Slab *slab) {
+    void *object = slab->free_list;
+    if (object != NULL) {
+        slab->free_list = slab->free_list->next;
+    } else if ((object = carve_object(slab)) == NULL) {
+        return NULL;
+    }
+    slab->in_use++;
+    return object;
+}
+
+void slab_free(Slab *slab, void *object) {
+    if (object == NULL) {
+        return;
+    }
+    SlabFreeObject *entry = object;
+    entry->next = slab->free_list;
+    slab->free_list = entry;
+    slab->in_use--;
+}
+
+void *slab_object(const Slab *slab, uint32_t index) {
+    if (index >= slab->carved) {
+        return NULL;
+    }
+    return slab->chunks[index / slab->chunk_objects] + (size_t)(index % slab->chunk_objects) * slab->object_size;
+}
+
+uint32_t slab_index(const Slab *slab, const void *object) {
+    const char *address = object;
+    for (uint32_t chunk = 0; chunk < slab->chunk_count; chunk++) {
+        if (address >= slab->chunks[chunk] && address < slab->chunks[chunk] + slab->chunk_size) {
+            size_t offset = (size_t)(address - slab->chunks[chunk]);
+            if (offset % slab->object_size != 0 || offset / slab->object_size >= slab->chunk_objects) {
+                return SLAB_NO_INDEX;
+            }
+            return chunk * slab->chunk_objects + (uint32_t)(offset / slab->object_size);
+        }
+    }
+    return SLAB_NO_INDEX;
+}
+
+size_t slab_reserved_bytes(const Slab *slab) {
+    return (size_t)slab->chunk_count * slab->chunk_size;
+}
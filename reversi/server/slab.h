@@ -0,0 +1,35 @@
+#ifndef SLAB_H
+#define SLAB_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SLAB_ALIGNMENT 64
+#define SLAB_CHUNK_SIZE (64 * 1024)
+#define SLAB_NO_INDEX UINT32_MAX
+
+typedef struct SlabFreeObject {
+    struct SlabFreeObject *next;
+} SlabFreeObject;
+
+typedef struct {
+    size_t object_size;
+    size_t chunk_size;
+    uint32_t chunk_objects;
+    uint32_t capacity;
+    uint32_t carved;
+    uint32_t in_use;
+    uint32_t chunk_count;
+    char **chunks;
+    SlabFreeObject *free_list;
+} Slab;
+
+int slab_init(Slab *slab, size_t object_size, uint32_t capacity);
+void slab_destroy(Slab *slab);
+void *slab_alloc(Slab *slab);
+void slab_free(Slab *slab, void *object);
+void *slab_object(const Slab *slab, uint32_t index);
+uint32_t slab_index(const Slab *slab, const void *object);
+size_t slab_reserved_bytes(const Slab *slab);
+
+#endif
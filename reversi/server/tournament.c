@@ -0,0 +1,643 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include "tournament.h"
+#include "matchmaking.h"
+#include "network.h"
+#include "metrics.h"
+#include "workers.h"
+#include "log.h"
+
+#define PAIR_SET_INITIAL_CAPACITY 1024
+#define PAIRING_DEFERRED -2
+
+static tournament_config settings;
+static TournamentEntrant *entrants = NULL;
+static int entrant_count = 0;
+static int entrant_capacity = 0;
+static PairSet played_pairs;
+static TournamentPairing *round_pairings = NULL;
+static int round_pairing_count = 0;
+static int *pairing_by_game = NULL;
+static int pairing_table_length = 0;
+static int deferred_games = 0;
+static uint64_t next_retry_ns = 0;
+static int round_first_game_id = -1;
+static int round_game_count = 0;
+static int current_round = 0;
+static int total_rounds = 0;
+static int pending_games = 0;
+static int tournament_running = 0;
+
+static uint64_t pair_key(int first, int second) {
+    if (first > second) {
+        int swap = first;
+        first = second;
+        second = swap;
+    }
+    return ((uint64_t)(uint32_t)(first + 1) << 32) | (uint32_t)(second + 1);
+}
+
+static size_t pair_slot(uint64_t key, size_t capacity) {
+    return (size_t)((key * 0x9E3779B97F4A7C15ULL) >> 32) & (capacity - 1);
+}
+
+static int pair_set_grow(PairSet *set) {
+    size_t new_capacity = set->capacity == 0 ? PAIR_SET_INITIAL_CAPACITY : set->capacity * 2;
+    uint64_t *new_keys = calloc(new_capacity, sizeof(uint64_t));
+    if (new_keys == NULL) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < set->capacity; i++) {
+        uint64_t key = set->keys[i];
+        if (key == 0) {
+            continue;
+        }
+        size_t slot = pair_slot(key, new_capacity);
+        while (new_keys[slot] != 0) {
+            slot = (slot + 1) & (new_capacity - 1);
+        }
+        new_keys[slot] = key;
+    }
+
+    free(set->keys);
+    set->keys = new_keys;
+    set->capacity = new_capacity;
+    return 0;
+}
+
+int pair_set_insert(PairSet *set, int first, int second) {
+    if ((set->count + 1) * 2 > set->capacity && pair_set_grow(set) < 0) {
+        return -1;
+    }
+
+    uint64_t key = pair_key(first, second);
+    size_t slot = pair_slot(key, set->capacity);
+    while (set->keys[slot] != 0) {
+        if (set->keys[slot] == key) {
+            return 0;
+        }
+        slot = (slot + 1) & (set->capacity - 1);
+    }
+    set->keys[slot] = key;
+    set->count++;
+    return 1;
+}
+
+int pair_set_contains(const PairSet *set, int first, int second) {
+    if (set->capacity == 0) {
+        return 0;
+    }
+
+    uint64_t key = pair_key(first, second);
+    size_t slot = pair_slot(key, set->capacity);
+    while (set->keys[slot] != 0) {
+        if (set->keys[slot] == key) {
+            return 1;
+        }
+        slot = (slot + 1) & (set->capacity - 1);
+    }
+    return 0;
+}
+
+void pair_set_clear(PairSet *set) {
+    free(set->keys);
+    set->keys = NULL;
+    set->capacity = 0;
+    set->count = 0;
+}
+
+static const TournamentEntrant *sort_entrants = NULL;
+
+static int compare_standings(const void *left, const void *right) {
+    int a = *(const int *)left;
+    int b = *(const int *)right;
+    const TournamentEntrant *first = &sort_entrants[a];
+    const TournamentEntrant *second = &sort_entrants[b];
+
+    if (first->points != second->points) {
+        return second->points - first->points;
+    }
+    if (first->disc_difference != second->disc_difference) {
+        return second->disc_difference - first->disc_difference;
+    }
+    return a - b;
+}
+
+static void sort_by_standing(const TournamentEntrant *pool, int *order, int count) {
+    sort_entrants = pool;
+    qsort(order, (size_t)count, sizeof(int), compare_standings);
+    sort_entrants = NULL;
+}
+
+static void assign_colors(const TournamentEntrant *pool, int first, int second, TournamentPairing *pairing) {
+    if (pool[second].color_balance < pool[first].color_balance) {
+        pairing->black = second;
+        pairing->white = first;
+    } else {
+        pairing->black = first;
+        pairing->white = second;
+    }
+    pairing->game_id = 0;
+}
+
+static int colors_compatible(const TournamentEntrant *first, const TournamentEntrant *second) {
+    return !(first->color_balance >= SWISS_COLOR_LIMIT && second->color_balance >= SWISS_COLOR_LIMIT) &&
+           !(first->color_balance <= -SWISS_COLOR_LIMIT && second->color_balance <= -SWISS_COLOR_LIMIT);
+}
+
+static int unlink_position(int position, int head, int *next_unpaired, int *previous_unpaired, int end) {
+    int next = next_unpaired[position];
+    int previous = previous_unpaired[position];
+
+    if (previous >= 0) {
+        next_unpaired[previous] = next;
+    } else {
+        head = next;
+    }
+    if (next < end) {
+        previous_unpaired[next] = previous;
+    }
+    return head;
+}
+
+int generate_swiss_pairings(const TournamentEntrant *pool, int pool_size, const PairSet *played,
+                            TournamentPairing *pairings) {
+    int *order = malloc((size_t)(pool_size + 1) * sizeof(int));
+    int *next_unpaired = malloc((size_t)(pool_size + 1) * sizeof(int));
+    int *previous_unpaired = malloc((size_t)(pool_size + 1) * sizeof(int));
+    if (order == NULL || next_unpaired == NULL || previous_unpaired == NULL) {
+        free(order);
+        free(next_unpaired);
+        free(previous_unpaired);
+        return -1;
+    }
+
+    int active_count = 0;
+    for (int i = 0; i < pool_size; i++) {
+        if (!pool[i].withdrawn) {
+            order[active_count++] = i;
+        }
+    }
+    sort_by_standing(pool, order, active_count);
+
+    int pairing_count = 0;
+    if (active_count % 2 == 1) {
+        int bye_position = active_count - 1;
+        for (int i = active_count - 1; i >= 0; i--) {
+            if (pool[order[i]].byes < pool[order[bye_position]].byes) {
+                bye_position = i;
+            }
+            if (pool[order[bye_position]].byes == 0) {
+                break;
+            }
+        }
+        pairings[pairing_count++] = (TournamentPairing){ .black = order[bye_position], .white = -1, .game_id = 0 };
+        memmove(&order[bye_position], &order[bye_position + 1],
+                (size_t)(active_count - bye_position - 1) * sizeof(int));
+        active_count--;
+    }
+
+    for (int i = 0; i < active_count; i++) {
+        next_unpaired[i] = i + 1;
+        previous_unpaired[i] = i - 1;
+    }
+
+    int head = 0;
+    while (head < active_count) {
+        int first = head;
+        head = unlink_position(first, head, next_unpaired, previous_unpaired, active_count);
+
+        int chosen = -1;
+        int fallback = -1;
+        int examined = 0;
+        for (int candidate = head; candidate < active_count && examined < SWISS_PAIRING_WINDOW;
+             candidate = next_unpaired[candidate], examined++) {
+            if (pair_set_contains(played, order[first], order[candidate])) {
+                continue;
+            }
+            if (fallback < 0) {
+                fallback = candidate;
+            }
+            if (colors_compatible(&pool[order[first]], &pool[order[candidate]])) {
+                chosen = candidate;
+                break;
+            }
+        }
+        if (chosen < 0) {
+            chosen = (fallback >= 0) ? fallback : head;
+        }
+        head = unlink_position(chosen, head, next_unpaired, previous_unpaired, active_count);
+
+        assign_colors(pool, order[first], order[chosen], &pairings[pairing_count++]);
+    }
+
+    free(order);
+    free(next_unpaired);
+    free(previous_unpaired);
+    return pairing_count;
+}
+
+int generate_round_robin_pairings(int pool_size, int round, TournamentPairing *pairings) {
+    int slots = pool_size + (pool_size % 2);
+    int rotation = slots - 1;
+    int pairing_count = 0;
+
+    if (slots < 2) {
+        return 0;
+    }
+
+    for (int k = 0; k < slots / 2; k++) {
+        int first = (k == 0) ? 0 : 1 + (k - 1 + round) % rotation;
+        int second = 1 + (slots - 2 - k + round) % rotation;
+
+        if (first >= pool_size || second >= pool_size) {
+            int present = (first >= pool_size) ? second : first;
+            pairings[pairing_count++] = (TournamentPairing){ .black = present, .white = -1, .game_id = 0 };
+            continue;
+        }
+
+        if ((round + k) % 2 == 0) {
+            pairings[pairing_count++] = (TournamentPairing){ .black = first, .white = second, .game_id = 0 };
+        } else {
+            pairings[pairing_count++] = (TournamentPairing){ .black = second, .white = first, .game_id = 0 };
+        }
+    }
+    return pairing_count;
+}
+
+int default_tournament_rounds(TournamentFormat format, int pool_size) {
+    if (pool_size < 2) {
+        return 0;
+    }
+    if (format == TOURNAMENT_ROUND_ROBIN) {
+        return pool_size + (pool_size % 2) - 1;
+    }
+
+    int rounds = 0;
+    while ((1 << rounds) < pool_size) {
+        rounds++;
+    }
+    return rounds;
+}
+
+int parse_tournament_format(const char *text, TournamentFormat *format) {
+    if (strcasecmp(text, "swiss") == 0) {
+        *format = TOURNAMENT_SWISS;
+        return 0;
+    }
+    if (strcasecmp(text, "roundrobin") == 0 || strcasecmp(text, "round-robin") == 0) {
+        *format = TOURNAMENT_ROUND_ROBIN;
+        return 0;
+    }
+    return -1;
+}
+
+void configure_tournament(const tournament_config *config) {
+    settings = *config;
+}
+
+int tournament_enabled(void) {
+    return settings.format != TOURNAMENT_NONE;
+}
+
+int tournament_active(void) {
+    return entrant_count > 0;
+}
+
+int count_tournament_entrants(void) {
+    return entrant_count;
+}
+
+static void format_score(int points, char *buffer, size_t buffer_size) {
+    snprintf(buffer, buffer_size, "%d.%d", points / TOURNAMENT_POINTS_WIN,
+             (points % TOURNAMENT_POINTS_WIN) * 5);
+}
+
+static void withdraw_entrant(int index) {
+    TournamentEntrant *entrant = &entrants[index];
+    if (entrant->withdrawn) {
+        return;
+    }
+    entrant->withdrawn = 1;
+    close(entrant->socket_fd);
+    LOG_INFO("tournament_withdrawal", LOG_INT("entrant", index), LOG_INT("round", current_round));
+}
+
+static void reset_tournament(void) {
+    free(entrants);
+    free(round_pairings);
+    free(pairing_by_game);
+    entrants = NULL;
+    round_pairings = NULL;
+    pairing_by_game = NULL;
+    pairing_table_length = 0;
+    deferred_games = 0;
+    next_retry_ns = 0;
+    entrant_count = 0;
+    entrant_capacity = 0;
+    round_pairing_count = 0;
+    round_first_game_id = -1;
+    round_game_count = 0;
+    current_round = 0;
+    total_rounds = 0;
+    pending_games = 0;
+    tournament_running = 0;
+    pair_set_clear(&played_pairs);
+}
+
+static void finish_tournament(void) {
+    int *order = malloc((size_t)entrant_count * sizeof(int));
+    char score[16];
+
+    if (order != NULL) {
+        for (int i = 0; i < entrant_count; i++) {
+            order[i] = i;
+        }
+        sort_by_standing(entrants, order, entrant_count);
+
+        for (int rank = 0; rank < entrant_count; rank++) {
+            TournamentEntrant *entrant = &entrants[order[rank]];
+            format_score(entrant->points, score, sizeof(score));
+            if (rank < 3) {
+                LOG_INFO("tournament_standing", LOG_INT("rank", rank + 1), LOG_INT("entrant", order[rank]),
+                         LOG_TEXT("score", score), LOG_INT("disc_difference", entrant->disc_difference));
+            }
+            if (!entrant->withdrawn) {
+                send_tournament_over_message(entrant->socket_fd, rank + 1, entrant_count, score);
+                close(entrant->socket_fd);
+            }
+        }
+        free(order);
+    } else {
+        for (int i = 0; i < entrant_count; i++) {
+            if (!entrants[i].withdrawn) {
+                close(entrants[i].socket_fd);
+            }
+        }
+    }
+
+    LOG_INFO("tournament_finished", LOG_INT("entrants", entrant_count), LOG_INT("rounds", current_round));
+    reset_tournament();
+}
+
+static void award_bye(int index) {
+    TournamentEntrant *entrant = &entrants[index];
+    entrant->points += TOURNAMENT_POINTS_WIN;
+    entrant->byes++;
+    send_round_message(entrant->socket_fd, current_round, total_rounds);
+    send_bye_message(entrant->socket_fd);
+}
+
+static int count_active_entrants(void) {
+    int active = 0;
+    for (int i = 0; i < entrant_count; i++) {
+        active += !entrants[i].withdrawn;
+    }
+    return active;
+}
+
+static void note_pairing_game(int index) {
+    int game_id = round_pairings[index].game_id;
+    if (round_first_game_id < 0) {
+        round_first_game_id = game_id;
+    }
+    int offset = game_id - round_first_game_id;
+    if (offset >= 0 && offset < pairing_table_length) {
+        pairing_by_game[offset] = index;
+        if (offset >= round_game_count) {
+            round_game_count = offset + 1;
+        }
+    }
+}
+
+static int start_pairing_game(int index) {
+    TournamentPairing *pairing = &round_pairings[index];
+    int game_id = worker_pool_has_room()
+                      ? spawn_game(entrants[pairing->black].socket_fd, entrants[pairing->white].socket_fd, 0)
+                      : -1;
+    if (game_id < 0) {
+        pairing->game_id = PAIRING_DEFERRED;
+        return -1;
+    }
+    pairing->game_id = game_id;
+    note_pairing_game(index);
+    pending_games++;
+    return 0;
+}
+
+static void defer_pairing(int index) {
+    TournamentPairing *pairing = &round_pairings[index];
+    LOG_WARN("tournament_game_deferred", LOG_INT("round", current_round), LOG_INT("black", pairing->black),
+             LOG_INT("white", pairing->white));
+    send_wait_message(entrants[pairing->black].socket_fd);
+    send_wait_message(entrants[pairing->white].socket_fd);
+    deferred_games++;
+    next_retry_ns = metrics_now_ns() + (uint64_t)TOURNAMENT_RETRY_MS * 1000000ULL;
+}
+
+static void start_next_round(void) {
+    while (pending_games == 0 && deferred_games == 0) {
+        if (current_round >= total_rounds || count_active_entrants() < 2) {
+            finish_tournament();
+            return;
+        }
+
+        current_round++;
+        round_first_game_id = -1;
+        round_game_count = 0;
+        if (settings.format == TOURNAMENT_ROUND_ROBIN) {
+            round_pairing_count = generate_round_robin_pairings(entrant_count, current_round - 1, round_pairings);
+        } else {
+            round_pairing_count = generate_swiss_pairings(entrants, entrant_count, &played_pairs, round_pairings);
+        }
+        if (round_pairing_count < 0) {
+            LOG_ERROR("tournament_pairing_failed", LOG_INT("round", current_round));
+            finish_tournament();
+            return;
+        }
+
+        for (int i = 0; i < round_pairing_count; i++) {
+            TournamentPairing *pairing = &round_pairings[i];
+            int black_present = !entrants[pairing->black].withdrawn;
+            int white_present = pairing->white >= 0 && !entrants[pairing->white].withdrawn;
+
+            if (!black_present || !white_present) {
+                if (black_present) {
+                    award_bye(pairing->black);
+                } else if (white_present) {
+                    award_bye(pairing->white);
+                }
+                pairing->game_id = -1;
+                continue;
+            }
+
+            TournamentEntrant *black = &entrants[pairing->black];
+            TournamentEntrant *white = &entrants[pairing->white];
+            pair_set_insert(&played_pairs, pairing->black, pairing->white);
+            black->color_balance++;
+            white->color_balance--;
+            send_round_message(black->socket_fd, current_round, total_rounds);
+            send_round_message(white->socket_fd, current_round, total_rounds);
+
+            if (start_pairing_game(i) < 0) {
+                defer_pairing(i);
+            }
+        }
+
+        LOG_INFO("tournament_round_started", LOG_INT("round", current_round), LOG_INT("rounds", total_rounds),
+                 LOG_INT("games", pending_games), LOG_INT("deferred", deferred_games));
+    }
+}
+
+static void start_tournament(void) {
+    total_rounds = (settings.format == TOURNAMENT_ROUND_ROBIN || settings.rounds <= 0)
+                       ? default_tournament_rounds(settings.format, entrant_count)
+                       : settings.rounds;
+    if (settings.format == TOURNAMENT_SWISS && total_rounds > entrant_count - 1) {
+        total_rounds = entrant_count - 1;
+    }
+
+    round_pairings = calloc((size_t)(entrant_count / 2 + 1), sizeof(TournamentPairing));
+    pairing_table_length = entrant_count / 2 + 1;
+    pairing_by_game = calloc((size_t)pairing_table_length, sizeof(int));
+    if (round_pairings == NULL || pairing_by_game == NULL) {
+        LOG_ERROR("tournament_allocation_failed", LOG_INT("entrants", entrant_count));
+        finish_tournament();
+        return;
+    }
+
+    tournament_running = 1;
+    LOG_INFO("tournament_started", LOG_TEXT("format", settings.format == TOURNAMENT_SWISS ? "swiss" : "roundrobin"),
+             LOG_INT("entrants", entrant_count), LOG_INT("rounds", total_rounds));
+    start_next_round();
+}
+
+void register_tournament_entrant(int client_socket) {
+    if (tournament_running) {
+        send_error_message(client_socket, "tournament_in_progress");
+        close(client_socket);
+        return;
+    }
+
+    if (entrant_count == entrant_capacity) {
+        int new_capacity = entrant_capacity == 0 ? 64 : entrant_capacity * 2;
+        TournamentEntrant *grown = realloc(entrants, (size_t)new_capacity * sizeof(TournamentEntrant));
+        if (grown == NULL) {
+            send_error_message(client_socket, "server_busy");
+            close(client_socket);
+            return;
+        }
+        entrants = grown;
+        entrant_capacity = new_capacity;
+    }
+
+    entrants[entrant_count] = (TournamentEntrant){ .socket_fd = client_socket };
+    entrant_count++;
+    send_wait_message(client_socket);
+
+    if (entrant_count >= settings.entrants) {
+        start_tournament();
+    }
+}
+
+static TournamentPairing *find_pairing(int game_id) {
+    if (round_first_game_id < 0 || game_id < 0) {
+        return NULL;
+    }
+
+    int offset = game_id - round_first_game_id;
+    int index = -1;
+    if (offset >= 0 && offset < round_game_count && offset < pairing_table_length) {
+        index = pairing_by_game[offset];
+    }
+    if (index < 0 || index >= round_pairing_count || round_pairings[index].game_id != game_id) {
+        for (index = 0; index < round_pairing_count && round_pairings[index].game_id != game_id; index++) {
+        }
+        if (index == round_pairing_count) {
+            return NULL;
+        }
+    }
+    round_pairings[index].game_id = -1;
+    return &round_pairings[index];
+}
+
+int record_tournament_result(const GameResult *result) {
+    if (!tournament_running) {
+        return 0;
+    }
+
+    TournamentPairing *pairing = find_pairing(result->game_id);
+    if (pairing == NULL) {
+        return 0;
+    }
+
+    TournamentEntrant *black = &entrants[pairing->black];
+    TournamentEntrant *white = &entrants[pairing->white];
+    int difference = result->black_count - result->white_count;
+
+    switch (result->outcome) {
+        case GAME_OUTCOME_BLACK_WINS:
+            black->points += TOURNAMENT_POINTS_WIN;
+            break;
+        case GAME_OUTCOME_WHITE_WINS:
+            white->points += TOURNAMENT_POINTS_WIN;
+            break;
+        case GAME_OUTCOME_DRAW:
+            black->points += TOURNAMENT_POINTS_DRAW;
+            white->points += TOURNAMENT_POINTS_DRAW;
+            break;
+        case GAME_OUTCOME_BLACK_LEFT:
+            white->points += TOURNAMENT_POINTS_WIN;
+            withdraw_entrant(pairing->black);
+            break;
+        case GAME_OUTCOME_WHITE_LEFT:
+            black->points += TOURNAMENT_POINTS_WIN;
+            withdraw_entrant(pairing->white);
+            break;
+        default:
+            break;
+    }
+    black->disc_difference += difference;
+    white->disc_difference -= difference;
+    pending_games--;
+    if (deferred_games > 0) {
+        next_retry_ns = 0;
+        retry_tournament_games(metrics_now_ns());
+    }
+    if (pending_games == 0 && deferred_games == 0) {
+        start_next_round();
+    }
+    return 1;
+}
+
+int tournament_timeout_ms(uint64_t now_ns) {
+    if (deferred_games == 0) {
+        return -1;
+    }
+    if (next_retry_ns <= now_ns) {
+        return 0;
+    }
+    return (int)((next_retry_ns - now_ns + 999999ULL) / 1000000ULL);
+}
+
+void retry_tournament_games(uint64_t now_ns) {
+    if (deferred_games == 0 || now_ns < next_retry_ns) {
+        return;
+    }
+
+    for (int i = 0; i < round_pairing_count && deferred_games > 0; i++) {
+        if (round_pairings[i].game_id != PAIRING_DEFERRED) {
+            continue;
+        }
+        if (start_pairing_game(i) < 0) {
+            next_retry_ns = now_ns + (uint64_t)TOURNAMENT_RETRY_MS * 1000000ULL;
+            return;
+        }
+        deferred_games--;
+    }
+    LOG_INFO("tournament_games_resumed", LOG_INT("round", current_round), LOG_INT("games", pending_games));
+}
@@ -0,0 +1,67 @@
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "results.h"
+
+#define SWISS_PAIRING_WINDOW 32
+#define SWISS_COLOR_LIMIT 2
+#define TOURNAMENT_POINTS_WIN 2
+#define TOURNAMENT_POINTS_DRAW 1
+#define MAX_TOURNAMENT_ENTRANTS 100000
+#define TOURNAMENT_RETRY_MS 500
+
+typedef enum {
+    TOURNAMENT_NONE,
+    TOURNAMENT_SWISS,
+    TOURNAMENT_ROUND_ROBIN
+} TournamentFormat;
+
+typedef struct {
+    TournamentFormat format;
+    int entrants;
+    int rounds;
+} tournament_config;
+
+typedef struct {
+    int socket_fd;
+    int points;
+    int disc_difference;
+    int color_balance;
+    int byes;
+    int withdrawn;
+} TournamentEntrant;
+
+typedef struct {
+    int black;
+    int white;
+    int game_id;
+} TournamentPairing;
+
+typedef struct {
+    uint64_t *keys;
+    size_t capacity;
+    size_t count;
+} PairSet;
+
+int pair_set_insert(PairSet *set, int first, int second);
+int pair_set_contains(const PairSet *set, int first, int second);
+void pair_set_clear(PairSet *set);
+
+int generate_swiss_pairings(const TournamentEntrant *entrants, int entrant_count, const PairSet *played,
+                            TournamentPairing *pairings);
+int generate_round_robin_pairings(int entrant_count, int round, TournamentPairing *pairings);
+int default_tournament_rounds(TournamentFormat format, int entrant_count);
+
+int parse_tournament_format(const char *text, TournamentFormat *format);
+void configure_tournament(const tournament_config *config);
+int tournament_enabled(void);
+int tournament_active(void);
+int count_tournament_entrants(void);
+void register_tournament_entrant(int client_socket);
+int record_tournament_result(const GameResult *result);
+int tournament_timeout_ms(uint64_t now_ns);
+void retry_tournament_games(uint64_t now_ns);
+
+#endif
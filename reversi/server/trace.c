@@ -0,0 +1,289 @@
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include "trace.h"
+#include "metrics.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TRACE_HAVE_TSC 1
+#else
+#define TRACE_HAVE_TSC 0
+#endif
+
+#define TRACE_EVENT_JSON_SIZE 256
+#define TRACE_FOOTER "],\"displayTimeUnit\":\"ns\"}\n"
+
+typedef struct {
+    _Atomic uint32_t sequence;
+    int32_t game_id;
+    uint64_t start;
+    uint64_t end;
+    int32_t pid;
+    uint16_t event;
+    char label[TRACE_LABEL_LENGTH];
+} TraceRecord;
+
+typedef struct {
+    _Alignas(64) _Atomic int32_t owner_tid;
+    _Atomic int32_t owner_pid;
+    _Atomic uint64_t head;
+    TraceRecord records[TRACE_RING_CAPACITY];
+} TraceRing;
+
+typedef struct {
+    _Atomic int32_t games[TRACE_MAX_GAMES];
+    _Atomic int32_t enabled_games;
+    uint64_t origin_ticks;
+    uint64_t origin_ns;
+    TraceRing rings[TRACE_MAX_RINGS];
+} TraceRegistry;
+
+static const struct {
+    const char *name;
+    int instant;
+} TRACE_EVENTS[TRACE_EVENT_COUNT] = {
+    [TRACE_SESSION_DATA] = { "session_data", 0 },
+    [TRACE_MESSAGE_RECEIVED] = { "message_received", 1 },
+    [TRACE_EXECUTE_MOVE] = { "execute_move", 0 },
+    [TRACE_LEGAL_MOVES] = { "legal_moves", 0 },
+    [TRACE_SEND] = { "send", 0 },
+    [TRACE_GAME_STARTED] = { "game_started", 1 },
+    [TRACE_GAME_FINISHED] = { "game_finished", 1 }
+};
+
+_Thread_local int32_t trace_current_game = 0;
+
+static TraceRegistry *registry = NULL;
+static _Thread_local TraceRing *thread_ring = NULL;
+
+uint64_t trace_clock(void) {
+#if TRACE_HAVE_TSC
+    return __rdtsc();
+#else
+    return metrics_now_ns();
+#endif
+}
+
+static void forget_thread_ring(void) {
+    thread_ring = NULL;
+    trace_current_game = 0;
+}
+
+int initialize_tracing(void) {
+    void *memory = mmap(NULL, sizeof(TraceRegistry), PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        perror("trace mmap failed");
+        return -1;
+    }
+
+    registry = memory;
+    registry->origin_ns = metrics_now_ns();
+    registry->origin_ticks = trace_clock();
+    pthread_atfork(NULL, NULL, forget_thread_ring);
+    return 0;
+}
+
+int trace_enable_game(int32_t game_id) {
+    if (registry == NULL || game_id <= 0) {
+        return -1;
+    }
+    if (trace_game_enabled(game_id)) {
+        return 0;
+    }
+
+    for (int i = 0; i < TRACE_MAX_GAMES; i++) {
+        int32_t expected = 0;
+        if (atomic_compare_exchange_strong(&registry->games[i], &expected, game_id)) {
+            atomic_fetch_add(&registry->enabled_games, 1);
+            return 0;
+        }
+    }
+    return -1;
+}
+
+int trace_disable_game(int32_t game_id) {
+    if (registry == NULL || game_id <= 0) {
+        return -1;
+    }
+
+    for (int i = 0; i < TRACE_MAX_GAMES; i++) {
+        int32_t expected = game_id;
+        if (atomic_compare_exchange_strong(&registry->games[i], &expected, 0)) {
+            atomic_fetch_sub(&registry->enabled_games, 1);
+            return 0;
+        }
+    }
+    return -1;
+}
+
+int trace_game_enabled(int32_t game_id) {
+    if (registry == NULL || game_id <= 0 ||
+        atomic_load_explicit(&registry->enabled_games, memory_order_relaxed) == 0) {
+        return 0;
+    }
+
+    for (int i = 0; i < TRACE_MAX_GAMES; i++) {
+        if (atomic_load_explicit(&registry->games[i], memory_order_relaxed) == game_id) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void trace_set_game(int32_t game_id) {
+    trace_current_game = trace_game_enabled(game_id) ? game_id : 0;
+}
+
+static int ring_owner_gone(const TraceRing *ring, pid_t self) {
+    pid_t owner = atomic_load(&ring->owner_pid);
+    return owner != self && kill(owner, 0) < 0 && errno == ESRCH;
+}
+
+static TraceRing *claim_ring(void) {
+    pid_t pid = getpid();
+    int32_t tid = (int32_t)gettid();
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < TRACE_MAX_RINGS; i++) {
+            TraceRing *ring = &registry->rings[i];
+            int32_t owner = atomic_load(&ring->owner_tid);
+            if ((owner == 0 || (pass == 1 && ring_owner_gone(ring, pid))) &&
+                atomic_compare_exchange_strong(&ring->owner_tid, &owner, tid)) {
+                atomic_store(&ring->owner_pid, (int32_t)pid);
+                return ring;
+            }
+        }
+    }
+    return NULL;
+}
+
+static void copy_label(char *label, const char *text, size_t length) {
+    size_t used = 0;
+    for (size_t i = 0; text != NULL && i < length && used < TRACE_LABEL_LENGTH - 1; i++) {
+        char character = text[i];
+        if (character == '|' || character == '\n' || character == '\r' || character == '\0') {
+            break;
+        }
+        int plain = (character >= 'A' && character <= 'Z') || (character >= 'a' && character <= 'z') ||
+                    (character >= '0' && character <= '9') || character == '_';
+        label[used++] = plain ? character : '?';
+    }
+    label[used] = '\0';
+}
+
+void trace_record(TraceEvent event, uint64_t start, const char *label, size_t label_length) {
+    uint64_t end = trace_clock();
+    if (registry == NULL || (thread_ring == NULL && (thread_ring = claim_ring()) == NULL)) {
+        return;
+    }
+
+    TraceRing *ring = thread_ring;
+    uint64_t position = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    TraceRecord *record = &ring->records[position & (TRACE_RING_CAPACITY - 1)];
+    uint32_t sequence = atomic_load_explicit(&record->sequence, memory_order_relaxed);
+
+    atomic_store_explicit(&record->sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    record->game_id = trace_current_game;
+    record->start = start != 0 ? start : end;
+    record->end = end;
+    record->pid = atomic_load_explicit(&ring->owner_pid, memory_order_relaxed);
+    record->event = (uint16_t)event;
+    copy_label(record->label, label, label_length);
+    atomic_store_explicit(&record->sequence, sequence + 2, memory_order_release);
+    atomic_store_explicit(&ring->head, position + 1, memory_order_release);
+}
+
+static int read_record(const TraceRecord *record, TraceRecord *copy) {
+    uint32_t before = atomic_load_explicit(&record->sequence, memory_order_acquire);
+    if (before == 0 || (before & 1) != 0) {
+        return 0;
+    }
+    copy->game_id = record->game_id;
+    copy->start = record->start;
+    copy->end = record->end;
+    copy->pid = record->pid;
+    copy->event = record->event;
+    memcpy(copy->label, record->label, sizeof(copy->label));
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&record->sequence, memory_order_relaxed) == before &&
+           copy->event < TRACE_EVENT_COUNT;
+}
+
+static size_t format_record(char *buffer, size_t buffer_size, const TraceRecord *record, int32_t tid,
+                            double ticks_per_us) {
+    double timestamp_us = (double)(record->start - registry->origin_ticks) / ticks_per_us;
+    int written;
+
+    if (TRACE_EVENTS[record->event].instant) {
+        written = snprintf(buffer, buffer_size,
+                           "{\"name\":\"%s\",\"cat\":\"game\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,"
+                           "\"pid\":%d,\"tid\":%d,\"args\":{\"game_id\":%d,\"label\":\"%s\"}}",
+                           TRACE_EVENTS[record->event].name, timestamp_us, record->pid, tid, record->game_id,
+                           record->label);
+    } else {
+        written = snprintf(buffer, buffer_size,
+                           "{\"name\":\"%s\",\"cat\":\"game\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                           "\"pid\":%d,\"tid\":%d,\"args\":{\"game_id\":%d,\"label\":\"%s\"}}",
+                           TRACE_EVENTS[record->event].name, timestamp_us,
+                           (double)(record->end - record->start) / ticks_per_us, record->pid, tid,
+                           record->game_id, record->label);
+    }
+    return (written > 0 && (size_t)written < buffer_size) ? (size_t)written : 0;
+}
+
+static double measure_ticks_per_us(void) {
+    uint64_t now_ns = metrics_now_ns();
+    uint64_t now_ticks = trace_clock();
+    if (!TRACE_HAVE_TSC || now_ns <= registry->origin_ns || now_ticks <= registry->origin_ticks) {
+        return 1000.0;
+    }
+    return (double)(now_ticks - registry->origin_ticks) * 1000.0 / (double)(now_ns - registry->origin_ns);
+}
+
+size_t render_chrome_trace(char *buffer, size_t buffer_size, int32_t game_id) {
+    const char *header = "{\"traceEvents\":[";
+    size_t footer_length = strlen(TRACE_FOOTER);
+    size_t offset = 0;
+
+    if (buffer_size < strlen(header) + footer_length + 1) {
+        return 0;
+    }
+    offset += (size_t)snprintf(buffer, buffer_size, "%s", header);
+
+    double ticks_per_us = registry != NULL ? measure_ticks_per_us() : 1000.0;
+    int events = 0;
+    for (int i = 0; registry != NULL && i < TRACE_MAX_RINGS; i++) {
+        TraceRing *ring = &registry->rings[i];
+        uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        uint64_t first = head > TRACE_RING_CAPACITY ? head - TRACE_RING_CAPACITY : 0;
+        int32_t owner_pid = atomic_load_explicit(&ring->owner_pid, memory_order_relaxed);
+        int32_t owner_tid = atomic_load_explicit(&ring->owner_tid, memory_order_relaxed);
+
+        for (uint64_t position = first; position < head; position++) {
+            TraceRecord record;
+            if (!read_record(&ring->records[position & (TRACE_RING_CAPACITY - 1)], &record) ||
+                (game_id != 0 && record.game_id != game_id)) {
+                continue;
+            }
+            if (offset + TRACE_EVENT_JSON_SIZE + footer_length + 1 > buffer_size) {
+                break;
+            }
+            if (events++ > 0) {
+                buffer[offset++] = ',';
+            }
+            offset += format_record(buffer + offset, buffer_size - offset, &record,
+                                    record.pid == owner_pid ? owner_tid : record.pid, ticks_per_us);
+        }
+    }
+
+    memcpy(buffer + offset, TRACE_FOOTER, footer_length + 1);
+    return offset + footer_length;
+}
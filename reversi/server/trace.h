@@ -0,0 +1,56 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define TRACE_MAX_RINGS 96
+#define TRACE_RING_CAPACITY 4096
+#define TRACE_MAX_GAMES 16
+#define TRACE_LABEL_LENGTH 16
+#define TRACE_RENDER_SIZE (4 * 1024 * 1024)
+
+typedef enum {
+    TRACE_SESSION_DATA,
+    TRACE_MESSAGE_RECEIVED,
+    TRACE_EXECUTE_MOVE,
+    TRACE_LEGAL_MOVES,
+    TRACE_SEND,
+    TRACE_GAME_STARTED,
+    TRACE_GAME_FINISHED,
+    TRACE_EVENT_COUNT
+} TraceEvent;
+
+typedef struct {
+    uint64_t start;
+    TraceEvent event;
+} TraceSpan;
+
+extern _Thread_local int32_t trace_current_game;
+
+int initialize_tracing(void);
+int trace_enable_game(int32_t game_id);
+int trace_disable_game(int32_t game_id);
+int trace_game_enabled(int32_t game_id);
+void trace_set_game(int32_t game_id);
+uint64_t trace_clock(void);
+void trace_record(TraceEvent event, uint64_t start, const char *label, size_t label_length);
+size_t render_chrome_trace(char *buffer, size_t buffer_size, int32_t game_id);
+
+static inline TraceSpan trace_begin(TraceEvent event) {
+    return (TraceSpan){ trace_current_game != 0 ? trace_clock() : 0, event };
+}
+
+static inline void trace_end(const TraceSpan *span, const char *label, size_t label_length) {
+    if (span->start != 0) {
+        trace_record(span->event, span->start, label, label_length);
+    }
+}
+
+static inline void trace_instant(TraceEvent event, const char *label, size_t label_length) {
+    if (trace_current_game != 0) {
+        trace_record(event, 0, label, label_length);
+    }
+}
+
+#endif
@@ -0,0 +1,790 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include "workers.h"
+#include "iobackend.h"
+#include "session.h"
+#include "gametable.h"
+#include "results.h"
+#include "metrics.h"
+#include "network.h"
+#include "matchmaking.h"
+#include "restart.h"
+#include "log.h"
+#include "slab.h"
+
+#define WORKER_CONTROL_TOKEN UINT32_MAX
+#define WORKER_GENERATION_SHIFT 16
+
+_Static_assert(sizeof(GameSession) <= 4 * SLAB_ALIGNMENT, "finished sessions should stay under 256 bytes");
+
+typedef struct {
+    pid_t pid;
+    int control_fd;
+    int active_games;
+    uint64_t idle_since_ns;
+    volatile sig_atomic_t exited;
+} GameWorker;
+
+static GameWorker workers[MAX_GAME_WORKERS];
+static worker_pool_config pool_limits = {
+    .min_workers = DEFAULT_MIN_WORKERS,
+    .max_workers = DEFAULT_MAX_WORKERS,
+    .heartbeat_interval_ms = DEFAULT_HEARTBEAT_INTERVAL_MS
+};
+static volatile sig_atomic_t worker_exit_pending = 0;
+static int worker_control_fd = -1;
+
+static int send_worker_message(int socket_fd, const WorkerMessage *message, const int *fds, int fd_count) {
+    struct iovec payload = { .iov_base = (void *)message, .iov_len = sizeof(*message) };
+    union {
+        char buffer[CMSG_SPACE(2 * sizeof(int))];
+        struct cmsghdr alignment;
+    } control;
+    struct msghdr header;
+    memset(&header, 0, sizeof(header));
+    header.msg_iov = &payload;
+    header.msg_iovlen = 1;
+
+    if (fd_count > 0) {
+        memset(&control, 0, sizeof(control));
+        header.msg_control = control.buffer;
+        header.msg_controllen = CMSG_SPACE((size_t)fd_count * sizeof(int));
+        struct cmsghdr *rights = CMSG_FIRSTHDR(&header);
+        rights->cmsg_level = SOL_SOCKET;
+        rights->cmsg_type = SCM_RIGHTS;
+        rights->cmsg_len = CMSG_LEN((size_t)fd_count * sizeof(int));
+        memcpy(CMSG_DATA(rights), fds, (size_t)fd_count * sizeof(int));
+    }
+
+    ssize_t bytes_sent;
+    do {
+        bytes_sent = sendmsg(socket_fd, &header, MSG_NOSIGNAL);
+    } while (bytes_sent < 0 && errno == EINTR);
+    return bytes_sent == (ssize_t)sizeof(*message) ? 0 : -1;
+}
+
+static ssize_t receive_worker_message(int socket_fd, WorkerMessage *message, int *fds, int *fd_count) {
+    struct iovec payload = { .iov_base = message, .iov_len = sizeof(*message) };
+    union {
+        char buffer[CMSG_SPACE(2 * sizeof(int))];
+        struct cmsghdr alignment;
+    } control;
+    struct msghdr header;
+    memset(&header, 0, sizeof(header));
+    header.msg_iov = &payload;
+    header.msg_iovlen = 1;
+    header.msg_control = control.buffer;
+    header.msg_controllen = sizeof(control.buffer);
+
+    *fd_count = 0;
+    ssize_t bytes_received = recvmsg(socket_fd, &header, MSG_CMSG_CLOEXEC | MSG_DONTWAIT);
+    if (bytes_received <= 0) {
+        return bytes_received;
+    }
+
+    for (struct cmsghdr *rights = CMSG_FIRSTHDR(&header); rights != NULL; rights = CMSG_NXTHDR(&header, rights)) {
+        if (rights->cmsg_level == SOL_SOCKET && rights->cmsg_type == SCM_RIGHTS) {
+            int count = (int)((rights->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+            if (count > 2) {
+                count = 2;
+            }
+            memcpy(fds, CMSG_DATA(rights), (size_t)count * sizeof(int));
+            *fd_count = count;
+        }
+    }
+    return bytes_received;
+}
+
+static void close_inherited_descriptors(int first_kept, int second_kept) {
+    int low = (first_kept < second_kept) ? first_kept : second_kept;
+    int high = (first_kept < second_kept) ? second_kept : first_kept;
+
+    if (low > STDERR_FILENO + 1) {
+        close_range(STDERR_FILENO + 1, (unsigned int)low - 1, 0);
+    }
+    if (high > low + 1) {
+        close_range((unsigned int)low + 1, (unsigned int)high - 1, 0);
+    }
+    close_range((unsigned int)high + 1, ~0U, 0);
+}
+
+static void forward_rank_query(const GameSession *session, Player player, const char *name) {
+    WorkerMessage message;
+    memset(&message, 0, sizeof(message));
+    message.type = WORKER_MESSAGE_RANK_QUERY;
+    message.game_id = session->result.game_id;
+    message.player = player;
+    snprintf(message.entry.name, sizeof(message.entry.name), "%s", name);
+
+    if (send_worker_message(worker_control_fd, &message, NULL, 0) < 0) {
+        answer_rank_query(session->sockets[player], NULL, 0);
+    }
+}
+
+typedef struct {
+    IoBackend *io;
+    Slab sessions;
+    uint16_t generations[WORKER_MAX_GAMES];
+    uint64_t rematch_deadline_ns;
+    uint64_t next_heartbeat_ns;
+} WorkerState;
+
+static GameSession *live_session(const WorkerState *state, uint32_t index) {
+    GameSession *session = slab_object(&state->sessions, index);
+    return (session != NULL && session->result.game_id != 0) ? session : NULL;
+}
+
+static GameSession *find_session(WorkerState *state, int game_id) {
+    for (uint32_t i = 0; i < state->sessions.carved; i++) {
+        GameSession *session = live_session(state, i);
+        if (session != NULL && session->result.game_id == game_id) {
+            return session;
+        }
+    }
+    return NULL;
+}
+
+static void retire_session(WorkerState *state, GameSession *session) {
+    for (int player = PLAYER_BLACK; player <= PLAYER_WHITE; player++) {
+        io_backend_close(state->io, session->sockets[player]);
+    }
+    release_game_session(session);
+    session->result.game_id = 0;
+    session->rematch_deadline_ns = 0;
+    state->generations[slab_index(&state->sessions, session)]++;
+    slab_free(&state->sessions, session);
+}
+
+static void abort_unstarted_game(int game_id, int slot) {
+    GameResult result = { .game_id = game_id, .slot = slot, .worker_pid = getpid(), .outcome = GAME_OUTCOME_ABORTED };
+    publish_game_result(&result);
+}
+
+static void note_rematch_window(WorkerState *state, const GameSession *session) {
+    uint64_t deadline_ns = session->rematch_deadline_ns;
+    if (session->finished && deadline_ns != 0 &&
+        (state->rematch_deadline_ns == 0 || deadline_ns < state->rematch_deadline_ns)) {
+        state->rematch_deadline_ns = deadline_ns;
+    }
+}
+
+static void expire_rematch_windows(WorkerState *state, uint64_t now_ns) {
+    state->rematch_deadline_ns = 0;
+    for (uint32_t i = 0; i < state->sessions.carved; i++) {
+        GameSession *session = live_session(state, i);
+        if (session == NULL || !session->finished || session->rematch_deadline_ns == 0) {
+            continue;
+        }
+        if (session->rematch_deadline_ns <= now_ns) {
+            close_rematch_window(session, "rematch_expired");
+            retire_session(state, session);
+        } else {
+            note_rematch_window(state, session);
+        }
+    }
+}
+
+static void close_finished_sessions(WorkerState *state) {
+    for (uint32_t i = 0; i < state->sessions.carved; i++) {
+        GameSession *session = live_session(state, i);
+        if (session != NULL && session->finished) {
+            close_rematch_window(session, "rematch_unavailable");
+            retire_session(state, session);
+        }
+    }
+    state->rematch_deadline_ns = 0;
+}
+
+static void send_heartbeats(WorkerState *state, uint64_t now_ns) {
+    uint64_t interval_ns = (uint64_t)pool_limits.heartbeat_interval_ms * 1000000ULL;
+    for (uint32_t i = 0; i < state->sessions.carved; i++) {
+        GameSession *session = live_session(state, i);
+        if (session != NULL &&
+            check_session_heartbeat(session, now_ns, interval_ns * HEARTBEAT_MISSED_LIMIT) == SESSION_CLOSED) {
+            retire_session(state, session);
+        }
+    }
+    state->next_heartbeat_ns = now_ns + interval_ns;
+}
+
+static uint64_t next_worker_deadline(const WorkerState *state) {
+    uint64_t deadline_ns = state->next_heartbeat_ns;
+    if (state->rematch_deadline_ns != 0 && (deadline_ns == 0 || state->rematch_deadline_ns < deadline_ns)) {
+        deadline_ns = state->rematch_deadline_ns;
+    }
+    return deadline_ns;
+}
+
+static void run_worker_timers(WorkerState *state) {
+    uint64_t now_ns = metrics_now_ns();
+    if (state->rematch_deadline_ns != 0 && state->rematch_deadline_ns <= now_ns) {
+        expire_rematch_windows(state, now_ns);
+    }
+    if (state->next_heartbeat_ns != 0 && state->next_heartbeat_ns <= now_ns) {
+        send_heartbeats(state, now_ns);
+    }
+}
+
+static int worker_wait_timeout_ms(const WorkerState *state) {
+    uint64_t deadline_ns = next_worker_deadline(state);
+    if (deadline_ns == 0) {
+        return -1;
+    }
+    uint64_t now_ns = metrics_now_ns();
+    if (deadline_ns <= now_ns) {
+        return 0;
+    }
+    return (int)((deadline_ns - now_ns + 999999ULL) / 1000000ULL);
+}
+
+static void request_rematch(WorkerState *state, GameSession *session) {
+    WorkerMessage message;
+    memset(&message, 0, sizeof(message));
+    message.type = WORKER_MESSAGE_REMATCH;
+    message.game_id = session->result.game_id;
+
+    if (send_worker_message(worker_control_fd, &message, NULL, 0) < 0) {
+        close_rematch_window(session, "server_busy");
+        retire_session(state, session);
+    }
+}
+
+static void start_rematch_session(WorkerState *state, const WorkerMessage *message) {
+    GameSession *session = find_session(state, message->game_id);
+    if (session == NULL || !session->finished || message->next_game_id <= 0) {
+        if (session != NULL && session->finished) {
+            close_rematch_window(session, "server_busy");
+            retire_session(state, session);
+        }
+        if (message->next_game_id > 0) {
+            abort_unstarted_game(message->next_game_id, message->slot);
+        }
+        return;
+    }
+
+    restart_game_session(session, message->next_game_id, message->slot);
+    if (!session_is_live(session)) {
+        retire_session(state, session);
+    } else {
+        note_rematch_window(state, session);
+    }
+}
+
+static void set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        LOG_WARN("socket_nonblocking_failed", LOG_INT("fd", fd), LOG_INT("errno", errno));
+    }
+}
+
+static void start_worker_session(WorkerState *state, const WorkerMessage *message, const int *fds) {
+    set_nonblocking(fds[0]);
+    set_nonblocking(fds[1]);
+    GameSession *session = slab_alloc(&state->sessions);
+    if (session == NULL) {
+        send_error_message(fds[0], "server_busy");
+        send_error_message(fds[1], "server_busy");
+        io_backend_close(state->io, fds[0]);
+        io_backend_close(state->io, fds[1]);
+        abort_unstarted_game(message->game_id, message->slot);
+        return;
+    }
+
+    uint32_t index = slab_index(&state->sessions, session);
+    start_game_session(session, message->game_id, message->slot, getpid(), message->flags, message->board_size,
+                       fds[0], fds[1]);
+    if (!session_is_live(session)) {
+        retire_session(state, session);
+        return;
+    }
+
+    for (int player = PLAYER_BLACK; player <= PLAYER_WHITE; player++) {
+        uint32_t token = ((uint32_t)state->generations[index] << WORKER_GENERATION_SHIFT) |
+                         ((uint32_t)index << 1) | (uint32_t)player;
+        if (io_backend_add_connection(state->io, session->sockets[player], token) < 0) {
+            LOG_WARN("session_watch_failed", LOG_INT("game_id", message->game_id),
+                     LOG_INT("fd", session->sockets[player]), LOG_INT("errno", errno));
+            abort_game_session(session, "server_busy");
+            retire_session(state, session);
+            return;
+        }
+    }
+    note_rematch_window(state, session);
+}
+
+static int handle_control_message(WorkerState *state) {
+    WorkerMessage message;
+    int fds[2];
+    int fd_count;
+
+    ssize_t bytes_received = receive_worker_message(worker_control_fd, &message, fds, &fd_count);
+    if (bytes_received < 0 && errno == EINTR) {
+        return 1;
+    }
+    if (bytes_received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return -1;
+    }
+    if (bytes_received <= 0) {
+        return 0;
+    }
+    if (bytes_received != (ssize_t)sizeof(message) ||
+        (message.type == WORKER_MESSAGE_START_GAME && fd_count != 2)) {
+        for (int i = 0; i < fd_count; i++) {
+            close(fds[i]);
+        }
+        return 1;
+    }
+
+    GameSession *session;
+    switch (message.type) {
+        case WORKER_MESSAGE_START_GAME:
+            start_worker_session(state, &message, fds);
+            break;
+        case WORKER_MESSAGE_STOP_GAME:
+            if ((session = find_session(state, message.game_id)) != NULL) {
+                if (session->finished) {
+                    close_rematch_window(session, "game_stopped");
+                } else {
+                    stop_game_session(session);
+                }
+                retire_session(state, session);
+            }
+            break;
+        case WORKER_MESSAGE_REMATCH:
+            start_rematch_session(state, &message);
+            break;
+        case WORKER_MESSAGE_RANK_REPLY:
+            if ((session = find_session(state, message.game_id)) != NULL &&
+                (message.player == PLAYER_BLACK || message.player == PLAYER_WHITE)) {
+                answer_rank_query(session->sockets[message.player], message.found ? &message.entry : NULL,
+                                  message.players);
+            }
+            break;
+        default:
+            break;
+    }
+    return 1;
+}
+
+static IoBackend *worker_io = NULL;
+
+static ssize_t send_through_worker_backend(int socket_fd, const char *message, size_t message_length) {
+    return io_backend_send(worker_io, socket_fd, message, message_length);
+}
+
+static void handle_session_event(WorkerState *state, const IoEvent *event) {
+    uint32_t index = (event->token & ((1U << WORKER_GENERATION_SHIFT) - 1)) >> 1;
+    if (index >= WORKER_MAX_GAMES || state->generations[index] != (uint16_t)(event->token >> WORKER_GENERATION_SHIFT)) {
+        return;
+    }
+
+    GameSession *session = live_session(state, index);
+    if (session == NULL) {
+        return;
+    }
+    Player player = (Player)((event->token & 1) ^ (uint32_t)session->swapped);
+    switch (handle_session_data(session, player, event->data, event->length)) {
+        case SESSION_CLOSED:
+            retire_session(state, session);
+            break;
+        case SESSION_REMATCH:
+            request_rematch(state, session);
+            break;
+        default:
+            note_rematch_window(state, session);
+            break;
+    }
+}
+
+static void run_game_worker(void) {
+    WorkerState state;
+    memset(&state, 0, sizeof(state));
+    state.io = create_io_backend();
+    if (slab_init(&state.sessions, sizeof(GameSession), WORKER_MAX_GAMES) < 0 ||
+        initialize_game_states(WORKER_MAX_GAMES) < 0 || state.io == NULL) {
+        LOG_ERROR("worker_setup_failed", LOG_INT("errno", errno));
+        _exit(EXIT_FAILURE);
+    }
+
+    worker_io = state.io;
+    set_message_sender(send_through_worker_backend);
+    set_rank_query_handler(forward_rank_query);
+    io_backend_watch_readable(state.io, worker_control_fd, WORKER_CONTROL_TOKEN);
+    if (pool_limits.heartbeat_interval_ms > 0) {
+        state.next_heartbeat_ns = metrics_now_ns() + (uint64_t)pool_limits.heartbeat_interval_ms * 1000000ULL;
+    }
+
+    int accepting = 1;
+    IoEvent events[WORKER_EVENT_BATCH];
+    while (accepting || state.sessions.in_use > 0) {
+        int ready = io_backend_wait(state.io, events, WORKER_EVENT_BATCH, worker_wait_timeout_ms(&state));
+        if (ready < 0) {
+            LOG_ERROR("worker_wait_failed", LOG_INT("errno", errno));
+            break;
+        }
+        if (next_worker_deadline(&state) != 0) {
+            run_worker_timers(&state);
+        }
+
+        for (int i = 0; i < ready; i++) {
+            if (events[i].type != IO_EVENT_READABLE) {
+                handle_session_event(&state, &events[i]);
+                continue;
+            }
+
+            if (!accepting) {
+                continue;
+            }
+            int status;
+            do {
+                status = handle_control_message(&state);
+            } while (status > 0);
+            if (status == 0) {
+                accepting = 0;
+                io_backend_remove(state.io, worker_control_fd);
+                close_finished_sessions(&state);
+            }
+        }
+    }
+
+    LOG_INFO("worker_exiting", LOG_INT("pid", getpid()));
+    destroy_io_backend(state.io);
+    _exit(EXIT_SUCCESS);
+}
+
+void configure_worker_pool(const worker_pool_config *config) {
+    pool_limits = *config;
+}
+
+static int is_live_worker(int index) {
+    return workers[index].pid > 0 && workers[index].control_fd >= 0 && !workers[index].exited;
+}
+
+int count_game_workers(void) {
+    int count = 0;
+    for (int i = 0; i < MAX_GAME_WORKERS; i++) {
+        count += is_live_worker(i);
+    }
+    return count;
+}
+
+static int spawn_worker(void) {
+    int index = -1;
+    for (int i = 0; i < MAX_GAME_WORKERS && index < 0; i++) {
+        if (workers[i].pid == 0) {
+            index = i;
+        }
+    }
+    if (index < 0) {
+        return -1;
+    }
+
+    int channel[2];
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, channel) < 0) {
+        LOG_ERROR("worker_socketpair_failed", LOG_INT("errno", errno));
+        return -1;
+    }
+
+    sigset_t reap_mask;
+    sigset_t previous_mask;
+    sigemptyset(&reap_mask);
+    sigaddset(&reap_mask, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &reap_mask, &previous_mask);
+
+    pid_t worker_pid = fork();
+    if (worker_pid < 0) {
+        sigprocmask(SIG_SETMASK, &previous_mask, NULL);
+        LOG_ERROR("fork_failed", LOG_INT("errno", errno));
+        close(channel[0]);
+        close(channel[1]);
+        return -1;
+    }
+
+    if (worker_pid == 0) {
+        sigprocmask(SIG_SETMASK, &previous_mask, NULL);
+        worker_control_fd = channel[1];
+        int results_writer = results_writer_fd();
+        close_inherited_descriptors(worker_control_fd, results_writer >= 0 ? results_writer : worker_control_fd);
+        metrics_attach_process();
+        run_game_worker();
+    }
+
+    close(channel[1]);
+    workers[index] = (GameWorker){
+        .pid = worker_pid,
+        .control_fd = channel[0],
+        .active_games = 0,
+        .idle_since_ns = metrics_now_ns(),
+        .exited = 0
+    };
+    sigprocmask(SIG_SETMASK, &previous_mask, NULL);
+
+    metrics_gauge_add(METRIC_GAME_WORKERS, 1);
+    LOG_INFO("worker_started", LOG_INT("worker_pid", worker_pid), LOG_INT("workers", count_game_workers()));
+    return index;
+}
+
+int start_worker_pool(void) {
+    while (count_game_workers() < pool_limits.min_workers) {
+        if (spawn_worker() < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int least_loaded_worker(void) {
+    int best = -1;
+    for (int i = 0; i < MAX_GAME_WORKERS; i++) {
+        if (is_live_worker(i) && (best < 0 || workers[i].active_games < workers[best].active_games)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+static int needs_more_workers(int best) {
+    return (best < 0 || workers[best].active_games >= WORKER_SPAWN_THRESHOLD) &&
+           count_game_workers() < pool_limits.max_workers;
+}
+
+int worker_pool_has_room(void) {
+    int index = least_loaded_worker();
+    return (index >= 0 && workers[index].active_games < WORKER_MAX_GAMES) ||
+           count_game_workers() < pool_limits.max_workers;
+}
+
+int dispatch_game(int game_id, int slot, int flags, int board_size, int black_socket, int white_socket) {
+    int index = least_loaded_worker();
+    if (needs_more_workers(index)) {
+        int spawned = spawn_worker();
+        if (spawned >= 0) {
+            index = spawned;
+        }
+    }
+    if (index < 0 || workers[index].active_games >= WORKER_MAX_GAMES) {
+        LOG_WARN("worker_pool_full", LOG_INT("game_id", game_id), LOG_INT("workers", count_game_workers()));
+        return -1;
+    }
+
+    WorkerMessage message;
+    memset(&message, 0, sizeof(message));
+    message.type = WORKER_MESSAGE_START_GAME;
+    message.game_id = game_id;
+    message.slot = slot;
+    message.flags = flags;
+    message.board_size = board_size;
+    int fds[2] = { black_socket, white_socket };
+
+    if (send_worker_message(workers[index].control_fd, &message, fds, 2) < 0) {
+        LOG_ERROR("worker_dispatch_failed", LOG_INT("worker_pid", workers[index].pid), LOG_INT("errno", errno));
+        return -1;
+    }
+
+    workers[index].active_games++;
+    assign_game_slot_process(slot, workers[index].pid);
+
+    if (needs_more_workers(least_loaded_worker())) {
+        spawn_worker();
+    }
+    return 0;
+}
+
+static GameWorker *find_worker(pid_t pid) {
+    for (int i = 0; i < MAX_GAME_WORKERS; i++) {
+        if (workers[i].pid == pid && pid > 0) {
+            return &workers[i];
+        }
+    }
+    return NULL;
+}
+
+void note_worker_game_finished(pid_t worker_pid) {
+    GameWorker *worker = find_worker(worker_pid);
+    if (worker == NULL || worker->active_games <= 0) {
+        return;
+    }
+    if (--worker->active_games == 0) {
+        worker->idle_since_ns = metrics_now_ns();
+    }
+}
+
+void note_worker_exited(pid_t pid) {
+    GameWorker *worker = find_worker(pid);
+    if (worker != NULL) {
+        worker->exited = 1;
+        worker_exit_pending = 1;
+    }
+}
+
+int game_workers_exited(void) {
+    return worker_exit_pending;
+}
+
+int reap_game_workers(void) {
+    int lost_games = 0;
+    worker_exit_pending = 0;
+
+    for (int i = 0; i < MAX_GAME_WORKERS; i++) {
+        if (workers[i].pid == 0 || !workers[i].exited) {
+            continue;
+        }
+        if (workers[i].active_games > 0) {
+            LOG_ERROR("worker_lost_games", LOG_INT("worker_pid", workers[i].pid),
+                      LOG_INT("games", workers[i].active_games));
+        }
+        if (workers[i].control_fd >= 0) {
+            close(workers[i].control_fd);
+            metrics_gauge_add(METRIC_GAME_WORKERS, -1);
+        }
+        lost_games += workers[i].active_games;
+        release_process_slots(workers[i].pid);
+        workers[i] = (GameWorker){ .pid = 0, .control_fd = -1 };
+    }
+    return lost_games;
+}
+
+static int retirable_worker(uint64_t now_ns, uint64_t *retire_at_ns) {
+    uint64_t idle_limit_ns = (uint64_t)WORKER_IDLE_RETIRE_SECONDS * 1000000000ULL;
+    int candidate = -1;
+
+    if (count_game_workers() <= pool_limits.min_workers) {
+        return -1;
+    }
+    for (int i = 0; i < MAX_GAME_WORKERS; i++) {
+        if (!is_live_worker(i) || workers[i].active_games > 0) {
+            continue;
+        }
+        if (candidate < 0 || workers[i].idle_since_ns < workers[candidate].idle_since_ns) {
+            candidate = i;
+        }
+    }
+    if (candidate >= 0) {
+        *retire_at_ns = workers[candidate].idle_since_ns + idle_limit_ns;
+        if (*retire_at_ns < now_ns) {
+            *retire_at_ns = now_ns;
+        }
+    }
+    return candidate;
+}
+
+int worker_pool_timeout_ms(uint64_t now_ns) {
+    uint64_t retire_at_ns;
+    if (retirable_worker(now_ns, &retire_at_ns) < 0) {
+        return -1;
+    }
+    return (int)((retire_at_ns - now_ns + 999999ULL) / 1000000ULL);
+}
+
+void maintain_worker_pool(uint64_t now_ns) {
+    uint64_t retire_at_ns;
+    int index;
+
+    while ((index = retirable_worker(now_ns, &retire_at_ns)) >= 0 && retire_at_ns <= now_ns) {
+        LOG_INFO("worker_retired", LOG_INT("worker_pid", workers[index].pid));
+        close(workers[index].control_fd);
+        workers[index].control_fd = -1;
+        metrics_gauge_add(METRIC_GAME_WORKERS, -1);
+    }
+
+    if (count_game_workers() < pool_limits.min_workers) {
+        start_worker_pool();
+    }
+}
+
+int collect_worker_fds(struct pollfd *fds, int max_fds) {
+    int count = 0;
+    for (int i = 0; i < MAX_GAME_WORKERS && count < max_fds; i++) {
+        if (is_live_worker(i)) {
+            fds[count].fd = workers[i].control_fd;
+            fds[count].events = POLLIN;
+            fds[count].revents = 0;
+            count++;
+        }
+    }
+    return count;
+}
+
+static void answer_rematch_request(int control_fd, WorkerMessage *message) {
+    GameWorker *worker = NULL;
+    for (int i = 0; i < MAX_GAME_WORKERS; i++) {
+        if (is_live_worker(i) && workers[i].control_fd == control_fd) {
+            worker = &workers[i];
+        }
+    }
+
+    message->next_game_id = 0;
+    if (worker != NULL && !restart_requested()) {
+        message->next_game_id = start_rematch(message->game_id, &message->slot);
+    }
+    if (message->next_game_id > 0) {
+        worker->active_games++;
+        assign_game_slot_process(message->slot, worker->pid);
+    }
+    send_worker_message(control_fd, message, NULL, 0);
+}
+
+static void answer_worker_request(int control_fd) {
+    WorkerMessage message;
+    int fds[2];
+    int fd_count;
+
+    ssize_t bytes_received = receive_worker_message(control_fd, &message, fds, &fd_count);
+    for (int i = 0; i < fd_count; i++) {
+        close(fds[i]);
+    }
+    if (bytes_received == (ssize_t)sizeof(message) && message.type == WORKER_MESSAGE_REMATCH) {
+        answer_rematch_request(control_fd, &message);
+        return;
+    }
+    if (bytes_received != (ssize_t)sizeof(message) || message.type != WORKER_MESSAGE_RANK_QUERY) {
+        return;
+    }
+
+    char name[PLAYER_NAME_LENGTH];
+    memcpy(name, message.entry.name, sizeof(name));
+    name[sizeof(name) - 1] = '\0';
+
+    message.type = WORKER_MESSAGE_RANK_REPLY;
+    message.found = leaderboard_lookup(name, &message.entry) == 0;
+    message.players = leaderboard_size();
+    send_worker_message(control_fd, &message, NULL, 0);
+}
+
+void handle_worker_requests(const struct pollfd *fds, int count) {
+    for (int i = 0; i < count; i++) {
+        if (fds[i].revents & POLLIN) {
+            answer_worker_request(fds[i].fd);
+        }
+    }
+}
+
+int stop_pooled_game(int game_id) {
+    pid_t worker_pid = find_game_process(game_id);
+    GameWorker *worker = find_worker(worker_pid);
+    if (worker == NULL || worker->control_fd < 0) {
+        return -1;
+    }
+
+    WorkerMessage message;
+    memset(&message, 0, sizeof(message));
+    message.type = WORKER_MESSAGE_STOP_GAME;
+    message.game_id = game_id;
+    return send_worker_message(worker->control_fd, &message, NULL, 0);
+}
+
+void shutdown_worker_pool(void) {
+    for (int i = 0; i < MAX_GAME_WORKERS; i++) {
+        if (workers[i].pid > 0 && workers[i].control_fd >= 0) {
+            close(workers[i].control_fd);
+            workers[i].control_fd = -1;
+            metrics_gauge_add(METRIC_GAME_WORKERS, -1);
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef WORKERS_H
+#define WORKERS_H
+
+#include <stdint.h>
+#include <poll.h>
+#include <sys/types.h>
+#include "leaderboard.h"
+
+#define MAX_GAME_WORKERS 64
+#define DEFAULT_MIN_WORKERS 2
+#define DEFAULT_MAX_WORKERS 16
+#define WORKER_MAX_GAMES 256
+#define WORKER_SPAWN_THRESHOLD 64
+#define WORKER_IDLE_RETIRE_SECONDS 30
+#define WORKER_EVENT_BATCH 64
+#define DEFAULT_HEARTBEAT_INTERVAL_MS 5000
+#define HEARTBEAT_MISSED_LIMIT 3
+
+typedef enum {
+    WORKER_MESSAGE_START_GAME,
+    WORKER_MESSAGE_STOP_GAME,
+    WORKER_MESSAGE_RANK_QUERY,
+    WORKER_MESSAGE_RANK_REPLY,
+    WORKER_MESSAGE_REMATCH
+} WorkerMessageType;
+
+typedef struct {
+    int32_t type;
+    int32_t game_id;
+    int32_t slot;
+    int32_t flags;
+    int32_t board_size;
+    int32_t player;
+    int32_t found;
+    int32_t players;
+    int32_t next_game_id;
+    LeaderboardEntry entry;
+} WorkerMessage;
+
+typedef struct {
+    int min_workers;
+    int max_workers;
+    int heartbeat_interval_ms;
+} worker_pool_config;
+
+void configure_worker_pool(const worker_pool_config *config);
+int start_worker_pool(void);
+int dispatch_game(int game_id, int slot, int flags, int board_size, int black_socket, int white_socket);
+void note_worker_game_finished(pid_t worker_pid);
+void note_worker_exited(pid_t pid);
+int game_workers_exited(void);
+int reap_game_workers(void);
+int worker_pool_timeout_ms(uint64_t now_ns);
+void maintain_worker_pool(uint64_t now_ns);
+int collect_worker_fds(struct pollfd *fds, int max_fds);
+void handle_worker_requests(const struct pollfd *fds, int count);
+int stop_pooled_game(int game_id);
+int count_game_workers(void);
+int worker_pool_has_room(void);
+void shutdown_worker_pool(void);
+
+#endif
@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "../../common/message.h"
+#include "../../client/network.h"
+#include "../../server/network.h"
+#include "../../server/game.h"
+
+#define DEFAULT_ITERATIONS 2000000
+
+typedef size_t (*EncodeFunction)(char *buffer, size_t buffer_size);
+
+typedef struct {
+    const char *name;
+    EncodeFunction encode;
+    const char *line;
+} CodecCase;
+
+static GameState bench_game;
+static volatile size_t sink;
+
+static size_t encode_move(char *buffer, size_t buffer_size) {
+    return format_move_message(buffer, buffer_size, 3, 4);
+}
+
+static size_t encode_pass(char *buffer, size_t buffer_size) {
+    return format_pass_message(buffer, buffer_size);
+}
+
+static size_t encode_welcome(char *buffer, size_t buffer_size) {
+    return format_welcome_message(buffer, buffer_size, COLOR_BLACK);
+}
+
+static size_t encode_board(char *buffer, size_t buffer_size) {
+    return format_board_message(buffer, buffer_size, &bench_game);
+}
+
+static size_t encode_your_turn(char *buffer, size_t buffer_size) {
+    return format_your_turn_message(buffer, buffer_size);
+}
+
+static size_t encode_valid(char *buffer, size_t buffer_size) {
+    return format_valid_message(buffer, buffer_size);
+}
+
+static size_t encode_invalid(char *buffer, size_t buffer_size) {
+    return format_invalid_message(buffer, buffer_size, "occupied");
+}
+
+static size_t encode_opponent_move(char *buffer, size_t buffer_size) {
+    return format_opponent_move_message(buffer, buffer_size, 2, 3);
+}
+
+static size_t encode_game_over(char *buffer, size_t buffer_size) {
+    return format_game_over_message(buffer, buffer_size, "WIN", COLOR_BLACK, 40, 24);
+}
+
+static size_t decode_line(char *line) {
+    ParsedMessage message;
+    const char *text;
+    const char *winner;
+    int row;
+    int col;
+
+    if (tokenize_message(line, &message) < 0) {
+        return 0;
+    }
+
+    switch (message.type) {
+        case MESSAGE_TYPE_MOVE:
+        case MESSAGE_TYPE_OPPONENT_MOVE:
+            return parse_opponent_move_message(&message, &row, &col) == 0 ? (size_t)(row * 8 + col) : 0;
+        case MESSAGE_TYPE_BOARD:
+            text = parse_board_message(&message, &row);
+            return text != NULL ? (size_t)text[27] : 0;
+        case MESSAGE_TYPE_GAME_OVER:
+            return parse_game_over_message(&message, &text, &winner, &row, &col) == 0 ? (size_t)(row + col) : 0;
+        default:
+            text = message_field(&message, 0);
+            return (size_t)message.type + (text != NULL ? (size_t)text[0] : 0);
+    }
+}
+
+static double elapsed_seconds(const struct timespec *start, const struct timespec *end) {
+    return (double)(end->tv_sec - start->tv_sec) + (double)(end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void run_case(const CodecCase *codec_case, long iterations) {
+    char buffer[MAX_MESSAGE_LENGTH];
+    char scratch[MAX_MESSAGE_LENGTH];
+    size_t line_length = strlen(codec_case->line);
+    struct timespec start;
+    struct timespec end;
+    size_t total = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (long i = 0; i < iterations; i++) {
+        total += codec_case->encode(buffer, sizeof(buffer));
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double encode_seconds = elapsed_seconds(&start, &end);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (long i = 0; i < iterations; i++) {
+        memcpy(scratch, codec_case->line, line_length + 1);
+        total += decode_line(scratch);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double decode_seconds = elapsed_seconds(&start, &end);
+
+    sink = total;
+    printf("%-14s encode %12.0f msg/s %8.1f ns   decode %12.0f msg/s %8.1f ns\n",
+           codec_case->name,
+           (double)iterations / encode_seconds, encode_seconds * 1e9 / (double)iterations,
+           (double)iterations / decode_seconds, decode_seconds * 1e9 / (double)iterations);
+}
+
+int main(int argc, char *argv[]) {
+    long iterations = DEFAULT_ITERATIONS;
+    if (argc > 1) {
+        iterations = strtol(argv[1], NULL, 10);
+        if (iterations <= 0) {
+            fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    initialize_game(&bench_game);
+
+    const CodecCase cases[] = {
+        { "MOVE", encode_move, "MOVE|3|4\n" },
+        { "PASS", encode_pass, "PASS\n" },
+        { "WELCOME", encode_welcome, "WELCOME|BLACK\n" },
+        { "BOARD", encode_board,
+          "BOARD|8|8|...........................WB......BW...........................\n" },
+        { "YOUR_TURN", encode_your_turn, "YOUR_TURN\n" },
+        { "VALID", encode_valid, "VALID\n" },
+        { "INVALID", encode_invalid, "INVALID|occupied\n" },
+        { "OPPONENT_MOVE", encode_opponent_move, "OPPONENT_MOVE|2|3\n" },
+        { "GAME_OVER", encode_game_over, "GAME_OVER|WIN|BLACK|40|24\n" }
+    };
+
+    printf("=== Codec Benchmark (%ld iterations per case) ===\n\n", iterations);
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        run_case(&cases[i], iterations);
+    }
+    return 0;
+}
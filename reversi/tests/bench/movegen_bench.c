@@ -0,0 +1,137 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "../../lib/reversi.h"
+
+#define BENCH_POSITIONS 4096
+#define DEFAULT_ROUNDS 2000
+
+static ReversiGame *games[BENCH_POSITIONS];
+static uint64_t players[BENCH_POSITIONS];
+static uint64_t opponents[BENCH_POSITIONS];
+static uint8_t squares[BENCH_POSITIONS];
+static volatile uint64_t sink;
+
+static double elapsed_seconds(const struct timespec *start, const struct timespec *end) {
+    return (double)(end->tv_sec - start->tv_sec) + (double)(end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void collect_positions(void) {
+    ReversiGame *game = reversi_create(REVERSI_BITBOARD_SIZE);
+    srand(7);
+
+    for (int i = 0; i < BENCH_POSITIONS; i++) {
+        int moves[REVERSI_MAX_SQUARES];
+        int count;
+        while ((count = reversi_legal_moves(game, moves, REVERSI_MAX_SQUARES)) == 0) {
+            if (reversi_pass(game) < 0) {
+                reversi_destroy(game);
+                game = reversi_create(REVERSI_BITBOARD_SIZE);
+            }
+        }
+
+        games[i] = reversi_clone(game);
+        reversi_to_bitboards(game, &players[i], &opponents[i]);
+        squares[i] = (uint8_t)moves[rand() % count];
+        int square = moves[rand() % count];
+        reversi_apply_move(game, square / 8, square % 8);
+    }
+    reversi_destroy(game);
+}
+
+static void report(const char *name, long rounds, double legal_seconds, double apply_seconds) {
+    double positions = (double)rounds * BENCH_POSITIONS;
+    printf("%-8s legal %12.0f pos/s %7.1f ns   apply %12.0f pos/s %7.1f ns\n", name,
+           positions / legal_seconds, legal_seconds * 1e9 / positions,
+           positions / apply_seconds, apply_seconds * 1e9 / positions);
+}
+
+static void run_engine(long rounds) {
+    struct timespec start;
+    struct timespec end;
+    uint64_t total = 0;
+    long engine_rounds = rounds / 100 > 0 ? rounds / 100 : 1;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (long round = 0; round < engine_rounds; round++) {
+        for (int i = 0; i < BENCH_POSITIONS; i++) {
+            int moves[REVERSI_MAX_SQUARES];
+            total += (uint64_t)reversi_legal_moves(games[i], moves, REVERSI_MAX_SQUARES);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double legal_seconds = elapsed_seconds(&start, &end);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (long round = 0; round < engine_rounds; round++) {
+        for (int i = 0; i < BENCH_POSITIONS; i++) {
+            reversi_apply_move(games[i], squares[i] / 8, squares[i] % 8);
+            reversi_undo(games[i]);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    sink = total;
+    report("engine", engine_rounds, legal_seconds, elapsed_seconds(&start, &end));
+}
+
+static void run_batch(const char *name, long rounds) {
+    static uint64_t results[BENCH_POSITIONS];
+    static uint64_t player_copy[BENCH_POSITIONS];
+    static uint64_t opponent_copy[BENCH_POSITIONS];
+    ReversiBoardBatch batch = { players, opponents, BENCH_POSITIONS };
+    ReversiBoardBatch scratch = { player_copy, opponent_copy, BENCH_POSITIONS };
+    struct timespec start;
+    struct timespec end;
+    uint64_t total = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (long round = 0; round < rounds; round++) {
+        reversi_batch_legal_moves(&batch, results);
+        total += results[round % BENCH_POSITIONS];
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double legal_seconds = elapsed_seconds(&start, &end);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (long round = 0; round < rounds; round++) {
+        memcpy(player_copy, players, sizeof(players));
+        memcpy(opponent_copy, opponents, sizeof(opponents));
+        total += reversi_batch_apply(&scratch, squares, results);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    sink = total;
+    report(name, rounds, legal_seconds, elapsed_seconds(&start, &end));
+}
+
+int main(int argc, char *argv[]) {
+    static const char *isa_names[] = { "scalar", "avx2", "avx512" };
+    long rounds = DEFAULT_ROUNDS;
+    if (argc > 1) {
+        rounds = strtol(argv[1], NULL, 10);
+        if (rounds <= 0) {
+            fprintf(stderr, "Usage: %s [rounds]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    collect_positions();
+    ReversiBatchIsa detected = reversi_batch_isa();
+    printf("=== Move Generation Benchmark (%d positions, runtime ISA %s) ===\n\n", BENCH_POSITIONS,
+           isa_names[detected]);
+
+    run_engine(rounds);
+    for (ReversiBatchIsa isa = REVERSI_BATCH_SCALAR; isa <= REVERSI_BATCH_AVX512; isa++) {
+        if (reversi_batch_use_isa(isa) == 0) {
+            run_batch(isa_names[isa], rounds);
+        }
+    }
+
+    for (int i = 0; i < BENCH_POSITIONS; i++) {
+        reversi_destroy(games[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,455 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <time.h>
+#include "../../common/message.h"
+#include "../../client/network.h"
+#include "../../server/network.h"
+#include "../../server/game.h"
+
+#define BENCH_POSITIONS 256
+#define BENCH_MAX_CASES 32
+#define BENCH_MAX_SAMPLES 101
+#define BENCH_NAME_LENGTH 64
+#define DEFAULT_SAMPLES 15
+#define DEFAULT_SAMPLE_NS 5000000ULL
+#define DEFAULT_THRESHOLD_PERCENT 10.0
+#define NOISE_FACTOR 3.0
+#define ABSOLUTE_SLACK_NS 0.5
+#define CONFIRM_RUNS 3
+
+typedef uint64_t (*BenchFunction)(long iterations);
+
+typedef struct {
+    const char *name;
+    BenchFunction run;
+} BenchCase;
+
+typedef struct {
+    char name[BENCH_NAME_LENGTH];
+    double ns_per_op;
+    double mad_ns;
+    double min_ns;
+    long iterations;
+} BenchResult;
+
+typedef struct {
+    GameState game;
+    int move_row;
+    int move_col;
+} BenchPosition;
+
+static BenchPosition positions[BENCH_POSITIONS];
+static volatile uint64_t sink;
+
+static const char *const BOARD_LINE =
+    "BOARD|8|8|...........................WB......BW...........................\n";
+static const char *const GAME_OVER_LINE = "GAME_OVER|WIN|BLACK|40|24\n";
+static const char *const OPPONENT_MOVE_LINE = "OPPONENT_MOVE|2|3\n";
+static const char *const MOVE_LINE = "MOVE|3|4\n";
+
+static uint64_t now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+static void collect_positions(void) {
+    GameState game;
+    initialize_game(&game);
+    srand(7);
+
+    for (int i = 0; i < BENCH_POSITIONS; i++) {
+        int moves[BOARD_MAX_CELLS];
+        int count;
+        for (;;) {
+            count = 0;
+            for (int square = 0; square < game.size * game.size; square++) {
+                if (is_valid_move(&game, square / game.size, square % game.size)) {
+                    moves[count++] = square;
+                }
+            }
+            if (count > 0) {
+                break;
+            }
+            if (is_game_over(&game)) {
+                initialize_game(&game);
+            } else {
+                pass_turn(&game);
+            }
+        }
+
+        int square = moves[rand() % count];
+        positions[i].game = game;
+        positions[i].move_row = square / game.size;
+        positions[i].move_col = square % game.size;
+        square = moves[rand() % count];
+        execute_move(&game, square / game.size, square % game.size);
+    }
+}
+
+static uint64_t bench_is_valid_move(long iterations) {
+    uint64_t total = 0;
+    for (long i = 0; i < iterations; i++) {
+        const GameState *game = &positions[i % BENCH_POSITIONS].game;
+        total += is_valid_move(game, (int)(i >> 3) & 7, (int)i & 7);
+    }
+    return total;
+}
+
+static uint64_t bench_execute_move(long iterations) {
+    uint64_t total = 0;
+    for (long i = 0; i < iterations; i++) {
+        BenchPosition *position = &positions[i % BENCH_POSITIONS];
+        total += execute_move(&position->game, position->move_row, position->move_col);
+        undo_move(&position->game);
+    }
+    return total;
+}
+
+static uint64_t bench_has_legal_moves(long iterations) {
+    uint64_t total = 0;
+    for (long i = 0; i < iterations; i++) {
+        const GameState *game = &positions[i % BENCH_POSITIONS].game;
+        total += has_legal_moves(game, game->current_player);
+    }
+    return total;
+}
+
+static uint64_t bench_count_pieces(long iterations) {
+    uint64_t total = 0;
+    for (long i = 0; i < iterations; i++) {
+        int black_count, white_count;
+        count_pieces(&positions[i % BENCH_POSITIONS].game, &black_count, &white_count);
+        total += (uint64_t)(black_count + white_count);
+    }
+    return total;
+}
+
+static uint64_t bench_format_board(long iterations) {
+    char buffer[MAX_MESSAGE_LENGTH];
+    uint64_t total = 0;
+    for (long i = 0; i < iterations; i++) {
+        total += format_board_message(buffer, sizeof(buffer), &positions[i % BENCH_POSITIONS].game);
+    }
+    return total;
+}
+
+static uint64_t bench_format_opponent_move(long iterations) {
+    char buffer[MAX_MESSAGE_LENGTH];
+    uint64_t total = 0;
+    for (long i = 0; i < iterations; i++) {
+        total += format_opponent_move_message(buffer, sizeof(buffer), (int)(i >> 3) & 7, (int)i & 7);
+    }
+    return total;
+}
+
+static uint64_t bench_format_game_over(long iterations) {
+    char buffer[MAX_MESSAGE_LENGTH];
+    uint64_t total = 0;
+    for (long i = 0; i < iterations; i++) {
+        total += format_game_over_message(buffer, sizeof(buffer), "WIN", COLOR_BLACK, (int)i & 63, 24);
+    }
+    return total;
+}
+
+static uint64_t bench_format_move(long iterations) {
+    char buffer[MAX_MESSAGE_LENGTH];
+    uint64_t total = 0;
+    for (long i = 0; i < iterations; i++) {
+        total += format_move_message(buffer, sizeof(buffer), (int)(i >> 3) & 7, (int)i & 7);
+    }
+    return total;
+}
+
+static uint64_t bench_parse_move(long iterations) {
+    char line[MAX_MESSAGE_LENGTH];
+    size_t length = strlen(MOVE_LINE) + 1;
+    uint64_t total = 0;
+    for (long i = 0; i < iterations; i++) {
+        ParsedMessage message;
+        int row, col;
+        memcpy(line, MOVE_LINE, length);
+        if (tokenize_message(line, &message) == 0 && parse_message_coordinates(&message, &row, &col) == 0) {
+            total += (uint64_t)(row * 8 + col);
+        }
+    }
+    return total;
+}
+
+static uint64_t bench_parse_board(long iterations) {
+    char line[MAX_MESSAGE_LENGTH];
+    size_t length = strlen(BOARD_LINE) + 1;
+    uint64_t total = 0;
+    for (long i = 0; i < iterations; i++) {
+        ParsedMessage message;
+        int size;
+        memcpy(line, BOARD_LINE, length);
+        if (tokenize_message(line, &message) == 0) {
+            const char *cells = parse_board_message(&message, &size);
+            total += cells != NULL ? (uint64_t)cells[27] : 0;
+        }
+    }
+    return total;
+}
+
+static uint64_t bench_parse_opponent_move(long iterations) {
+    char line[MAX_MESSAGE_LENGTH];
+    size_t length = strlen(OPPONENT_MOVE_LINE) + 1;
+    uint64_t total = 0;
+    for (long i = 0; i < iterations; i++) {
+        ParsedMessage message;
+        int row, col;
+        memcpy(line, OPPONENT_MOVE_LINE, length);
+        if (tokenize_message(line, &message) == 0 && parse_opponent_move_message(&message, &row, &col) == 0) {
+            total += (uint64_t)(row * 8 + col);
+        }
+    }
+    return total;
+}
+
+static uint64_t bench_parse_game_over(long iterations) {
+    char line[MAX_MESSAGE_LENGTH];
+    size_t length = strlen(GAME_OVER_LINE) + 1;
+    uint64_t total = 0;
+    for (long i = 0; i < iterations; i++) {
+        ParsedMessage message;
+        const char *result, *winner;
+        int black_count, white_count;
+        memcpy(line, GAME_OVER_LINE, length);
+        if (tokenize_message(line, &message) == 0 &&
+            parse_game_over_message(&message, &result, &winner, &black_count, &white_count) == 0) {
+            total += (uint64_t)(black_count + white_count);
+        }
+    }
+    return total;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double left = *(const double *)a;
+    double right = *(const double *)b;
+    return (left > right) - (left < right);
+}
+
+static double median(double *values, int count) {
+    qsort(values, (size_t)count, sizeof(double), compare_doubles);
+    return (count % 2 != 0) ? values[count / 2] : (values[count / 2 - 1] + values[count / 2]) / 2.0;
+}
+
+static double time_run(BenchFunction run, long iterations) {
+    uint64_t start = now_ns();
+    sink = run(iterations);
+    return (double)(now_ns() - start);
+}
+
+static void measure(const BenchCase *bench_case, int samples, BenchResult *result) {
+    double sample_ns[BENCH_MAX_SAMPLES];
+    double deviations[BENCH_MAX_SAMPLES];
+    long iterations = 1;
+
+    while (time_run(bench_case->run, iterations) < (double)DEFAULT_SAMPLE_NS && iterations < (1L << 40)) {
+        iterations *= 2;
+    }
+
+    for (int i = 0; i < samples; i++) {
+        sample_ns[i] = time_run(bench_case->run, iterations) / (double)iterations;
+    }
+
+    snprintf(result->name, sizeof(result->name), "%s", bench_case->name);
+    result->iterations = iterations;
+    result->ns_per_op = median(sample_ns, samples);
+    result->min_ns = sample_ns[0];
+    for (int i = 0; i < samples; i++) {
+        deviations[i] = sample_ns[i] > result->ns_per_op ? sample_ns[i] - result->ns_per_op
+                                                         : result->ns_per_op - sample_ns[i];
+    }
+    result->mad_ns = median(deviations, samples);
+}
+
+static int write_results(const char *path, const BenchResult *results, int count, int samples) {
+    FILE *output = fopen(path, "w");
+    if (output == NULL) {
+        perror("bench output");
+        return -1;
+    }
+
+    fprintf(output, "{\n  \"suite\": \"reversi\",\n  \"samples\": %d,\n  \"benchmarks\": [\n", samples);
+    for (int i = 0; i < count; i++) {
+        fprintf(output,
+                "    {\"name\": \"%s\", \"ns_per_op\": %.3f, \"mad_ns\": %.3f, \"min_ns\": %.3f, \"iterations\": %ld}%s\n",
+                results[i].name, results[i].ns_per_op, results[i].mad_ns, results[i].min_ns,
+                results[i].iterations, i + 1 < count ? "," : "");
+    }
+    fprintf(output, "  ]\n}\n");
+    return fclose(output);
+}
+
+static int json_number(const char *line, const char *key, double *value) {
+    const char *field = strstr(line, key);
+    if (field == NULL) {
+        return -1;
+    }
+    char *end;
+    *value = strtod(field + strlen(key), &end);
+    return end == field + strlen(key) ? -1 : 0;
+}
+
+static int read_results(const char *path, BenchResult *results, int capacity) {
+    FILE *input = fopen(path, "r");
+    if (input == NULL) {
+        return -1;
+    }
+
+    char line[512];
+    int count = 0;
+    while (count < capacity && fgets(line, sizeof(line), input) != NULL) {
+        BenchResult *result = &results[count];
+        const char *name = strstr(line, "\"name\": \"");
+        if (name == NULL || sscanf(name, "\"name\": \"%63[^\"]\"", result->name) != 1 ||
+            json_number(line, "\"ns_per_op\": ", &result->ns_per_op) < 0 ||
+            json_number(line, "\"mad_ns\": ", &result->mad_ns) < 0) {
+            continue;
+        }
+        count++;
+    }
+    fclose(input);
+    return count;
+}
+
+static const BenchResult *find_result(const BenchResult *results, int count, const char *name) {
+    for (int i = 0; i < count; i++) {
+        if (strcmp(results[i].name, name) == 0) {
+            return &results[i];
+        }
+    }
+    return NULL;
+}
+
+static double allowed_slowdown_ns(const BenchResult *previous, const BenchResult *current, double threshold) {
+    double noise = previous->mad_ns / previous->ns_per_op + current->mad_ns / current->ns_per_op;
+    double allowed = NOISE_FACTOR * noise > threshold / 100.0 ? NOISE_FACTOR * noise : threshold / 100.0;
+    return previous->ns_per_op * allowed + ABSOLUTE_SLACK_NS;
+}
+
+static int compare_with_baseline(const char *path, const BenchCase *cases, BenchResult *results, int count,
+                                 int samples, double threshold) {
+    BenchResult baseline[BENCH_MAX_CASES];
+    int baseline_count = read_results(path, baseline, BENCH_MAX_CASES);
+    if (baseline_count < 0) {
+        printf("\nNo baseline at %s; run `make bench-baseline` to record one\n", path);
+        return 0;
+    }
+
+    int regressions = 0;
+    printf("\n%-22s %10s %10s %8s %8s  %s\n", "benchmark", "baseline", "current", "delta", "allowed", "status");
+    for (int i = 0; i < count; i++) {
+        const BenchResult *previous = find_result(baseline, baseline_count, results[i].name);
+        if (previous == NULL || previous->ns_per_op <= 0.0) {
+            printf("%-22s %10s %10.2f %8s %8s  new\n", results[i].name, "-", results[i].ns_per_op, "-", "-");
+            continue;
+        }
+
+        for (int retry = 0; retry < CONFIRM_RUNS &&
+             results[i].ns_per_op - previous->ns_per_op > allowed_slowdown_ns(previous, &results[i], threshold);
+             retry++) {
+            BenchResult confirmation;
+            measure(&cases[i], samples, &confirmation);
+            if (confirmation.ns_per_op < results[i].ns_per_op) {
+                results[i] = confirmation;
+            }
+        }
+
+        double allowed_ns = allowed_slowdown_ns(previous, &results[i], threshold);
+        double delta_ns = results[i].ns_per_op - previous->ns_per_op;
+        const char *status = "ok";
+        if (delta_ns > allowed_ns) {
+            status = "REGRESSED";
+            regressions++;
+        } else if (-delta_ns > allowed_ns) {
+            status = "improved";
+        }
+
+        printf("%-22s %10.2f %10.2f %+7.1f%% %7.1f%%  %s\n", results[i].name, previous->ns_per_op,
+               results[i].ns_per_op, delta_ns * 100.0 / previous->ns_per_op,
+               allowed_ns * 100.0 / previous->ns_per_op, status);
+    }
+
+    if (regressions > 0) {
+        printf("\n%d benchmark(s) regressed against %s\n", regressions, path);
+        return -1;
+    }
+    printf("\nNo regressions against %s\n", path);
+    return 0;
+}
+
+static void usage(const char *program) {
+    fprintf(stderr, "Usage: %s [-o results.json] [-b baseline.json] [-s samples] [-t threshold_percent]\n", program);
+}
+
+int main(int argc, char *argv[]) {
+    const char *output_path = NULL;
+    const char *baseline_path = NULL;
+    int samples = DEFAULT_SAMPLES;
+    double threshold = DEFAULT_THRESHOLD_PERCENT;
+    int option;
+
+    while ((option = getopt(argc, argv, "o:b:s:t:")) != -1) {
+        switch (option) {
+            case 'o':
+                output_path = optarg;
+                break;
+            case 'b':
+                baseline_path = optarg;
+                break;
+            case 's':
+                samples = atoi(optarg);
+                break;
+            case 't':
+                threshold = strtod(optarg, NULL);
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (samples < 3 || samples > BENCH_MAX_SAMPLES || threshold < 0.0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    const BenchCase cases[] = {
+        { "is_valid_move", bench_is_valid_move },
+        { "execute_move_undo", bench_execute_move },
+        { "has_legal_moves", bench_has_legal_moves },
+        { "count_pieces", bench_count_pieces },
+        { "format_board", bench_format_board },
+        { "format_opponent_move", bench_format_opponent_move },
+        { "format_game_over", bench_format_game_over },
+        { "format_move", bench_format_move },
+        { "parse_move", bench_parse_move },
+        { "parse_board", bench_parse_board },
+        { "parse_opponent_move", bench_parse_opponent_move },
+        { "parse_game_over", bench_parse_game_over }
+    };
+    int count = (int)(sizeof(cases) / sizeof(cases[0]));
+    BenchResult results[BENCH_MAX_CASES];
+
+    collect_positions();
+    printf("=== Benchmark Suite (%d samples per case, median ns/op) ===\n\n", samples);
+    for (int i = 0; i < count; i++) {
+        measure(&cases[i], samples, &results[i]);
+        printf("%-22s %10.2f ns/op  mad %6.2f ns  min %8.2f ns\n", results[i].name, results[i].ns_per_op,
+               results[i].mad_ns, results[i].min_ns);
+    }
+
+    int status = 0;
+    if (baseline_path != NULL && compare_with_baseline(baseline_path, cases, results, count, samples, threshold) < 0) {
+        status = 1;
+    }
+    if (output_path != NULL && write_results(output_path, results, count, samples) < 0) {
+        status = 1;
+    }
+    return status;
+}
@@ -0,0 +1,222 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include "../../common/message.h"
+#include "../../client/network.h"
+#include "../../server/network.h"
+
+#define FUZZ_MAX_INPUT (LINE_READER_BUFFER_SIZE * 4)
+
+static void check_parsed_message(const char *line, size_t line_length, const ParsedMessage *message) {
+    if (message->field_count < 0 || message->field_count > MESSAGE_MAX_FIELDS) {
+        abort();
+    }
+    if (message->opcode < line || message->opcode + message->opcode_length > line + line_length) {
+        abort();
+    }
+    for (int i = 0; i < message->field_count; i++) {
+        const char *field = message->fields[i];
+        if (field < line || field + strlen(field) > line + line_length) {
+            abort();
+        }
+    }
+}
+
+static void exercise_client_parsers(const ParsedMessage *message) {
+    int row;
+    int col;
+    int reparsed_row;
+    int reparsed_col;
+    int black_count;
+    int white_count;
+    const char *result;
+    const char *winner;
+    const char *board;
+    int size;
+
+    switch (message->type) {
+        case MESSAGE_TYPE_MOVE:
+        case MESSAGE_TYPE_OPPONENT_MOVE:
+            if (parse_opponent_move_message(message, &row, &col) == 0) {
+                char encoded[MAX_MESSAGE_LENGTH];
+                ParsedMessage reparsed;
+                format_opponent_move_message(encoded, sizeof(encoded), row, col);
+                if (tokenize_message(encoded, &reparsed) < 0 ||
+                    parse_opponent_move_message(&reparsed, &reparsed_row, &reparsed_col) < 0 ||
+                    reparsed_row != row || reparsed_col != col) {
+                    abort();
+                }
+            }
+            break;
+
+        case MESSAGE_TYPE_BOARD:
+            if ((board = parse_board_message(message, &size)) != NULL &&
+                (size < BOARD_MIN_SIZE || size > BOARD_MAX_SIZE || strlen(board) != (size_t)(size * size))) {
+                abort();
+            }
+            break;
+
+        case MESSAGE_TYPE_GAME_OVER:
+            if (parse_game_over_message(message, &result, &winner, &black_count, &white_count) == 0 &&
+                (result == NULL || winner == NULL)) {
+                abort();
+            }
+            break;
+
+        default:
+            for (int i = 0; i <= message->field_count; i++) {
+                message_field(message, i);
+            }
+            break;
+    }
+}
+
+static void fuzz_single_line(const uint8_t *data, size_t size) {
+    static char line[FUZZ_MAX_INPUT + 1];
+    ParsedMessage message;
+
+    memcpy(line, data, size);
+    line[size] = '\0';
+    size_t line_length = strlen(line);
+
+    if (tokenize_message(line, &message) < 0) {
+        return;
+    }
+    check_parsed_message(line, line_length, &message);
+    exercise_client_parsers(&message);
+
+    const char *reason = message_field(&message, 0);
+    if (reason != NULL) {
+        char encoded[MAX_MESSAGE_LENGTH];
+        size_t length = format_invalid_message(encoded, sizeof(encoded), reason);
+        if (length >= sizeof(encoded) || encoded[length] != '\0') {
+            abort();
+        }
+    }
+}
+
+static void fuzz_line_reader(const uint8_t *data, size_t size) {
+    int pipe_fds[2];
+    if (pipe(pipe_fds) < 0) {
+        return;
+    }
+
+    size_t written = 0;
+    while (written < size) {
+        ssize_t bytes_written = write(pipe_fds[1], data + written, size - written);
+        if (bytes_written <= 0) {
+            break;
+        }
+        written += (size_t)bytes_written;
+    }
+    close(pipe_fds[1]);
+
+    static LineReader reader;
+    line_reader_init(&reader, pipe_fds[0]);
+
+    char *line;
+    while (1) {
+        while ((line = line_reader_next(&reader)) != NULL) {
+            ParsedMessage message;
+            if (strlen(line) >= sizeof(reader.data)) {
+                abort();
+            }
+            if (tokenize_message(line, &message) == 0) {
+                exercise_client_parsers(&message);
+            }
+        }
+        if (line_reader_fill(&reader) <= 0) {
+            break;
+        }
+    }
+    close(pipe_fds[0]);
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    if (size > FUZZ_MAX_INPUT) {
+        return 0;
+    }
+    fuzz_single_line(data, size);
+    fuzz_line_reader(data, size);
+    return 0;
+}
+
+#ifndef FUZZING
+
+static int replay_file(const char *path) {
+    static uint8_t input[FUZZ_MAX_INPUT + 1];
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        perror(path);
+        return -1;
+    }
+    size_t size = fread(input, 1, sizeof(input), file);
+    fclose(file);
+
+    LLVMFuzzerTestOneInput(input, size);
+    return 0;
+}
+
+static int replay_path(const char *path, int *replayed) {
+    struct stat path_status;
+    if (stat(path, &path_status) < 0) {
+        perror(path);
+        return -1;
+    }
+
+    if (!S_ISDIR(path_status.st_mode)) {
+        if (replay_file(path) < 0) {
+            return -1;
+        }
+        (*replayed)++;
+        return 0;
+    }
+
+    DIR *directory = opendir(path);
+    if (directory == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    int status = 0;
+    struct dirent *entry;
+    while ((entry = readdir(directory)) != NULL) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        char child_path[4096];
+        snprintf(child_path, sizeof(child_path), "%s/%s", path, entry->d_name);
+        if (replay_path(child_path, replayed) < 0) {
+            status = -1;
+        }
+    }
+    closedir(directory);
+    return status;
+}
+
+int main(int argc, char *argv[]) {
+    int replayed = 0;
+
+    if (argc < 2) {
+        static uint8_t input[FUZZ_MAX_INPUT + 1];
+        size_t size = fread(input, 1, sizeof(input), stdin);
+        LLVMFuzzerTestOneInput(input, size);
+        printf("Replayed 1 input from stdin\n");
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (replay_path(argv[i], &replayed) < 0) {
+            return 1;
+        }
+    }
+
+    printf("Replayed %d inputs\n", replayed);
+    return 0;
+}
+
+#endif
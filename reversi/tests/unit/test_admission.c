@@ -0,0 +1,82 @@
+#include <stdio.h>
+#include <assert.h>
+#include "server/admission.h"
+
+#define SECOND_NS 1000000000ULL
+
+void test_connection_ceiling(void) {
+    printf("Testing max-connections ceiling...\n");
+    admission_config config = { .max_connections = 4, .connect_rate = 0, .connect_burst = 1 };
+    configure_admission(&config);
+    
+    assert(admit_connection(0x0A000001, 3, 0) == ADMISSION_ACCEPTED);
+    assert(admit_connection(0x0A000001, 4, 0) == ADMISSION_OVER_CAPACITY);
+    assert(admit_connection(0x0A000002, 10, 0) == ADMISSION_OVER_CAPACITY);
+    assert(admit_local_connection(3) == ADMISSION_ACCEPTED);
+    assert(admit_local_connection(4) == ADMISSION_OVER_CAPACITY);
+    assert(count_tracked_addresses() == 0);
+    
+    printf("Max-connections ceiling: PASS\n");
+}
+
+void test_token_bucket(void) {
+    printf("Testing per-address token bucket...\n");
+    admission_config config = { .max_connections = 0, .connect_rate = 2, .connect_burst = 3 };
+    configure_admission(&config);
+    
+    uint64_t now = 100 * SECOND_NS;
+    for (int i = 0; i < 3; i++) {
+        assert(admit_connection(0x0A000001, 0, now) == ADMISSION_ACCEPTED);
+    }
+    assert(admit_connection(0x0A000001, 0, now) == ADMISSION_RATE_LIMITED);
+    assert(admit_connection(0x0A000002, 0, now) == ADMISSION_ACCEPTED);
+    assert(admit_connection(0x7F000001, 0, now) == ADMISSION_ACCEPTED);
+    for (int i = 0; i < 10; i++) {
+        assert(admit_local_connection(0) == ADMISSION_ACCEPTED);
+    }
+    assert(admit_connection(0x7F000001, 0, now) == ADMISSION_ACCEPTED);
+    
+    assert(admit_connection(0x0A000001, 0, now + SECOND_NS / 4) == ADMISSION_RATE_LIMITED);
+    assert(admit_connection(0x0A000001, 0, now + SECOND_NS / 2) == ADMISSION_ACCEPTED);
+    assert(admit_connection(0x0A000001, 0, now + SECOND_NS / 2) == ADMISSION_RATE_LIMITED);
+    
+    now += 10 * SECOND_NS;
+    for (int i = 0; i < 3; i++) {
+        assert(admit_connection(0x0A000001, 0, now) == ADMISSION_ACCEPTED);
+    }
+    assert(admit_connection(0x0A000001, 0, now) == ADMISSION_RATE_LIMITED);
+    
+    printf("Per-address token bucket: PASS\n");
+}
+
+void test_table_reuse(void) {
+    printf("Testing address table slot reuse...\n");
+    admission_config config = { .max_connections = 0, .connect_rate = 1, .connect_burst = 1 };
+    configure_admission(&config);
+    
+    uint64_t now = SECOND_NS;
+    for (uint32_t address = 1; address <= 3 * ADMISSION_TABLE_CAPACITY; address++) {
+        assert(admit_connection(address, 0, now) == ADMISSION_ACCEPTED);
+    }
+    assert(count_tracked_addresses() == ADMISSION_TABLE_CAPACITY);
+    assert(admit_connection(3 * ADMISSION_TABLE_CAPACITY, 0, now) == ADMISSION_RATE_LIMITED);
+    
+    now += 2 * SECOND_NS;
+    for (uint32_t address = 1; address <= 3 * ADMISSION_TABLE_CAPACITY; address++) {
+        assert(admit_connection(address, 0, now) == ADMISSION_ACCEPTED);
+    }
+    assert(count_tracked_addresses() == ADMISSION_TABLE_CAPACITY);
+    
+    printf("Address table slot reuse: PASS\n");
+}
+
+int main(void) {
+    printf("=== Running Admission Tests ===\n\n");
+    
+    test_connection_ceiling();
+    test_token_bucket();
+    test_table_reuse();
+    
+    printf("\n=== All Tests Passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "lib/reversi.h"
+
+#define BATCH_POSITIONS 1003
+
+static uint64_t players[BATCH_POSITIONS];
+static uint64_t opponents[BATCH_POSITIONS];
+static uint64_t expected_moves[BATCH_POSITIONS];
+static uint64_t expected_flips[BATCH_POSITIONS];
+static uint8_t squares[BATCH_POSITIONS];
+
+static const char *isa_name(ReversiBatchIsa isa) {
+    static const char *names[] = { "scalar", "avx2", "avx512" };
+    return names[isa];
+}
+
+static uint64_t engine_flips(const ReversiGame *game, int square) {
+    if (square >= 64 || !reversi_is_legal(game, square / 8, square % 8)) {
+        return 0;
+    }
+
+    ReversiGame *copy = reversi_clone(game);
+    char mover = reversi_to_move(game) == REVERSI_BLACK ? 'B' : 'W';
+    uint64_t flips = 0;
+    assert(reversi_apply_move(copy, square / 8, square % 8) == 0);
+    for (int i = 0; i < 64; i++) {
+        if (i != square && reversi_cell(game, i / 8, i % 8) != mover && reversi_cell(copy, i / 8, i % 8) == mover) {
+            flips |= 1ULL << i;
+        }
+    }
+    reversi_destroy(copy);
+    return flips;
+}
+
+static void collect_positions(void) {
+    ReversiGame *game = reversi_create(REVERSI_BITBOARD_SIZE);
+    srand(42);
+
+    for (int i = 0; i < BATCH_POSITIONS; i++) {
+        if (reversi_status(game) != REVERSI_IN_PROGRESS) {
+            reversi_destroy(game);
+            game = reversi_create(REVERSI_BITBOARD_SIZE);
+        }
+
+        int moves[REVERSI_MAX_SQUARES];
+        int count = reversi_legal_moves(game, moves, REVERSI_MAX_SQUARES);
+        assert(reversi_to_bitboards(game, &players[i], &opponents[i]) == 0);
+        expected_moves[i] = 0;
+        for (int move = 0; move < count; move++) {
+            expected_moves[i] |= 1ULL << moves[move];
+        }
+
+        squares[i] = (i % 3 == 0 && count > 0) ? (uint8_t)moves[rand() % count] : (uint8_t)(rand() % 70);
+        expected_flips[i] = engine_flips(game, squares[i]);
+
+        if (count == 0) {
+            assert(reversi_pass(game) == 0);
+        } else {
+            int square = moves[rand() % count];
+            assert(reversi_apply_move(game, square / 8, square % 8) == 0);
+        }
+    }
+    reversi_destroy(game);
+}
+
+void test_bitboards(void) {
+    printf("Testing bitboard conversion...\n");
+    ReversiGame *game = reversi_create(REVERSI_BITBOARD_SIZE);
+    ReversiGame *small = reversi_create(6);
+    uint64_t player, opponent;
+
+    assert(reversi_to_bitboards(game, &player, &opponent) == 0);
+    assert(player == ((1ULL << 28) | (1ULL << 35)) && opponent == ((1ULL << 27) | (1ULL << 36)));
+    assert(reversi_to_bitboards(small, &player, &opponent) < 0);
+
+    assert(reversi_apply_move(game, 2, 3) == 0);
+    uint64_t hash = reversi_hash(game);
+    assert(reversi_to_bitboards(game, &player, &opponent) == 0);
+    assert(reversi_from_bitboards(small, player, opponent, REVERSI_WHITE) == 0);
+    assert(reversi_size(small) == 8 && reversi_hash(small) == hash);
+    assert(reversi_from_bitboards(small, 1, 1, REVERSI_BLACK) < 0);
+
+    reversi_destroy(small);
+    reversi_destroy(game);
+    printf("Bitboard conversion: PASS\n");
+}
+
+static void check_isa(ReversiBatchIsa isa) {
+    printf("Testing batched move generation with %s...\n", isa_name(isa));
+    assert(reversi_batch_use_isa(isa) == 0 && reversi_batch_isa() == isa);
+
+    uint64_t player_copy[BATCH_POSITIONS];
+    uint64_t opponent_copy[BATCH_POSITIONS];
+    uint64_t results[BATCH_POSITIONS];
+    ReversiBoardBatch batch = { players, opponents, BATCH_POSITIONS };
+
+    reversi_batch_legal_moves(&batch, results);
+    assert(memcmp(results, expected_moves, sizeof(results)) == 0);
+    reversi_batch_flips(&batch, squares, results);
+    assert(memcmp(results, expected_flips, sizeof(results)) == 0);
+
+    memcpy(player_copy, players, sizeof(players));
+    memcpy(opponent_copy, opponents, sizeof(opponents));
+    ReversiBoardBatch applied = { player_copy, opponent_copy, BATCH_POSITIONS };
+    size_t legal = 0;
+    for (int i = 0; i < BATCH_POSITIONS; i++) {
+        legal += (expected_flips[i] != 0);
+    }
+    assert(reversi_batch_apply(&applied, squares, results) == legal);
+    for (int i = 0; i < BATCH_POSITIONS; i++) {
+        if (expected_flips[i] == 0) {
+            assert(player_copy[i] == players[i] && opponent_copy[i] == opponents[i]);
+        } else {
+            assert(player_copy[i] == (opponents[i] & ~expected_flips[i]));
+            assert(opponent_copy[i] == (players[i] | expected_flips[i] | (1ULL << squares[i])));
+        }
+    }
+
+    ReversiBoardBatch short_batch = { players + 5, opponents + 5, 3 };
+    reversi_batch_legal_moves(&short_batch, results);
+    assert(memcmp(results, expected_moves + 5, 3 * sizeof(uint64_t)) == 0);
+    printf("Batched move generation with %s: PASS\n", isa_name(isa));
+}
+
+void test_batched_isas(void) {
+    collect_positions();
+    ReversiBatchIsa detected = reversi_batch_isa();
+    printf("Runtime-selected batch ISA: %s\n", isa_name(detected));
+
+    for (ReversiBatchIsa isa = REVERSI_BATCH_SCALAR; isa <= REVERSI_BATCH_AVX512; isa++) {
+        if (reversi_batch_use_isa(isa) == 0) {
+            check_isa(isa);
+        } else {
+            assert(isa > detected);
+            printf("%s not supported on this CPU, skipping\n", isa_name(isa));
+        }
+    }
+    assert(reversi_batch_use_isa(detected) == 0);
+}
+
+int main(void) {
+    printf("=== Batched Move Generation Unit Tests ===\n\n");
+
+    test_bitboards();
+    test_batched_isas();
+
+    printf("\n=== All Tests Passed! ===\n");
+    return 0;
+}
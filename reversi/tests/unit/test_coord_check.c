@@ -7,8 +7,8 @@ int main() {
     
     printf("=== Testing coordinate interpretation ===\n\n");
     
-    for (int r = 0; r < BOARD_HEIGHT; r++) {
-        for (int c = 0; c < BOARD_WIDTH; c++) {
+    for (int r = 0; r < BOARD_DEFAULT_SIZE; r++) {
+        for (int c = 0; c < BOARD_DEFAULT_SIZE; c++) {
             game.board[r][c] = CELL_EMPTY;
         }
     }
@@ -23,9 +23,9 @@ int main() {
     
     printf("Board state:\n");
     printf("  0 1 2 3 4 5 6 7\n");
-    for (int r = 0; r < BOARD_HEIGHT; r++) {
+    for (int r = 0; r < BOARD_DEFAULT_SIZE; r++) {
         printf("%d ", r);
-        for (int c = 0; c < BOARD_WIDTH; c++) {
+        for (int c = 0; c < BOARD_DEFAULT_SIZE; c++) {
             printf("%c ", game.board[r][c]);
         }
         printf("\n");
@@ -1,12 +1,18 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include "server/game.h"
 
 void print_board(const GameState *game) {
-    printf("\n  0 1 2 3 4 5 6 7\n");
-    for (int row = 0; row < BOARD_HEIGHT; row++) {
+    printf("\n ");
+    for (int col = 0; col < game->size; col++) {
+        printf(" %d", col);
+    }
+    printf("\n");
+    for (int row = 0; row < game->size; row++) {
         printf("%d ", row);
-        for (int col = 0; col < BOARD_WIDTH; col++) {
+        for (int col = 0; col < game->size; col++) {
             printf("%c ", game->board[row][col]);
         }
         printf("\n");
@@ -109,6 +115,122 @@ void test_has_legal_moves(void) {
     printf("Legal moves check: PASS\n");
 }
 
+static int same_position(const GameState *left, const GameState *right) {
+    return memcmp(left->board, right->board, sizeof(left->board)) == 0 &&
+           left->current_player == right->current_player && left->status == right->status &&
+           left->black_can_move == right->black_can_move && left->white_can_move == right->white_can_move &&
+           left->history_length == right->history_length;
+}
+
+void test_sized_boards(void) {
+    printf("Testing 6x6 and 10x10 boards...\n");
+    GameState game;
+    
+    assert(!is_supported_board_size(7) && !is_supported_board_size(12));
+    initialize_sized_game(&game, 6);
+    assert(game.size == 6);
+    assert(game.board[2][2] == CELL_WHITE && game.board[2][3] == CELL_BLACK);
+    assert(game.board[3][2] == CELL_BLACK && game.board[3][3] == CELL_WHITE);
+    assert(game.board[0][6] == CELL_EMPTY && game.board[6][0] == CELL_EMPTY);
+    assert(is_valid_move(&game, 1, 2) && is_valid_move(&game, 4, 3));
+    assert(!is_valid_move(&game, 5, 6) && !is_valid_move(&game, 6, 5));
+    assert(execute_move(&game, 1, 2));
+    assert(game.board[2][2] == CELL_BLACK);
+    
+    initialize_sized_game(&game, 10);
+    assert(game.size == 10);
+    assert(game.board[4][4] == CELL_WHITE && game.board[4][5] == CELL_BLACK);
+    assert(game.board[5][4] == CELL_BLACK && game.board[5][5] == CELL_WHITE);
+    assert(is_valid_move(&game, 3, 4) && is_valid_move(&game, 6, 5));
+    
+    game.board[9][9] = CELL_BLACK;
+    game.board[9][8] = CELL_WHITE;
+    game.board[9][7] = CELL_EMPTY;
+    assert(is_valid_move(&game, 9, 7));
+    assert(execute_move(&game, 9, 7));
+    assert(game.board[9][8] == CELL_BLACK);
+    int square = 9 * BOARD_MAX_SIZE + 8;
+    assert(game.history[0].flipped[square / 64] == 1ULL << (square % 64));
+    assert(undo_move(&game));
+    assert(game.board[9][8] == CELL_WHITE && game.board[9][7] == CELL_EMPTY);
+    
+    int black_count, white_count;
+    count_pieces(&game, &black_count, &white_count);
+    assert(black_count == 3 && white_count == 3);
+    
+    initialize_sized_game(&game, 7);
+    assert(game.size == BOARD_DEFAULT_SIZE);
+    
+    printf("6x6 and 10x10 boards: PASS\n");
+}
+
+void test_undo_move(void) {
+    printf("Testing undo records...\n");
+    GameState game;
+    initialize_game(&game);
+    assert(!undo_move(&game));
+    
+    GameState before = game;
+    assert(execute_move(&game, 2, 3));
+    assert(game.history_length == 1);
+    assert(game.history[0].square == 2 * BOARD_MAX_SIZE + 3);
+    assert(game.history[0].flipped[0] == 1ULL << (3 * BOARD_MAX_SIZE + 3) && game.history[0].flipped[1] == 0);
+    assert(count_moves_by(&game, PLAYER_BLACK) == 1 && count_moves_by(&game, PLAYER_WHITE) == 0);
+    assert(undo_move(&game));
+    assert(same_position(&game, &before));
+    
+    pass_turn(&game);
+    assert(game.current_player == PLAYER_WHITE && game.history[0].square == MOVE_PASS);
+    assert(count_moves_by(&game, PLAYER_BLACK) == 0);
+    assert(undo_move(&game));
+    assert(same_position(&game, &before));
+    
+    printf("Undo records: PASS\n");
+}
+
+void test_undo_full_games(void) {
+    printf("Testing make/unmake over random games...\n");
+    static GameState positions[MOVE_HISTORY_CAPACITY + 1];
+    static const int sizes[] = { 6, 8, 10 };
+    srand(7);
+    
+    for (int round = 0; round < 300; round++) {
+        GameState game;
+        initialize_sized_game(&game, sizes[round % 3]);
+        int size = game.size;
+        int plies = 0;
+        
+        while (!is_game_over(&game)) {
+            positions[plies++] = game;
+            int legal[BOARD_MAX_CELLS];
+            int legal_count = 0;
+            for (int square = 0; square < size * size; square++) {
+                if (is_valid_move(&game, square / size, square % size)) {
+                    legal[legal_count++] = square;
+                }
+            }
+            if (legal_count == 0) {
+                pass_turn(&game);
+                continue;
+            }
+            int square = legal[rand() % legal_count];
+            assert(execute_move(&game, square / size, square % size));
+        }
+        
+        int black_count, white_count;
+        count_pieces(&game, &black_count, &white_count);
+        assert(black_count + white_count <= size * size);
+        assert(game.history_length == plies);
+        while (plies > 0) {
+            assert(undo_move(&game));
+            assert(same_position(&game, &positions[--plies]));
+        }
+        assert(!undo_move(&game));
+    }
+    
+    printf("Make/unmake over random games: PASS\n");
+}
+
 int main(void) {
     printf("=== Running Game Logic Tests ===\n\n");
     
@@ -117,6 +239,9 @@ int main(void) {
     test_execute_move();
     test_multiple_moves();
     test_has_legal_moves();
+    test_sized_boards();
+    test_undo_move();
+    test_undo_full_games();
     
     printf("\n=== All Tests Passed! ===\n");
     return 0;
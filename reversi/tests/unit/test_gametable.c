@@ -0,0 +1,160 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <assert.h>
+#include <sys/wait.h>
+#include "server/gametable.h"
+
+static void count_board(const char *board, int *black_count, int *white_count) {
+    *black_count = 0;
+    *white_count = 0;
+    for (int i = 0; board[i] != '\0'; i++) {
+        *black_count += (board[i] == CELL_BLACK);
+        *white_count += (board[i] == CELL_WHITE);
+    }
+}
+
+void test_slot_lifecycle(void) {
+    printf("Testing game slot lifecycle...\n");
+    GameSnapshot snapshot;
+
+    int slot = claim_game_slot(42);
+    assert(slot >= 0);
+    assert(count_live_games() == 1);
+    assert(read_game_slot(slot, &snapshot) == 1);
+    assert(snapshot.game_id == 42 && snapshot.pid == 0 && snapshot.move_count == 0);
+    assert(snapshot.black_count == 2 && snapshot.white_count == 2);
+    assert(snapshot.board_size == BOARD_DEFAULT_SIZE);
+    assert((int)strlen(snapshot.board) == BOARD_DEFAULT_SIZE * BOARD_DEFAULT_SIZE);
+
+    assign_game_slot_process(slot, 12345);
+    assert(read_game_slot(slot, &snapshot) == 1 && snapshot.pid == 12345);
+    assert(find_game_process(42) == 12345);
+    assert(find_game_process(7) < 0);
+
+    release_game_slot(slot);
+    assert(count_live_games() == 0);
+    assert(read_game_slot(slot, &snapshot) == 0);
+    assert(find_game_process(42) < 0);
+
+    int first = claim_game_slot(43);
+    int second = claim_game_slot(44);
+    int third = claim_game_slot(45);
+    assert(first >= 0 && second >= 0 && third >= 0 && first != second && second != third);
+    assign_game_slot_process(first, 500);
+    assign_game_slot_process(second, 501);
+    assign_game_slot_process(third, 500);
+    release_process_slots(500);
+    assert(count_live_games() == 1);
+    assert(find_game_process(44) == 501);
+    release_game_slot(second);
+    assert(count_live_games() == 0);
+
+    printf("Game slot lifecycle: PASS\n");
+}
+
+void test_child_publishes(void) {
+    printf("Testing seqlock reads against a live writer...\n");
+    int slot = claim_game_slot(7);
+    assert(slot >= 0);
+
+    pid_t child = fork();
+    assert(child >= 0);
+    if (child == 0) {
+        GameState game;
+        initialize_sized_game(&game, 10);
+        for (int move = 1; move <= 200000; move++) {
+            int cell = move % (game.size * game.size);
+            game.board[cell / game.size][cell % game.size] = (move & 1) ? CELL_BLACK : CELL_WHITE;
+            game.current_player = (move & 1) ? PLAYER_WHITE : PLAYER_BLACK;
+            publish_game_state(slot, &game, move);
+        }
+        _exit(0);
+    }
+    assign_game_slot_process(slot, child);
+
+    GameSnapshot snapshot;
+    int reads = 0;
+    int last_move = 0;
+    int status;
+    while (waitpid(child, &status, WNOHANG) == 0) {
+        if (!read_game_slot(slot, &snapshot)) {
+            continue;
+        }
+        int black_count;
+        int white_count;
+        count_board(snapshot.board, &black_count, &white_count);
+        assert((int)strlen(snapshot.board) == snapshot.board_size * snapshot.board_size);
+        assert(black_count == snapshot.black_count && white_count == snapshot.white_count);
+        assert(snapshot.move_count >= last_move);
+        last_move = snapshot.move_count;
+        reads++;
+    }
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    assert(read_game_slot(slot, &snapshot) == 1 && snapshot.move_count == 200000);
+    assert(snapshot.board_size == 10);
+    assert(reads > 0);
+
+    release_game_slot(slot);
+    assert(count_live_games() == 0);
+
+    printf("Seqlock reads against a live writer: PASS\n");
+}
+
+void test_render(void) {
+    printf("Testing game table rendering...\n");
+    int slot = claim_game_slot(9);
+    assign_game_slot_process(slot, 4242);
+    publish_player_rtt(slot, PLAYER_WHITE, 2500000);
+
+    char *text = malloc(game_table_render_size());
+    assert(text != NULL);
+    size_t length = render_game_table(text, game_table_render_size(), 0);
+    assert(length > 0);
+    assert(strstr(text, "(1 live)") != NULL);
+    assert(strstr(text, "\n9 4242 BLACK 0 2 2 0.0 0.0 8x8 ") != NULL);
+    assert(strstr(text, " 0.0/2.5\n") != NULL);
+    free(text);
+
+    release_game_slot(slot);
+    printf("Game table rendering: PASS\n");
+}
+
+void test_table_full(void) {
+    printf("Testing a full game table...\n");
+    static int claimed[GAME_TABLE_DEFAULT_SLOTS];
+    for (int i = 0; i < GAME_TABLE_DEFAULT_SLOTS; i++) {
+        claimed[i] = claim_game_slot(1000 + i);
+        assert(claimed[i] >= 0);
+        assign_game_slot_process(claimed[i], 600);
+    }
+    assert(claim_game_slot(5000) < 0);
+    assert(count_live_games() == GAME_TABLE_DEFAULT_SLOTS);
+    assert(find_game_process(1000 + GAME_TABLE_DEFAULT_SLOTS - 1) == 600);
+
+    char *text = malloc(game_table_render_size());
+    assert(text != NULL);
+    size_t length = render_game_table(text, game_table_render_size(), 0);
+    assert(length > 0 && length < game_table_render_size());
+    assert(strstr(text, "\n2023 600 ") != NULL);
+    free(text);
+
+    release_process_slots(600);
+    assert(count_live_games() == 0);
+    assert(claim_game_slot(5000) >= 0);
+    printf("Full game table: PASS\n");
+}
+
+int main(void) {
+    printf("=== Game Table Unit Tests ===\n\n");
+
+    assert(initialize_game_table(GAME_TABLE_DEFAULT_SLOTS) == 0);
+    test_slot_lifecycle();
+    test_child_publishes();
+    test_render();
+    test_table_full();
+
+    printf("\n=== All Tests Passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,349 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "server/iobackend.h"
+
+#define ORDERED_MESSAGES 200
+
+static char event_data[MAX_MESSAGE_LENGTH];
+
+static int wait_for_event(IoBackend *backend, IoEventType type, IoEvent *found) {
+    for (int attempt = 0; attempt < 20; attempt++) {
+        IoEvent events[IO_BACKEND_EVENT_BATCH];
+        int count = io_backend_wait(backend, events, IO_BACKEND_EVENT_BATCH, 100);
+        assert(count >= 0);
+        for (int i = 0; i < count; i++) {
+            if (events[i].type == type) {
+                *found = events[i];
+                if (type == IO_EVENT_DATA && events[i].length > 0) {
+                    memcpy(event_data, events[i].data, (size_t)events[i].length);
+                    event_data[events[i].length] = '\0';
+                    found->data = event_data;
+                }
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+static int open_listener(uint16_t *port) {
+    int listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    struct sockaddr_in address = { .sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK) };
+    socklen_t length = sizeof(address);
+
+    assert(listen_fd >= 0);
+    assert(bind(listen_fd, (struct sockaddr *)&address, sizeof(address)) == 0);
+    assert(listen(listen_fd, 16) == 0);
+    assert(getsockname(listen_fd, (struct sockaddr *)&address, &length) == 0);
+    *port = ntohs(address.sin_port);
+    return listen_fd;
+}
+
+static int connect_client(uint16_t port) {
+    int client_fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    struct sockaddr_in address = { .sin_family = AF_INET, .sin_port = htons(port),
+                                   .sin_addr.s_addr = htonl(INADDR_LOOPBACK) };
+    assert(client_fd >= 0);
+    assert(connect(client_fd, (struct sockaddr *)&address, sizeof(address)) == 0);
+    return client_fd;
+}
+
+static size_t read_all(int socket_fd, char *buffer, size_t buffer_size, size_t expected) {
+    size_t length = 0;
+    while (length < expected && length < buffer_size - 1) {
+        struct pollfd ready = { .fd = socket_fd, .events = POLLIN };
+        if (poll(&ready, 1, 2000) <= 0) {
+            break;
+        }
+        ssize_t bytes = recv(socket_fd, buffer + length, buffer_size - 1 - length, 0);
+        if (bytes <= 0) {
+            break;
+        }
+        length += (size_t)bytes;
+    }
+    buffer[length] = '\0';
+    return length;
+}
+
+static void test_accept_and_receive(IoBackend *backend) {
+    printf("Testing accept and receive on %s...\n", io_backend_name(backend->kind));
+    uint16_t port;
+    int listen_fd = open_listener(&port);
+    assert(io_backend_watch_accept(backend, listen_fd, 7) == 0);
+
+    int client_fd = connect_client(port);
+    IoEvent event;
+    assert(wait_for_event(backend, IO_EVENT_ACCEPT, &event));
+    assert(event.token == 7 && event.fd >= 0);
+    int server_fd = event.fd;
+
+    int second_fd = connect_client(port);
+    assert(wait_for_event(backend, IO_EVENT_ACCEPT, &event));
+    close(event.fd);
+    close(second_fd);
+
+    assert(io_backend_add_connection(backend, server_fd, 9) == 0);
+    assert(send(client_fd, "MOVE|2|3\n", 9, 0) == 9);
+    assert(wait_for_event(backend, IO_EVENT_DATA, &event));
+    assert(event.token == 9 && event.fd == server_fd);
+    assert(event.length == 9 && strcmp(event.data, "MOVE|2|3\n") == 0);
+
+    assert(send(client_fd, "PASS\n", 5, 0) == 5);
+    assert(wait_for_event(backend, IO_EVENT_DATA, &event));
+    assert(event.length == 5 && strcmp(event.data, "PASS\n") == 0);
+
+    close(client_fd);
+    assert(wait_for_event(backend, IO_EVENT_DATA, &event));
+    assert(event.token == 9 && event.length <= 0);
+
+    io_backend_remove(backend, listen_fd);
+    io_backend_close(backend, server_fd);
+    close(listen_fd);
+    printf("Accept and receive on %s: PASS\n", io_backend_name(backend->kind));
+}
+
+static void test_send_ordering(IoBackend *backend) {
+    printf("Testing ordered sends and close on %s...\n", io_backend_name(backend->kind));
+    int pair[2];
+    assert(socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, pair) == 0);
+    assert(io_backend_add_connection(backend, pair[1], 3) == 0);
+
+    char expected[ORDERED_MESSAGES * 16];
+    size_t expected_length = 0;
+    for (int i = 0; i < ORDERED_MESSAGES; i++) {
+        char message[16];
+        int length = snprintf(message, sizeof(message), "VALID|%03d\n", i);
+        assert(io_backend_send(backend, pair[1], message, (size_t)length) == length);
+        memcpy(expected + expected_length, message, (size_t)length);
+        expected_length += (size_t)length;
+        if (i % 50 == 49) {
+            IoEvent events[IO_BACKEND_EVENT_BATCH];
+            assert(io_backend_wait(backend, events, IO_BACKEND_EVENT_BATCH, 0) >= 0);
+        }
+    }
+    assert(io_backend_send(backend, pair[1], "BYE\n", 4) == 4);
+    memcpy(expected + expected_length, "BYE\n", 4);
+    expected_length += 4;
+    io_backend_close(backend, pair[1]);
+
+    IoEvent events[IO_BACKEND_EVENT_BATCH];
+    assert(io_backend_wait(backend, events, IO_BACKEND_EVENT_BATCH, 0) >= 0);
+
+    char received[ORDERED_MESSAGES * 16 + 1];
+    assert(read_all(pair[0], received, sizeof(received), expected_length) == expected_length);
+    assert(memcmp(received, expected, expected_length) == 0);
+
+    for (int attempt = 0; attempt < 20; attempt++) {
+        struct pollfd ready = { .fd = pair[0], .events = POLLIN };
+        assert(io_backend_wait(backend, events, IO_BACKEND_EVENT_BATCH, 0) >= 0);
+        if (poll(&ready, 1, 100) > 0) {
+            break;
+        }
+    }
+    assert(recv(pair[0], received, sizeof(received), MSG_DONTWAIT) == 0);
+    close(pair[0]);
+    printf("Ordered sends and close on %s: PASS\n", io_backend_name(backend->kind));
+}
+
+static void open_slow_pair(int pair[2]) {
+    int buffer_size = 4096;
+    assert(socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, pair) == 0);
+    assert(setsockopt(pair[1], SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size)) == 0);
+    assert(fcntl(pair[1], F_SETFL, fcntl(pair[1], F_GETFL) | O_NONBLOCK) == 0);
+}
+
+static void test_queued_sends(IoBackend *backend) {
+    printf("Testing queued sends to a slow reader on %s...\n", io_backend_name(backend->kind));
+    int pair[2];
+    open_slow_pair(pair);
+    assert(io_backend_add_connection(backend, pair[1], 4) == 0);
+
+    char message[MAX_MESSAGE_LENGTH - 12];
+    memset(message, 'x', sizeof(message));
+    message[sizeof(message) - 1] = '\n';
+    int messages = IO_BACKEND_SEND_QUEUE_MESSAGES;
+    for (int i = 0; i < messages; i++) {
+        assert(io_backend_send(backend, pair[1], message, sizeof(message)) == (ssize_t)sizeof(message));
+    }
+
+    size_t expected = (size_t)messages * sizeof(message);
+    size_t received = 0;
+    char buffer[4096];
+    for (int attempt = 0; attempt < 200 && received < expected; attempt++) {
+        IoEvent events[IO_BACKEND_EVENT_BATCH];
+        assert(io_backend_wait(backend, events, IO_BACKEND_EVENT_BATCH, 10) >= 0);
+        ssize_t bytes = recv(pair[0], buffer, sizeof(buffer), MSG_DONTWAIT);
+        for (ssize_t i = 0; i < bytes; i++) {
+            assert(buffer[i] == ((received + (size_t)i) % sizeof(message) == sizeof(message) - 1 ? '\n' : 'x'));
+        }
+        received += (bytes > 0) ? (size_t)bytes : 0;
+    }
+    assert(received == expected);
+
+    io_backend_close(backend, pair[1]);
+    close(pair[0]);
+    printf("Queued sends to a slow reader on %s: PASS\n", io_backend_name(backend->kind));
+}
+
+static void test_send_overflow(IoBackend *backend) {
+    printf("Testing send queue overflow on %s...\n", io_backend_name(backend->kind));
+    int pair[2];
+    open_slow_pair(pair);
+    assert(io_backend_add_connection(backend, pair[1], 6) == 0);
+
+    char message[128];
+    memset(message, 'x', sizeof(message));
+    int accepted = 0;
+    ssize_t result = 0;
+    while (accepted < 10000 && (result = io_backend_send(backend, pair[1], message, sizeof(message))) > 0) {
+        accepted++;
+        if (accepted % 8 == 0) {
+            IoEvent events[IO_BACKEND_EVENT_BATCH];
+            assert(io_backend_wait(backend, events, IO_BACKEND_EVENT_BATCH, 0) >= 0);
+        }
+    }
+    assert(result < 0 && errno == ENOBUFS);
+    assert(accepted >= IO_BACKEND_SEND_QUEUE_MESSAGES);
+
+    IoEvent event;
+    assert(wait_for_event(backend, IO_EVENT_DATA, &event));
+    assert(event.token == 6 && event.fd == pair[1] && event.length < 0);
+    assert(io_backend_send(backend, pair[1], message, sizeof(message)) < 0);
+
+    io_backend_close(backend, pair[1]);
+    close(pair[0]);
+    printf("Send queue overflow on %s: PASS\n", io_backend_name(backend->kind));
+}
+
+static void test_failed_send(IoBackend *backend) {
+    printf("Testing failed sends on %s...\n", io_backend_name(backend->kind));
+    int pair[2];
+    assert(socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, pair) == 0);
+    assert(io_backend_add_connection(backend, pair[1], 8) == 0);
+    assert(shutdown(pair[0], SHUT_RD) == 0);
+
+    io_backend_send(backend, pair[1], "BOARD\n", 6);
+    IoEvent event;
+    assert(wait_for_event(backend, IO_EVENT_DATA, &event));
+    assert(event.token == 8 && event.fd == pair[1] && event.length < 0);
+    assert(io_backend_send(backend, pair[1], "BOARD\n", 6) < 0);
+
+    io_backend_close(backend, pair[1]);
+    close(pair[0]);
+    printf("Failed sends on %s: PASS\n", io_backend_name(backend->kind));
+}
+
+static void test_unix_listener(IoBackend *backend) {
+    printf("Testing UNIX listener on %s...\n", io_backend_name(backend->kind));
+    struct sockaddr_un address = { .sun_family = AF_UNIX };
+    snprintf(address.sun_path, sizeof(address.sun_path), "/tmp/reversi_test_%d.sock", (int)getpid());
+    unlink(address.sun_path);
+
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    assert(listen_fd >= 0);
+    assert(bind(listen_fd, (struct sockaddr *)&address, sizeof(address)) == 0);
+    assert(listen(listen_fd, 16) == 0);
+    assert(io_backend_watch_accept(backend, listen_fd, 1) == 0);
+
+    int client_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    assert(connect(client_fd, (struct sockaddr *)&address, sizeof(address)) == 0);
+    IoEvent event;
+    assert(wait_for_event(backend, IO_EVENT_ACCEPT, &event));
+    assert(event.token == 1 && event.fd >= 0);
+    int server_fd = event.fd;
+
+    assert(io_backend_add_connection(backend, server_fd, 11) == 0);
+    assert(send(client_fd, "NAME|bot\n", 9, 0) == 9);
+    assert(wait_for_event(backend, IO_EVENT_DATA, &event));
+    assert(event.token == 11 && event.length == 9 && strcmp(event.data, "NAME|bot\n") == 0);
+    assert(io_backend_send(backend, server_fd, "WAIT\n", 5) == 5);
+    IoEvent events[IO_BACKEND_EVENT_BATCH];
+    assert(io_backend_wait(backend, events, IO_BACKEND_EVENT_BATCH, 0) >= 0);
+
+    char received[8];
+    assert(read_all(client_fd, received, sizeof(received), 5) == 5 && strcmp(received, "WAIT\n") == 0);
+
+    io_backend_remove(backend, listen_fd);
+    io_backend_close(backend, server_fd);
+    close(client_fd);
+    close(listen_fd);
+    unlink(address.sun_path);
+    printf("UNIX listener on %s: PASS\n", io_backend_name(backend->kind));
+}
+
+static void test_readable_watch(IoBackend *backend) {
+    printf("Testing readable watches on %s...\n", io_backend_name(backend->kind));
+    int pair[2];
+    assert(socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, pair) == 0);
+    assert(io_backend_watch_readable(backend, pair[1], UINT32_MAX) == 0);
+
+    for (int round = 0; round < 3; round++) {
+        char message[8];
+        assert(send(pair[0], "ping", 4, 0) == 4);
+        IoEvent event;
+        assert(wait_for_event(backend, IO_EVENT_READABLE, &event));
+        assert(event.token == UINT32_MAX && event.fd == pair[1]);
+        assert(recv(pair[1], message, sizeof(message), MSG_DONTWAIT) == 4);
+    }
+
+    io_backend_remove(backend, pair[1]);
+    assert(send(pair[0], "ping", 4, 0) == 4);
+    IoEvent events[IO_BACKEND_EVENT_BATCH];
+    assert(io_backend_wait(backend, events, IO_BACKEND_EVENT_BATCH, 50) == 0);
+    close(pair[0]);
+    close(pair[1]);
+    printf("Readable watches on %s: PASS\n", io_backend_name(backend->kind));
+}
+
+static void run_backend_tests(IoBackend *backend) {
+    test_accept_and_receive(backend);
+    test_send_ordering(backend);
+    test_queued_sends(backend);
+    test_send_overflow(backend);
+    test_failed_send(backend);
+    test_unix_listener(backend);
+    test_readable_watch(backend);
+    destroy_io_backend(backend);
+}
+
+void test_backend_selection(void) {
+    printf("Testing backend selection...\n");
+    IoBackendKind kind;
+    assert(parse_io_backend("epoll", &kind) == 0 && kind == IO_BACKEND_EPOLL);
+    assert(parse_io_backend("io_uring", &kind) == 0 && kind == IO_BACKEND_URING);
+    assert(parse_io_backend("uring", &kind) == 0 && kind == IO_BACKEND_URING);
+    assert(parse_io_backend("select", &kind) < 0);
+
+    configure_io_backend(IO_BACKEND_EPOLL);
+    IoBackend *backend = create_io_backend();
+    assert(backend != NULL && backend->kind == IO_BACKEND_EPOLL);
+    destroy_io_backend(backend);
+    printf("Backend selection: PASS\n");
+}
+
+int main(void) {
+    printf("=== I/O Backend Unit Tests ===\n\n");
+
+    test_backend_selection();
+    run_backend_tests(create_epoll_backend());
+
+    IoBackend *uring = create_uring_backend();
+    if (uring != NULL) {
+        run_backend_tests(uring);
+    } else {
+        printf("io_uring unavailable, skipping its backend tests\n");
+    }
+
+    printf("\n=== All Tests Passed! ===\n");
+    return 0;
+}
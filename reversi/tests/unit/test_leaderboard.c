@@ -0,0 +1,140 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <assert.h>
+#include "server/leaderboard.h"
+
+static GameResult make_result(const char *black, const char *white, GameOutcome outcome) {
+    GameResult result;
+    memset(&result, 0, sizeof(result));
+    result.outcome = outcome;
+    snprintf(result.black_name, sizeof(result.black_name), "%s", black);
+    snprintf(result.white_name, sizeof(result.white_name), "%s", white);
+    return result;
+}
+
+void test_elo_update(void) {
+    printf("Testing Elo rating update...\n");
+    reset_leaderboard();
+
+    GameResult result = make_result("alice", "bob", GAME_OUTCOME_BLACK_WINS);
+    assert(record_leaderboard_result(&result) == 1);
+
+    LeaderboardEntry alice;
+    LeaderboardEntry bob;
+    assert(leaderboard_lookup("alice", &alice) == 0);
+    assert(leaderboard_lookup("bob", &bob) == 0);
+    assert(fabs(alice.rating - 1516.0) < 1e-9);
+    assert(fabs(bob.rating - 1484.0) < 1e-9);
+    assert(alice.rank == 1 && bob.rank == 2);
+    assert(alice.wins == 1 && bob.losses == 1);
+
+    result = make_result("alice", "bob", GAME_OUTCOME_BLACK_LEFT);
+    assert(record_leaderboard_result(&result) == 1);
+    assert(leaderboard_lookup("bob", &bob) == 0);
+    assert(bob.wins == 1 && bob.losses == 1);
+
+    result = make_result("alice", "", GAME_OUTCOME_DRAW);
+    assert(record_leaderboard_result(&result) == 0);
+    result = make_result("alice", "alice", GAME_OUTCOME_DRAW);
+    assert(record_leaderboard_result(&result) == 0);
+    assert(leaderboard_size() == 2);
+    assert(leaderboard_lookup("carol", &alice) < 0);
+
+    printf("Elo rating update: PASS\n");
+}
+
+void test_rank_order(void) {
+    printf("Testing order-statistic rank queries...\n");
+    reset_leaderboard();
+
+    char black[PLAYER_NAME_LENGTH];
+    char white[PLAYER_NAME_LENGTH];
+    srand(7);
+    for (int game = 0; game < 20000; game++) {
+        snprintf(black, sizeof(black), "p%d", rand() % 500);
+        snprintf(white, sizeof(white), "p%d", rand() % 500);
+        GameResult result = make_result(black, white, (GameOutcome)(rand() % 3));
+        record_leaderboard_result(&result);
+    }
+    assert(leaderboard_size() == 500);
+
+    LeaderboardEntry previous;
+    LeaderboardEntry entry;
+    LeaderboardEntry lookup;
+    double total = 0.0;
+    for (int rank = 1; rank <= leaderboard_size(); rank++) {
+        assert(leaderboard_entry_at(rank, &entry) == 0);
+        assert(entry.rank == rank);
+        assert(leaderboard_lookup(entry.name, &lookup) == 0);
+        assert(lookup.rank == rank);
+        if (rank > 1) {
+            assert(previous.rating > entry.rating ||
+                   (previous.rating == entry.rating && strcmp(previous.name, entry.name) < 0));
+        }
+        total += entry.rating;
+        previous = entry;
+    }
+    assert(fabs(total / leaderboard_size() - LEADERBOARD_INITIAL_RATING) < 1e-6);
+    assert(leaderboard_entry_at(0, &entry) < 0);
+    assert(leaderboard_entry_at(501, &entry) < 0);
+
+    char text[256];
+    size_t length = render_leaderboard(text, sizeof(text), 3);
+    assert(length > 0 && length < sizeof(text));
+    assert(strncmp(text, "# rank", 6) == 0);
+    assert(strstr(text, "\n1 ") != NULL && strstr(text, "\n3 ") != NULL && strstr(text, "\n4 ") == NULL);
+
+    printf("Order-statistic rank queries: PASS\n");
+}
+
+void test_snapshot_round_trip(void) {
+    printf("Testing leaderboard snapshot round trip...\n");
+    char path[] = "/tmp/leaderboard_test_XXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+
+    reset_leaderboard();
+    configure_leaderboard_snapshots(path, 1);
+    GameResult result = make_result("alice", "bob", GAME_OUTCOME_WHITE_WINS);
+    record_leaderboard_result(&result);
+    result = make_result("carol", "bob", GAME_OUTCOME_DRAW);
+    record_leaderboard_result(&result);
+
+    LeaderboardEntry before;
+    assert(leaderboard_lookup("bob", &before) == 0);
+
+    assert(leaderboard_snapshot_timeout_ms(1000000000ULL) == 1000);
+    maybe_save_leaderboard_snapshot(1500000000ULL);
+    maybe_save_leaderboard_snapshot(2000000000ULL);
+
+    reset_leaderboard();
+    assert(leaderboard_size() == 0);
+    assert(load_leaderboard_snapshot() == 3);
+
+    LeaderboardEntry after;
+    assert(leaderboard_lookup("bob", &after) == 0);
+    assert(after.rank == before.rank && after.wins == 1 && after.draws == 1);
+    assert(fabs(after.rating - before.rating) < 1e-5);
+
+    unlink(path);
+    configure_leaderboard_snapshots(NULL, 0);
+    assert(leaderboard_snapshot_timeout_ms(0) == -1);
+
+    printf("Leaderboard snapshot round trip: PASS\n");
+}
+
+int main(void) {
+    printf("=== Leaderboard Unit Tests ===\n\n");
+
+    initialize_leaderboard();
+    test_elo_update();
+    test_rank_order();
+    test_snapshot_round_trip();
+
+    printf("\n=== All Tests Passed! ===\n");
+    return 0;
+}
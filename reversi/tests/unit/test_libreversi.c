@@ -0,0 +1,137 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "lib/reversi.h"
+
+void test_create_and_query(void) {
+    printf("Testing game handles...\n");
+    assert(reversi_version() == REVERSI_VERSION);
+    assert(reversi_create(7) == NULL && reversi_create(12) == NULL);
+
+    ReversiGame *game = reversi_create(REVERSI_DEFAULT_SIZE);
+    assert(game != NULL);
+    assert(reversi_size(game) == 8);
+    assert(reversi_to_move(game) == REVERSI_BLACK);
+    assert(reversi_status(game) == REVERSI_IN_PROGRESS);
+    assert(reversi_cell(game, 3, 3) == 'W' && reversi_cell(game, 3, 4) == 'B');
+    assert(reversi_cell(game, 8, 0) == '\0' && reversi_cell(game, -1, 0) == '\0');
+
+    int black_count, white_count;
+    reversi_count(game, &black_count, &white_count);
+    assert(black_count == 2 && white_count == 2);
+
+    int moves[REVERSI_MAX_SQUARES];
+    assert(reversi_legal_moves(game, moves, REVERSI_MAX_SQUARES) == 4);
+    assert(moves[0] == 2 * 8 + 3 && moves[3] == 5 * 8 + 4);
+    assert(reversi_legal_moves(game, moves, 1) == 1 && moves[0] == 2 * 8 + 3);
+    assert(reversi_is_legal(game, 2, 3) && !reversi_is_legal(game, 0, 0));
+
+    reversi_destroy(game);
+    printf("Game handles: PASS\n");
+}
+
+void test_apply_and_undo(void) {
+    printf("Testing apply, pass and undo...\n");
+    ReversiGame *game = reversi_create(6);
+    uint64_t start_hash = reversi_hash(game);
+
+    assert(reversi_pass(game) < 0);
+    assert(reversi_apply_move(game, 0, 0) < 0);
+    assert(reversi_apply_move(game, 1, 2) == 0);
+    assert(reversi_to_move(game) == REVERSI_WHITE);
+    assert(reversi_cell(game, 2, 2) == 'B');
+    assert(reversi_hash(game) != start_hash);
+
+    ReversiGame *copy = reversi_clone(game);
+    assert(copy != NULL && reversi_hash(copy) == reversi_hash(game));
+    assert(reversi_undo(game) == 0);
+    assert(reversi_hash(game) == start_hash);
+    assert(reversi_undo(game) < 0);
+    assert(reversi_hash(copy) != start_hash);
+
+    reversi_destroy(copy);
+    reversi_destroy(game);
+    printf("Apply, pass and undo: PASS\n");
+}
+
+void test_serialize(void) {
+    printf("Testing serialize and hash...\n");
+    ReversiGame *game = reversi_create(10);
+    ReversiGame *loaded = reversi_create(REVERSI_DEFAULT_SIZE);
+    char text[REVERSI_SERIALIZED_LENGTH];
+
+    assert(reversi_apply_move(game, 3, 4) == 0);
+    size_t length = reversi_serialize(game, text, sizeof(text));
+    assert(length == strlen("10|W|") + 100 && length == strlen(text));
+    assert(strncmp(text, "10|W|", 5) == 0);
+    assert(reversi_serialize(game, text, 50) == 0);
+    reversi_serialize(game, text, sizeof(text));
+
+    assert(reversi_deserialize(loaded, text) == 0);
+    assert(reversi_size(loaded) == 10 && reversi_to_move(loaded) == REVERSI_WHITE);
+    assert(reversi_hash(loaded) == reversi_hash(game));
+
+    assert(reversi_deserialize(loaded, "8|B|") < 0);
+    assert(reversi_deserialize(loaded, "7|B|.................................................") < 0);
+    assert(reversi_deserialize(loaded, "6|X|....................................") < 0);
+    assert(reversi_deserialize(loaded, "6|B|..............WB....BW.............?") < 0);
+    assert(reversi_deserialize(loaded, "6|B|BBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBB") == 0);
+    assert(reversi_status(loaded) == REVERSI_BLACK_WINS);
+    assert(reversi_legal_moves(loaded, NULL, 0) == 0 && reversi_pass(loaded) < 0);
+
+    reversi_destroy(loaded);
+    reversi_destroy(game);
+    printf("Serialize and hash: PASS\n");
+}
+
+void test_random_games(void) {
+    printf("Testing random games through the public API...\n");
+    static const int sizes[] = { 6, 8, 10 };
+    srand(11);
+
+    for (int round = 0; round < 60; round++) {
+        ReversiGame *game = reversi_create(sizes[round % 3]);
+        int size = reversi_size(game);
+        int plies = 0;
+
+        while (reversi_status(game) == REVERSI_IN_PROGRESS) {
+            int moves[REVERSI_MAX_SQUARES];
+            int count = reversi_legal_moves(game, moves, REVERSI_MAX_SQUARES);
+            if (count == 0) {
+                assert(reversi_pass(game) == 0);
+            } else {
+                int square = moves[rand() % count];
+                assert(reversi_apply_move(game, square / size, square % size) == 0);
+            }
+            plies++;
+        }
+
+        int black_count, white_count;
+        reversi_count(game, &black_count, &white_count);
+        ReversiStatus expected = black_count > white_count ? REVERSI_BLACK_WINS :
+                                 white_count > black_count ? REVERSI_WHITE_WINS : REVERSI_DRAW;
+        assert(reversi_status(game) == expected);
+
+        while (plies-- > 0) {
+            assert(reversi_undo(game) == 0);
+        }
+        reversi_count(game, &black_count, &white_count);
+        assert(black_count == 2 && white_count == 2 && reversi_status(game) == REVERSI_IN_PROGRESS);
+        reversi_destroy(game);
+    }
+
+    printf("Random games through the public API: PASS\n");
+}
+
+int main(void) {
+    printf("=== Engine Library Unit Tests ===\n\n");
+
+    test_create_and_query();
+    test_apply_and_undo();
+    test_serialize();
+    test_random_games();
+
+    printf("\n=== All Tests Passed! ===\n");
+    return 0;
+}
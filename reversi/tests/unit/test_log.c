@@ -0,0 +1,65 @@
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include "server/log.h"
+
+void test_levels_and_records(void) {
+    printf("Testing structured log records...\n");
+    int pipe_fds[2];
+    assert(pipe(pipe_fds) == 0);
+    
+    assert(log_level_enabled(LOG_LEVEL_ERROR) == false);
+    assert(initialize_logging(LOG_LEVEL_INFO, pipe_fds[1]) == 0);
+    
+    assert(log_level_enabled(LOG_LEVEL_DEBUG) == false);
+    assert(log_level_enabled(LOG_LEVEL_INFO) == true);
+    
+    int evaluated = 0;
+    LOG_DEBUG("hidden_event", LOG_INT("value", ++evaluated));
+    assert(evaluated == 0);
+    
+    LOG_INFO("client_connected", LOG_TEXT("address", "127.0.0.1"), LOG_INT("port", 5555));
+    LOG_WARN("quoted_text", LOG_TEXT("reason", "has space"));
+    
+    log_set_level(LOG_LEVEL_ERROR);
+    assert(log_get_level() == LOG_LEVEL_ERROR);
+    LOG_WARN("suppressed_event", LOG_INT("value", 1));
+    
+    shutdown_logging();
+    close(pipe_fds[1]);
+    
+    char output[4096];
+    ssize_t length = read(pipe_fds[0], output, sizeof(output) - 1);
+    assert(length > 0);
+    output[length] = '\0';
+    close(pipe_fds[0]);
+    
+    assert(strstr(output, "level=info") != NULL);
+    assert(strstr(output, "event=client_connected address=127.0.0.1 port=5555\n") != NULL);
+    assert(strstr(output, "event=quoted_text reason=\"has space\"\n") != NULL);
+    assert(strstr(output, "hidden_event") == NULL);
+    assert(strstr(output, "suppressed_event") == NULL);
+    
+    printf("Structured log records: PASS\n");
+}
+
+void test_parse_levels(void) {
+    printf("Testing log level parsing...\n");
+    LogLevel level;
+    assert(parse_log_level("debug", &level) == 0 && level == LOG_LEVEL_DEBUG);
+    assert(parse_log_level("WARN", &level) == 0 && level == LOG_LEVEL_WARN);
+    assert(parse_log_level("off", &level) == 0 && level == LOG_LEVEL_OFF);
+    assert(parse_log_level("verbose", &level) == -1);
+    printf("Log level parsing: PASS\n");
+}
+
+int main(void) {
+    printf("=== Running Log Tests ===\n\n");
+    
+    test_parse_levels();
+    test_levels_and_records();
+    
+    printf("\n=== All Tests Passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "common/message.h"
+
+void test_opcode_lookup(void) {
+    printf("Testing opcode lookup...\n");
+    
+    const struct {
+        const char *opcode;
+        MessageType type;
+    } cases[] = {
+        { MESSAGE_WAIT, MESSAGE_TYPE_WAIT },
+        { MESSAGE_WELCOME, MESSAGE_TYPE_WELCOME },
+        { MESSAGE_START, MESSAGE_TYPE_START },
+        { MESSAGE_MOVE, MESSAGE_TYPE_MOVE },
+        { MESSAGE_PASS, MESSAGE_TYPE_PASS },
+        { MESSAGE_QUIT, MESSAGE_TYPE_QUIT },
+        { MESSAGE_BOARD, MESSAGE_TYPE_BOARD },
+        { MESSAGE_YOUR_TURN, MESSAGE_TYPE_YOUR_TURN },
+        { MESSAGE_OPPONENT_TURN, MESSAGE_TYPE_OPPONENT_TURN },
+        { MESSAGE_VALID, MESSAGE_TYPE_VALID },
+        { MESSAGE_INVALID, MESSAGE_TYPE_INVALID },
+        { MESSAGE_OPPONENT_MOVE, MESSAGE_TYPE_OPPONENT_MOVE },
+        { MESSAGE_OPPONENT_PASS, MESSAGE_TYPE_OPPONENT_PASS },
+        { MESSAGE_GAME_OVER, MESSAGE_TYPE_GAME_OVER },
+        { MESSAGE_OPPONENT_LEFT, MESSAGE_TYPE_OPPONENT_LEFT },
+        { MESSAGE_ERROR, MESSAGE_TYPE_ERROR },
+        { MESSAGE_ROUND, MESSAGE_TYPE_ROUND },
+        { MESSAGE_BYE, MESSAGE_TYPE_BYE },
+        { MESSAGE_TOURNAMENT_OVER, MESSAGE_TYPE_TOURNAMENT_OVER },
+        { MESSAGE_NAME, MESSAGE_TYPE_NAME },
+        { MESSAGE_RANK, MESSAGE_TYPE_RANK },
+        { MESSAGE_UNDO, MESSAGE_TYPE_UNDO },
+        { MESSAGE_UNDO_ACCEPT, MESSAGE_TYPE_UNDO_ACCEPT },
+        { MESSAGE_UNDO_DECLINE, MESSAGE_TYPE_UNDO_DECLINE },
+        { MESSAGE_PREMOVE, MESSAGE_TYPE_PREMOVE },
+        { MESSAGE_REMATCH, MESSAGE_TYPE_REMATCH },
+        { MESSAGE_PING, MESSAGE_TYPE_PING },
+        { MESSAGE_PONG, MESSAGE_TYPE_PONG },
+        { "PUNT", MESSAGE_TYPE_UNKNOWN },
+        { "PREMOVES", MESSAGE_TYPE_UNKNOWN },
+        { "quit", MESSAGE_TYPE_QUIT },
+        { "Move", MESSAGE_TYPE_MOVE },
+        { "MOVES", MESSAGE_TYPE_UNKNOWN },
+        { "OPPONENT_XXXX", MESSAGE_TYPE_UNKNOWN },
+        { "", MESSAGE_TYPE_UNKNOWN }
+    };
+    
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        assert(lookup_message_type(cases[i].opcode, strlen(cases[i].opcode)) == cases[i].type);
+    }
+    
+    printf("Opcode lookup: PASS\n");
+}
+
+void test_tokenize(void) {
+    printf("Testing in-place tokenizer...\n");
+    ParsedMessage message;
+    
+    char move[] = "MOVE|2|3\r\n";
+    assert(tokenize_message(move, &message) == 0);
+    assert(message.type == MESSAGE_TYPE_MOVE);
+    assert(message.field_count == 2);
+    assert(strcmp(message.fields[0], "2") == 0);
+    assert(strcmp(message.fields[1], "3") == 0);
+    
+    int row, col;
+    assert(parse_message_coordinates(&message, &row, &col) == 0);
+    assert(row == 2 && col == 3);
+    
+    char game_over[] = "GAME_OVER|WIN|BLACK|34|30";
+    assert(tokenize_message(game_over, &message) == 0);
+    assert(message.type == MESSAGE_TYPE_GAME_OVER);
+    assert(message.field_count == 4);
+    assert(strcmp(message_field(&message, 1), "BLACK") == 0);
+    assert(message_field(&message, 4) == NULL);
+    
+    char pass[] = "pass\n";
+    assert(tokenize_message(pass, &message) == 0);
+    assert(message.type == MESSAGE_TYPE_PASS);
+    assert(message.field_count == 0);
+    
+    char two_lines[] = "QUIT\nMOVE|1|1\n";
+    assert(tokenize_message(two_lines, &message) == 0);
+    assert(message.type == MESSAGE_TYPE_QUIT);
+    
+    char too_many[] = "MOVE|1|2|3|4|5|6|7|8|9";
+    assert(tokenize_message(too_many, &message) == -1);
+    
+    char bad_move[] = "MOVE|2|x";
+    assert(tokenize_message(bad_move, &message) == 0);
+    assert(parse_message_coordinates(&message, &row, &col) == -1);
+    
+    printf("In-place tokenizer: PASS\n");
+}
+
+void test_parse_int(void) {
+    printf("Testing integer parsing...\n");
+    int value;
+    
+    assert(parse_message_int("42", &value) == 0 && value == 42);
+    assert(parse_message_int(" 7 ", &value) == 0 && value == 7);
+    assert(parse_message_int("-3", &value) == 0 && value == -3);
+    assert(parse_message_int("", &value) == -1);
+    assert(parse_message_int("3x", &value) == -1);
+    assert(parse_message_int("9999999999", &value) == -1);
+    assert(parse_message_int(NULL, &value) == -1);
+    
+    printf("Integer parsing: PASS\n");
+}
+
+int main(void) {
+    printf("=== Running Message Codec Tests ===\n\n");
+    
+    test_opcode_lookup();
+    test_tokenize();
+    test_parse_int();
+    
+    printf("\n=== All Tests Passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "server/metrics.h"
+
+void test_histogram_buckets(void) {
+    printf("Testing histogram bucket boundaries...\n");
+    
+    assert(metrics_histogram_bucket(0) == 0);
+    assert(metrics_histogram_bucket(1023) == 0);
+    assert(metrics_histogram_bucket(1024) == 1);
+    
+    for (int bucket = 1; bucket < METRICS_HISTOGRAM_BUCKETS - 1; bucket++) {
+        uint64_t upper = metrics_histogram_upper_bound(bucket);
+        uint64_t lower = metrics_histogram_upper_bound(bucket - 1);
+        assert(upper > lower);
+        assert(metrics_histogram_bucket(lower) == bucket - 1);
+        assert(metrics_histogram_bucket(lower + 1) == bucket);
+        assert(metrics_histogram_bucket(upper) == bucket);
+        assert(metrics_histogram_bucket(upper + 1) == bucket + 1);
+    }
+    
+    assert(metrics_histogram_bucket(UINT64_MAX) == METRICS_HISTOGRAM_BUCKETS - 1);
+    
+    printf("Histogram buckets: PASS\n");
+}
+
+void test_prometheus_rendering(void) {
+    printf("Testing Prometheus rendering...\n");
+    assert(initialize_metrics() == 0);
+    
+    metrics_increment(METRIC_CONNECTIONS_ACCEPTED);
+    metrics_add(METRIC_BYTES_SENT, 70);
+    metrics_gauge_add(METRIC_ACTIVE_GAMES, 2);
+    metrics_gauge_add(METRIC_ACTIVE_GAMES, -1);
+    metrics_record_invalid_move("occupied");
+    metrics_record_invalid_move("something_else");
+    metrics_record_latency(METRIC_MOVE_LATENCY, 5000);
+    metrics_record_latency(METRIC_MOVE_LATENCY, 1023);
+    
+    static char output[65536];
+    size_t length = metrics_render_prometheus(output, sizeof(output));
+    assert(length > 0 && length < sizeof(output));
+    
+    assert(strstr(output, "reversi_connections_accepted_total 1\n") != NULL);
+    assert(strstr(output, "reversi_bytes_sent_total 70\n") != NULL);
+    assert(strstr(output, "reversi_active_games 1\n") != NULL);
+    assert(strstr(output, "reversi_invalid_moves_total{reason=\"occupied\"} 1\n") != NULL);
+    assert(strstr(output, "reversi_invalid_moves_total{reason=\"other\"} 1\n") != NULL);
+    assert(strstr(output, "reversi_move_latency_seconds_bucket{le=\"1.023e-06\"} 1\n") != NULL);
+    assert(strstr(output, "reversi_move_latency_seconds_bucket{le=\"4.095e-06\"} 1\n") != NULL);
+    assert(strstr(output, "reversi_move_latency_seconds_bucket{le=\"5.119e-06\"} 2\n") != NULL);
+    assert(strstr(output, "reversi_move_latency_seconds_bucket{le=\"+Inf\"} 2\n") != NULL);
+    assert(strstr(output, "reversi_move_latency_seconds_count 2\n") != NULL);
+    
+    printf("Prometheus rendering: PASS\n");
+}
+
+int main(void) {
+    printf("=== Running Metrics Tests ===\n\n");
+    
+    test_histogram_buckets();
+    test_prometheus_rendering();
+    
+    printf("\n=== All Tests Passed! ===\n");
+    return 0;
+}
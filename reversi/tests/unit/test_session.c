@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <assert.h>
+#include <sys/socket.h>
+#include "server/session.h"
+#include "common/board.h"
+#include "common/protocol.h"
+
+static size_t drain(int socket_fd, char *buffer, size_t buffer_size) {
+    size_t length = 0;
+    ssize_t bytes;
+    while (length < buffer_size - 1 &&
+           (bytes = recv(socket_fd, buffer + length, buffer_size - 1 - length, MSG_DONTWAIT)) > 0) {
+        length += (size_t)bytes;
+    }
+    buffer[length] = '\0';
+    return length;
+}
+
+static void open_session(GameSession *session, int black[2], int white[2]) {
+    char buffer[1024];
+    assert(socketpair(AF_UNIX, SOCK_STREAM, 0, black) == 0);
+    assert(socketpair(AF_UNIX, SOCK_STREAM, 0, white) == 0);
+    start_game_session(session, 1, -1, getpid(), 0, BOARD_DEFAULT_SIZE, black[1], white[1]);
+    assert(session_is_live(session));
+    drain(black[0], buffer, sizeof(buffer));
+    drain(white[0], buffer, sizeof(buffer));
+}
+
+static void close_session(GameSession *session, int black[2], int white[2]) {
+    release_game_session(session);
+    for (int i = 0; i < 2; i++) {
+        close(black[i]);
+        close(white[i]);
+    }
+}
+
+void test_line_split_across_reads(void) {
+    printf("Testing a command split across two reads...\n");
+    GameSession session;
+    int black[2];
+    int white[2];
+    char buffer[1024];
+    open_session(&session, black, white);
+
+    assert(handle_session_data(&session, PLAYER_BLACK, "MOVE|2", 6) == SESSION_RUNNING);
+    assert(session.partial_lines[PLAYER_BLACK] != NULL);
+    assert(drain(black[0], buffer, sizeof(buffer)) == 0);
+    assert(drain(white[0], buffer, sizeof(buffer)) == 0);
+
+    assert(handle_session_data(&session, PLAYER_BLACK, "|3\n", 3) == SESSION_RUNNING);
+    assert(session.partial_lines[PLAYER_BLACK] == NULL);
+    drain(black[0], buffer, sizeof(buffer));
+    assert(strncmp(buffer, "VALID\n", 6) == 0);
+    drain(white[0], buffer, sizeof(buffer));
+    assert(strstr(buffer, "OPPONENT_MOVE|2|3\n") != NULL);
+
+    assert(handle_session_data(&session, PLAYER_WHITE, "MOVE|2|2\nMOVE|", 14) == SESSION_RUNNING);
+    assert(session.partial_lines[PLAYER_WHITE] != NULL);
+    drain(black[0], buffer, sizeof(buffer));
+    assert(strstr(buffer, "OPPONENT_MOVE|2|2\n") != NULL);
+
+    close_session(&session, black, white);
+    assert(session.partial_lines[PLAYER_WHITE] == NULL);
+    printf("Command split across two reads: PASS\n");
+}
+
+void test_overlong_line_not_held(void) {
+    printf("Testing that overlong lines are not held...\n");
+    GameSession session;
+    int black[2];
+    int white[2];
+    char line[MAX_MESSAGE_LENGTH - 1];
+    char buffer[1024];
+    open_session(&session, black, white);
+
+    memset(line, 'X', sizeof(line));
+    assert(handle_session_data(&session, PLAYER_BLACK, line, (ssize_t)sizeof(line)) == SESSION_RUNNING);
+    assert(session.partial_lines[PLAYER_BLACK] != NULL);
+    assert(handle_session_data(&session, PLAYER_BLACK, "XX", 2) == SESSION_RUNNING);
+    assert(session.partial_lines[PLAYER_BLACK] == NULL);
+    drain(black[0], buffer, sizeof(buffer));
+    assert(strstr(buffer, "INVALID|unknown_command") != NULL);
+
+    close_session(&session, black, white);
+    printf("Overlong lines are not held: PASS\n");
+}
+
+int main(void) {
+    printf("=== Session Unit Tests ===\n\n");
+
+    assert(initialize_game_states(4) == 0);
+    test_line_split_across_reads();
+    test_overlong_line_not_held();
+
+    printf("\n=== All Tests Passed! ===\n");
+    return 0;
+}
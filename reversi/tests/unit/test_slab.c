@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+#include "server/slab.h"
+
+typedef struct {
+    uint32_t id;
+    char payload[200];
+} TestObject;
+
+void test_alignment_and_indexing(void) {
+    printf("Testing slab alignment and indexing...\n");
+    Slab slab;
+    assert(slab_init(&slab, sizeof(TestObject), 1000) == 0);
+    assert(slab.object_size == 256 && slab.chunk_objects == SLAB_CHUNK_SIZE / 256);
+    assert(slab_reserved_bytes(&slab) == 0);
+
+    TestObject *objects[1000];
+    for (uint32_t i = 0; i < 1000; i++) {
+        objects[i] = slab_alloc(&slab);
+        assert(objects[i] != NULL);
+        assert((uintptr_t)objects[i] % SLAB_ALIGNMENT == 0);
+        assert(slab_index(&slab, objects[i]) == i && slab_object(&slab, i) == objects[i]);
+        objects[i]->id = i;
+        memset(objects[i]->payload, (int)(i & 0xff), sizeof(objects[i]->payload));
+    }
+    assert(slab_alloc(&slab) == NULL);
+    assert(slab.in_use == 1000 && slab.chunk_count == 4);
+    assert(slab_reserved_bytes(&slab) == 4 * SLAB_CHUNK_SIZE);
+
+    for (uint32_t i = 0; i < 1000; i++) {
+        assert(objects[i]->id == i && objects[i]->payload[199] == (char)(i & 0xff));
+    }
+    assert(slab_object(&slab, 1000) == NULL);
+    assert(slab_index(&slab, (char *)objects[3] + 8) == SLAB_NO_INDEX);
+    assert(slab_index(&slab, &slab) == SLAB_NO_INDEX);
+
+    slab_destroy(&slab);
+    printf("Slab alignment and indexing: PASS\n");
+}
+
+void test_freelist_recycling(void) {
+    printf("Testing slab freelist recycling...\n");
+    Slab slab;
+    assert(slab_init(&slab, sizeof(TestObject), 8) == 0);
+    assert(slab.chunk_objects == 8);
+
+    TestObject *first = slab_alloc(&slab);
+    TestObject *second = slab_alloc(&slab);
+    TestObject *third = slab_alloc(&slab);
+    assert(first != NULL && second != NULL && third != NULL && slab.carved == 3);
+
+    slab_free(&slab, second);
+    slab_free(&slab, first);
+    assert(slab.in_use == 1);
+    assert(slab_alloc(&slab) == first);
+    assert(slab_alloc(&slab) == second);
+    assert(slab_alloc(&slab) != third && slab.carved == 4 && slab.in_use == 4);
+    slab_free(&slab, NULL);
+    assert(slab.in_use == 4);
+
+    for (int i = 0; i < 4; i++) {
+        assert(slab_alloc(&slab) != NULL);
+    }
+    assert(slab_alloc(&slab) == NULL);
+    slab_free(&slab, third);
+    assert(slab_alloc(&slab) == third);
+    assert(slab_reserved_bytes(&slab) < SLAB_CHUNK_SIZE);
+
+    slab_destroy(&slab);
+    assert(slab_init(&slab, 0, 8) < 0);
+    assert(slab_init(&slab, sizeof(TestObject), 0) < 0);
+    printf("Slab freelist recycling: PASS\n");
+}
+
+void test_large_objects(void) {
+    printf("Testing slabs of large objects...\n");
+    Slab slab;
+    assert(slab_init(&slab, SLAB_CHUNK_SIZE + 1, 3) == 0);
+    assert(slab.chunk_objects == 1 && slab.object_size == SLAB_CHUNK_SIZE + SLAB_ALIGNMENT);
+
+    char *objects[3];
+    for (int i = 0; i < 3; i++) {
+        objects[i] = slab_alloc(&slab);
+        assert(objects[i] != NULL);
+        memset(objects[i], 'a' + i, SLAB_CHUNK_SIZE + 1);
+        assert(slab_index(&slab, objects[i]) == (uint32_t)i);
+    }
+    assert(slab_alloc(&slab) == NULL);
+    assert(objects[0][SLAB_CHUNK_SIZE] == 'a' && objects[2][0] == 'c');
+
+    slab_destroy(&slab);
+    printf("Slabs of large objects: PASS\n");
+}
+
+int main(void) {
+    printf("=== Slab Allocator Unit Tests ===\n\n");
+
+    test_alignment_and_indexing();
+    test_freelist_recycling();
+    test_large_objects();
+
+    printf("\n=== All Tests Passed! ===\n");
+    return 0;
+}
@@ -6,9 +6,9 @@ int main() {
     initialize_game(&game);
     
     printf("Initial board:\n");
-    for (int r = 0; r < BOARD_HEIGHT; r++) {
+    for (int r = 0; r < BOARD_DEFAULT_SIZE; r++) {
         printf("%d ", r);
-        for (int c = 0; c < BOARD_WIDTH; c++) {
+        for (int c = 0; c < BOARD_DEFAULT_SIZE; c++) {
             printf("%c ", game.board[r][c]);
         }
         printf("\n");
@@ -19,8 +19,8 @@ int main() {
     printf("Row 3: . . . W W W . .\n");
     printf("Row 4: . . . B B B . .\n\n");
     
-    for (int r = 0; r < BOARD_HEIGHT; r++) {
-        for (int c = 0; c < BOARD_WIDTH; c++) {
+    for (int r = 0; r < BOARD_DEFAULT_SIZE; r++) {
+        for (int c = 0; c < BOARD_DEFAULT_SIZE; c++) {
             game.board[r][c] = CELL_EMPTY;
         }
     }
@@ -35,9 +35,9 @@ int main() {
     
     printf("Actual board state:\n");
     printf("  0 1 2 3 4 5 6 7\n");
-    for (int r = 0; r < BOARD_HEIGHT; r++) {
+    for (int r = 0; r < BOARD_DEFAULT_SIZE; r++) {
         printf("%d ", r);
-        for (int c = 0; c < BOARD_WIDTH; c++) {
+        for (int c = 0; c < BOARD_DEFAULT_SIZE; c++) {
             printf("%c ", game.board[r][c]);
         }
         printf("\n");
@@ -0,0 +1,228 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include "server/tournament.h"
+#include "server/workers.h"
+#include "server/results.h"
+#include "server/gametable.h"
+#include "server/metrics.h"
+
+#define SECOND_NS 1000000000ULL
+
+static int read_until(int socket_fd, const char *expected, char *buffer, size_t buffer_size) {
+    size_t length = 0;
+    while (length < buffer_size - 1) {
+        struct pollfd ready = { .fd = socket_fd, .events = POLLIN };
+        if (poll(&ready, 1, 2000) <= 0) {
+            return 0;
+        }
+        ssize_t bytes = recv(socket_fd, buffer + length, buffer_size - 1 - length, 0);
+        if (bytes <= 0) {
+            return 0;
+        }
+        length += (size_t)bytes;
+        buffer[length] = '\0';
+        if (strstr(buffer, expected) != NULL) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void test_pair_set(void) {
+    printf("Testing played-pairs hash set...\n");
+    PairSet set = { 0 };
+    
+    assert(!pair_set_contains(&set, 1, 2));
+    assert(pair_set_insert(&set, 1, 2) == 1);
+    assert(pair_set_insert(&set, 2, 1) == 0);
+    assert(pair_set_contains(&set, 2, 1));
+    assert(!pair_set_contains(&set, 1, 3));
+    
+    for (int i = 0; i < 5000; i++) {
+        assert(pair_set_insert(&set, i, i + 7) == 1);
+    }
+    assert(set.count == 5001);
+    assert(pair_set_contains(&set, 4999, 5006));
+    pair_set_clear(&set);
+    assert(!pair_set_contains(&set, 1, 2));
+    
+    printf("Played-pairs hash set: PASS\n");
+}
+
+void test_round_robin(void) {
+    printf("Testing round-robin circle method...\n");
+    
+    for (int players = 2; players <= 9; players++) {
+        PairSet met = { 0 };
+        TournamentPairing pairings[8];
+        int rounds = default_tournament_rounds(TOURNAMENT_ROUND_ROBIN, players);
+        int games = 0;
+        
+        for (int round = 0; round < rounds; round++) {
+            int seen[9] = { 0 };
+            int count = generate_round_robin_pairings(players, round, pairings);
+            for (int i = 0; i < count; i++) {
+                seen[pairings[i].black]++;
+                if (pairings[i].white >= 0) {
+                    seen[pairings[i].white]++;
+                    assert(pair_set_insert(&met, pairings[i].black, pairings[i].white) == 1);
+                    games++;
+                }
+            }
+            for (int player = 0; player < players; player++) {
+                assert(seen[player] == 1);
+            }
+        }
+        
+        assert(games == players * (players - 1) / 2);
+        pair_set_clear(&met);
+    }
+    
+    printf("Round-robin circle method: PASS\n");
+}
+
+void test_swiss_pairings(void) {
+    printf("Testing Swiss pairings...\n");
+    const int players = 5001;
+    TournamentEntrant *entrants = calloc(players, sizeof(TournamentEntrant));
+    TournamentPairing *pairings = calloc(players / 2 + 1, sizeof(TournamentPairing));
+    int *seen = calloc(players, sizeof(int));
+    PairSet played = { 0 };
+    int rematches = 0;
+    
+    for (int round = 0; round < 13; round++) {
+        int count = generate_swiss_pairings(entrants, players, &played, pairings);
+        assert(count == players / 2 + 1);
+        memset(seen, 0, players * sizeof(int));
+        
+        int byes = 0;
+        for (int i = 0; i < count; i++) {
+            TournamentPairing *pairing = &pairings[i];
+            seen[pairing->black]++;
+            if (pairing->white < 0) {
+                entrants[pairing->black].points += TOURNAMENT_POINTS_WIN;
+                entrants[pairing->black].byes++;
+                assert(entrants[pairing->black].byes == 1);
+                byes++;
+                continue;
+            }
+            seen[pairing->white]++;
+            rematches += pair_set_insert(&played, pairing->black, pairing->white) == 0;
+            entrants[(pairing->black + round) % 3 ? pairing->black : pairing->white].points += TOURNAMENT_POINTS_WIN;
+            entrants[pairing->black].color_balance++;
+            entrants[pairing->white].color_balance--;
+        }
+        assert(byes == 1);
+        for (int player = 0; player < players; player++) {
+            assert(seen[player] == 1);
+        }
+    }
+    assert(rematches == 0);
+    
+    int balanced = 0;
+    for (int player = 0; player < players; player++) {
+        assert(abs(entrants[player].color_balance) <= 4);
+        balanced += abs(entrants[player].color_balance) <= 2;
+    }
+    assert(balanced * 100 >= players * 98);
+    
+    entrants[0].withdrawn = 1;
+    assert(generate_swiss_pairings(entrants, players, &played, pairings) == (players - 1) / 2);
+    
+    pair_set_clear(&played);
+    free(seen);
+    free(pairings);
+    free(entrants);
+    
+    printf("Swiss pairings: PASS\n");
+}
+
+void test_default_rounds(void) {
+    printf("Testing default round counts...\n");
+    
+    assert(default_tournament_rounds(TOURNAMENT_SWISS, 1) == 0);
+    assert(default_tournament_rounds(TOURNAMENT_SWISS, 2) == 1);
+    assert(default_tournament_rounds(TOURNAMENT_SWISS, 5000) == 13);
+    assert(default_tournament_rounds(TOURNAMENT_ROUND_ROBIN, 4) == 3);
+    assert(default_tournament_rounds(TOURNAMENT_ROUND_ROBIN, 5) == 5);
+    
+    printf("Default round counts: PASS\n");
+}
+
+void test_deferred_games(void) {
+    printf("Testing rounds that wait for a free worker...\n");
+    char buffer[4096];
+    int players[2][2];
+    worker_pool_config pool = { .min_workers = 0, .max_workers = 0 };
+    tournament_config config = { .format = TOURNAMENT_SWISS, .entrants = 2, .rounds = 1 };
+    configure_worker_pool(&pool);
+    configure_tournament(&config);
+
+    for (int i = 0; i < 2; i++) {
+        assert(socketpair(AF_UNIX, SOCK_STREAM, 0, players[i]) == 0);
+        register_tournament_entrant(players[i][1]);
+    }
+    for (int i = 0; i < 2; i++) {
+        assert(read_until(players[i][0], "ROUND|1|1\nWAIT\n", buffer, sizeof(buffer)));
+        assert(strstr(buffer, "WELCOME") == NULL);
+    }
+    assert(tournament_active());
+    assert(tournament_timeout_ms(metrics_now_ns()) >= 0);
+
+    GameResult bogus = { .game_id = 1000000, .outcome = GAME_OUTCOME_DRAW };
+    assert(record_tournament_result(&bogus) == 0);
+    retry_tournament_games(metrics_now_ns() + SECOND_NS);
+    assert(tournament_timeout_ms(metrics_now_ns()) >= 0);
+
+    pool.min_workers = 1;
+    pool.max_workers = 1;
+    configure_worker_pool(&pool);
+    assert(start_worker_pool() == 0);
+    retry_tournament_games(metrics_now_ns() + 10 * SECOND_NS);
+    assert(tournament_timeout_ms(metrics_now_ns()) < 0);
+
+    int black = -1;
+    for (int i = 0; i < 2; i++) {
+        assert(read_until(players[i][0], "BOARD|", buffer, sizeof(buffer)));
+        if (strstr(buffer, "WELCOME|BLACK") != NULL) {
+            black = i;
+        }
+    }
+    assert(black >= 0);
+    assert(send(players[black][0], "QUIT\n", 5, 0) == 5);
+
+    GameResult result;
+    struct pollfd ready = { .fd = results_fd(), .events = POLLIN };
+    assert(poll(&ready, 1, 2000) > 0 && read_game_result(&result));
+    assert(result.outcome == GAME_OUTCOME_BLACK_LEFT);
+    assert(record_tournament_result(&result) == 1);
+    assert(!tournament_active());
+    assert(read_until(players[1 - black][0], "TOURNAMENT_OVER|1|2", buffer, sizeof(buffer)));
+
+    for (int i = 0; i < 2; i++) {
+        close(players[i][0]);
+    }
+    printf("Rounds that wait for a free worker: PASS\n");
+}
+
+int main(void) {
+    printf("=== Running Tournament Tests ===\n\n");
+    
+    test_pair_set();
+    test_round_robin();
+    test_swiss_pairings();
+    test_default_rounds();
+
+    assert(initialize_metrics() == 0);
+    assert(initialize_results() == 0);
+    assert(initialize_game_table(GAME_TABLE_DEFAULT_SLOTS) == 0);
+    test_deferred_games();
+    
+    printf("\n=== All Tests Passed! ===\n");
+    return 0;
+}
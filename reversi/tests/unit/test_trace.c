@@ -0,0 +1,146 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "server/trace.h"
+
+static char *render(int32_t game_id) {
+    char *buffer = malloc(TRACE_RENDER_SIZE);
+    assert(buffer != NULL);
+    size_t length = render_chrome_trace(buffer, TRACE_RENDER_SIZE, game_id);
+    assert(length == strlen(buffer));
+    assert(strncmp(buffer, "{\"traceEvents\":[", 16) == 0);
+    assert(strcmp(buffer + length - 2, "}\n") == 0);
+    return buffer;
+}
+
+static size_t count_occurrences(const char *text, const char *needle) {
+    size_t count = 0;
+    for (const char *match = strstr(text, needle); match != NULL; match = strstr(match + 1, needle)) {
+        count++;
+    }
+    return count;
+}
+
+void test_enable_and_disable(void) {
+    printf("Testing per-game trace enablement...\n");
+    assert(trace_game_enabled(7) == 0);
+    assert(trace_enable_game(7) == 0);
+    assert(trace_enable_game(7) == 0);
+    assert(trace_enable_game(0) < 0 && trace_enable_game(-3) < 0);
+    assert(trace_game_enabled(7) == 1 && trace_game_enabled(8) == 0);
+
+    trace_set_game(8);
+    assert(trace_current_game == 0);
+    trace_set_game(7);
+    assert(trace_current_game == 7);
+    trace_set_game(0);
+
+    assert(trace_disable_game(7) == 0);
+    assert(trace_disable_game(7) < 0);
+    assert(trace_game_enabled(7) == 0);
+
+    for (int32_t game = 100; game < 100 + TRACE_MAX_GAMES; game++) {
+        assert(trace_enable_game(game) == 0);
+    }
+    assert(trace_enable_game(500) < 0);
+    for (int32_t game = 100; game < 100 + TRACE_MAX_GAMES; game++) {
+        assert(trace_disable_game(game) == 0);
+    }
+    printf("Per-game trace enablement: PASS\n");
+}
+
+void test_spans_for_traced_game(void) {
+    printf("Testing spans recorded only for traced games...\n");
+    assert(trace_enable_game(11) == 0);
+
+    trace_set_game(11);
+    trace_instant(TRACE_MESSAGE_RECEIVED, "MOVE|2|3", strlen("MOVE|2|3"));
+    TraceSpan span = trace_begin(TRACE_EXECUTE_MOVE);
+    assert(span.start != 0);
+    trace_end(&span, "applied", strlen("applied"));
+    span = trace_begin(TRACE_SEND);
+    trace_end(&span, "BOARD|...\"\n", strlen("BOARD|...\"\n"));
+
+    trace_set_game(12);
+    span = trace_begin(TRACE_LEGAL_MOVES);
+    assert(span.start == 0);
+    trace_end(&span, "untraced", strlen("untraced"));
+    trace_set_game(0);
+
+    char *trace = render(11);
+    assert(strstr(trace, "\"name\":\"message_received\",\"cat\":\"game\",\"ph\":\"i\"") != NULL);
+    assert(strstr(trace, "\"label\":\"MOVE\"") != NULL);
+    assert(strstr(trace, "\"name\":\"execute_move\",\"cat\":\"game\",\"ph\":\"X\"") != NULL);
+    assert(strstr(trace, "\"label\":\"BOARD\"") != NULL);
+    assert(strstr(trace, "legal_moves") == NULL && strstr(trace, "untraced") == NULL);
+    assert(count_occurrences(trace, "\"game_id\":11") == 3);
+    free(trace);
+
+    trace = render(12);
+    assert(strcmp(trace, "{\"traceEvents\":[],\"displayTimeUnit\":\"ns\"}\n") == 0);
+    free(trace);
+
+    assert(trace_disable_game(11) == 0);
+    printf("Spans recorded only for traced games: PASS\n");
+}
+
+void test_forked_writer(void) {
+    printf("Testing trace records from a forked worker...\n");
+    assert(trace_enable_game(21) == 0);
+
+    pid_t child = fork();
+    assert(child >= 0);
+    if (child == 0) {
+        trace_set_game(21);
+        trace_instant(TRACE_GAME_STARTED, NULL, 0);
+        trace_instant(TRACE_GAME_FINISHED, "draw", strlen("draw"));
+        _exit(0);
+    }
+    int status;
+    assert(waitpid(child, &status, 0) == child && WIFEXITED(status));
+
+    char pid_field[32];
+    snprintf(pid_field, sizeof(pid_field), "\"pid\":%d,", (int)child);
+    char *trace = render(21);
+    assert(count_occurrences(trace, pid_field) == 2);
+    assert(strstr(trace, "game_started") != NULL && strstr(trace, "\"label\":\"draw\"") != NULL);
+    free(trace);
+
+    assert(trace_disable_game(21) == 0);
+    printf("Trace records from a forked worker: PASS\n");
+}
+
+void test_ring_wraparound(void) {
+    printf("Testing trace ring wraparound...\n");
+    assert(trace_enable_game(31) == 0);
+
+    trace_set_game(31);
+    for (int i = 0; i < TRACE_RING_CAPACITY + 100; i++) {
+        TraceSpan span = trace_begin(TRACE_SESSION_DATA);
+        trace_end(&span, "black", strlen("black"));
+    }
+    trace_set_game(0);
+
+    char *trace = render(31);
+    assert(count_occurrences(trace, "\"game_id\":31") == TRACE_RING_CAPACITY);
+    free(trace);
+
+    assert(trace_disable_game(31) == 0);
+    printf("Trace ring wraparound: PASS\n");
+}
+
+int main(void) {
+    printf("=== Game Tracing Unit Tests ===\n\n");
+
+    assert(initialize_tracing() == 0);
+    test_enable_and_disable();
+    test_spans_for_traced_game();
+    test_forked_writer();
+    test_ring_wraparound();
+
+    printf("\n=== All Tests Passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,325 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <assert.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include "server/workers.h"
+#include "server/session.h"
+#include "server/gametable.h"
+#include "server/results.h"
+#include "server/metrics.h"
+#include "server/iobackend.h"
+
+static int read_text_until(int socket_fd, const char *expected, char *buffer, size_t buffer_size) {
+    size_t length = 0;
+
+    while (length < buffer_size - 1) {
+        struct pollfd ready = { .fd = socket_fd, .events = POLLIN };
+        if (poll(&ready, 1, 2000) <= 0) {
+            return 0;
+        }
+        ssize_t bytes = recv(socket_fd, buffer + length, buffer_size - 1 - length, 0);
+        if (bytes <= 0) {
+            return 0;
+        }
+        length += (size_t)bytes;
+        buffer[length] = '\0';
+        if (strstr(buffer, expected) != NULL) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int read_until(int socket_fd, const char *expected) {
+    char buffer[4096];
+    return read_text_until(socket_fd, expected, buffer, sizeof(buffer));
+}
+
+static int answer_pings_until(int socket_fd, const char *expected) {
+    char line[128];
+    size_t length = 0;
+
+    while (length < sizeof(line) - 1) {
+        struct pollfd ready = { .fd = socket_fd, .events = POLLIN };
+        if (poll(&ready, 1, 2000) <= 0 || recv(socket_fd, line + length, 1, 0) != 1) {
+            return 0;
+        }
+        if (line[length] != '\n') {
+            length++;
+            continue;
+        }
+        line[length] = '\0';
+        length = 0;
+        if (strncmp(line, "PING|", 5) == 0) {
+            char reply[128];
+            int reply_length = snprintf(reply, sizeof(reply), "PONG|%s\n", line + 5);
+            if (send(socket_fd, reply, (size_t)reply_length, 0) != reply_length) {
+                return 0;
+            }
+        }
+        if (strncmp(line, expected, strlen(expected)) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int wait_for_result(GameResult *result) {
+    struct pollfd ready = { .fd = results_fd(), .events = POLLIN };
+    if (poll(&ready, 1, 2000) <= 0) {
+        return 0;
+    }
+    return read_game_result(result);
+}
+
+static void open_players(int black[2], int white[2]) {
+    assert(socketpair(AF_UNIX, SOCK_STREAM, 0, black) == 0);
+    assert(socketpair(AF_UNIX, SOCK_STREAM, 0, white) == 0);
+}
+
+void test_dispatch_and_finish(void) {
+    printf("Testing game dispatch and takebacks in a pooled worker...\n");
+    int black[2];
+    int white[2];
+    open_players(black, white);
+
+    GameSnapshot snapshot;
+    int slot = claim_game_slot(1);
+    assert(dispatch_game(1, slot, SESSION_ALLOW_TAKEBACKS, BOARD_DEFAULT_SIZE, black[1], white[1]) == 0);
+    close(black[1]);
+    close(white[1]);
+    assert(find_game_process(1) > 0);
+
+    assert(read_until(black[0], "YOUR_TURN"));
+    assert(read_until(white[0], "OPPONENT_TURN"));
+    assert(send(black[0], "MOVE|2|3\n", 9, 0) == 9);
+    assert(read_until(white[0], "YOUR_TURN"));
+
+    assert(send(black[0], "UNDO\n", 5, 0) == 5);
+    assert(read_until(white[0], "UNDO\n"));
+    assert(send(white[0], "UNDO_DECLINE\n", 13, 0) == 13);
+    assert(read_until(black[0], "UNDO_DECLINE"));
+    assert(send(black[0], "UNDO\n", 5, 0) == 5);
+    assert(read_until(white[0], "UNDO\n"));
+    assert(send(white[0], "UNDO_ACCEPT\n", 12, 0) == 12);
+    assert(read_until(black[0], "UNDO_ACCEPT"));
+    assert(read_game_slot(slot, &snapshot) == 1 && snapshot.move_count == 0);
+
+    assert(send(black[0], "MOVE|2|3\n", 9, 0) == 9);
+    assert(read_until(white[0], "YOUR_TURN"));
+    assert(send(white[0], "QUIT\n", 5, 0) == 5);
+    assert(read_until(black[0], "OPPONENT_LEFT"));
+
+    GameResult result;
+    assert(wait_for_result(&result));
+    assert(result.game_id == 1 && result.slot == slot);
+    assert(result.outcome == GAME_OUTCOME_WHITE_LEFT);
+    assert(result.worker_pid == find_game_process(1));
+    release_game_slot(result.slot);
+    note_worker_game_finished(result.worker_pid);
+
+    close(black[0]);
+    close(white[0]);
+    printf("Game dispatch and takebacks in a pooled worker: PASS\n");
+}
+
+void test_stop_game(void) {
+    printf("Testing stop requests over the control channel...\n");
+    int black[2];
+    int white[2];
+    open_players(black, white);
+
+    int slot = claim_game_slot(2);
+    assert(dispatch_game(2, slot, 0, 6, black[1], white[1]) == 0);
+    close(black[1]);
+    close(white[1]);
+    assert(read_until(black[0], "BOARD|6|6|..............WB....BW..............\n"));
+    assert(send(black[0], "MOVE|1|2\n", 9, 0) == 9);
+    assert(send(black[0], "UNDO\n", 5, 0) == 5);
+    assert(read_until(black[0], "ERROR|undo_unavailable"));
+
+    assert(stop_pooled_game(2) == 0);
+    assert(stop_pooled_game(99) < 0);
+    assert(read_until(black[0], "ERROR|game_stopped"));
+    assert(read_until(white[0], "ERROR|game_stopped"));
+
+    GameResult result;
+    assert(wait_for_result(&result));
+    assert(result.game_id == 2 && result.outcome == GAME_OUTCOME_ABORTED);
+    release_game_slot(result.slot);
+    note_worker_game_finished(result.worker_pid);
+
+    close(black[0]);
+    close(white[0]);
+    printf("Stop requests over the control channel: PASS\n");
+}
+
+void test_premoves(void) {
+    printf("Testing queued premoves...\n");
+    int black[2];
+    int white[2];
+    open_players(black, white);
+
+    int slot = claim_game_slot(3);
+    assert(dispatch_game(3, slot, 0, BOARD_DEFAULT_SIZE, black[1], white[1]) == 0);
+    close(black[1]);
+    close(white[1]);
+    assert(read_until(white[0], "OPPONENT_TURN"));
+
+    assert(send(white[0], "PREMOVE|2|2\nPREMOVE|9|9\n", 24, 0) == 24);
+    assert(read_until(white[0], "ERROR|invalid_premove"));
+    assert(send(black[0], "MOVE|2|3\n", 9, 0) == 9);
+    assert(read_until(black[0], "OPPONENT_MOVE|2|2\n"));
+
+    assert(send(white[0], "PREMOVE|0|0\nPREMOVE|x\n", 22, 0) == 22);
+    assert(read_until(white[0], "ERROR|invalid_premove"));
+    assert(send(black[0], "MOVE|2|1\n", 9, 0) == 9);
+    assert(read_until(white[0], "INVALID|no_flip"));
+    assert(send(white[0], "QUIT\n", 5, 0) == 5);
+    assert(read_until(black[0], "OPPONENT_LEFT"));
+
+    GameResult result;
+    assert(wait_for_result(&result));
+    assert(result.game_id == 3 && result.outcome == GAME_OUTCOME_WHITE_LEFT);
+    release_game_slot(result.slot);
+    note_worker_game_finished(result.worker_pid);
+
+    close(black[0]);
+    close(white[0]);
+    printf("Queued premoves: PASS\n");
+}
+
+void test_rematch(void) {
+    printf("Testing rematches on the same connections...\n");
+    static const char *moves[] = { "MOVE|5|4\n", "MOVE|3|5\n", "MOVE|2|4\n", "MOVE|5|5\n", "MOVE|4|6\n",
+                                   "MOVE|5|3\n", "MOVE|6|4\n", "MOVE|4|5\n", "MOVE|4|2\n" };
+    int black[2];
+    int white[2];
+    open_players(black, white);
+
+    int slot = claim_game_slot(4);
+    assert(dispatch_game(4, slot, SESSION_ALLOW_REMATCH, BOARD_DEFAULT_SIZE, black[1], white[1]) == 0);
+    close(black[1]);
+    close(white[1]);
+    assert(read_until(white[0], "OPPONENT_TURN"));
+
+    for (int i = 0; i < 8; i++) {
+        int mover = (i % 2 == 0) ? black[0] : white[0];
+        assert(send(mover, moves[i], strlen(moves[i]), 0) == (ssize_t)strlen(moves[i]));
+        assert(read_until((i % 2 == 0) ? white[0] : black[0], "YOUR_TURN"));
+    }
+    assert(send(black[0], moves[8], strlen(moves[8]), 0) == (ssize_t)strlen(moves[8]));
+    assert(read_until(white[0], "GAME_OVER|WIN|BLACK"));
+    assert(read_until(black[0], "GAME_OVER|WIN|BLACK"));
+
+    GameResult result;
+    assert(wait_for_result(&result));
+    assert(result.game_id == 4 && result.outcome == GAME_OUTCOME_BLACK_WINS);
+    release_game_slot(result.slot);
+    note_worker_game_finished(result.worker_pid);
+
+    assert(send(white[0], "MOVE|0|0\n", 9, 0) == 9);
+    assert(read_until(white[0], "ERROR|game_over"));
+    char text[4096];
+    assert(send(white[0], "REMATCH\nREMATCH\n", 16, 0) == 16);
+    assert(read_until(black[0], "REMATCH\n"));
+    assert(send(white[0], "REMATCH\n", 8, 0) == 8);
+    assert(send(black[0], "MOVE|0|0\n", 9, 0) == 9);
+    assert(read_text_until(black[0], "ERROR|game_over", text, sizeof(text)));
+    assert(strstr(text, "REMATCH") == NULL);
+    assert(send(black[0], "REMATCH\n", 8, 0) == 8);
+
+    struct pollfd fds[MAX_GAME_WORKERS];
+    int worker_count = collect_worker_fds(fds, MAX_GAME_WORKERS);
+    assert(poll(fds, (nfds_t)worker_count, 2000) > 0);
+    handle_worker_requests(fds, worker_count);
+
+    assert(read_until(black[0], "WELCOME|WHITE"));
+    assert(read_until(white[0], "YOUR_TURN"));
+    assert(send(white[0], "MOVE|2|3\n", 9, 0) == 9);
+    assert(read_until(black[0], "YOUR_TURN"));
+    assert(send(black[0], "QUIT\n", 5, 0) == 5);
+    assert(read_until(white[0], "OPPONENT_LEFT"));
+
+    assert(wait_for_result(&result));
+    assert(result.game_id != 4 && result.outcome == GAME_OUTCOME_WHITE_LEFT);
+    release_game_slot(result.slot);
+    note_worker_game_finished(result.worker_pid);
+
+    close(black[0]);
+    close(white[0]);
+    printf("Rematches on the same connections: PASS\n");
+}
+
+void test_heartbeat(void) {
+    printf("Testing heartbeats and dead-peer detection...\n");
+    int black[2];
+    int white[2];
+    open_players(black, white);
+
+    int slot = claim_game_slot(5);
+    assert(dispatch_game(5, slot, 0, BOARD_DEFAULT_SIZE, black[1], white[1]) == 0);
+    close(black[1]);
+    close(white[1]);
+    assert(answer_pings_until(black[0], "PING|"));
+
+    GameSnapshot snapshot;
+    for (int attempt = 0; attempt < 100; attempt++) {
+        assert(read_game_slot(slot, &snapshot) == 1);
+        if (snapshot.rtt_us[PLAYER_BLACK] > 0) {
+            break;
+        }
+        usleep(10000);
+    }
+    assert(snapshot.rtt_us[PLAYER_BLACK] > 0 && snapshot.rtt_us[PLAYER_WHITE] == 0);
+
+    assert(answer_pings_until(black[0], "OPPONENT_LEFT"));
+    GameResult result;
+    assert(wait_for_result(&result));
+    assert(result.game_id == 5 && result.outcome == GAME_OUTCOME_WHITE_LEFT);
+    release_game_slot(result.slot);
+    note_worker_game_finished(result.worker_pid);
+
+    close(black[0]);
+    close(white[0]);
+    printf("Heartbeats and dead-peer detection: PASS\n");
+}
+
+void test_pool_sizing(void) {
+    printf("Testing pool sizing between limits...\n");
+    assert(count_game_workers() == 2);
+
+    struct pollfd fds[MAX_GAME_WORKERS];
+    assert(collect_worker_fds(fds, MAX_GAME_WORKERS) == 2);
+    assert(worker_pool_timeout_ms(metrics_now_ns()) < 0);
+
+    shutdown_worker_pool();
+    assert(count_game_workers() == 0);
+    assert(collect_worker_fds(fds, MAX_GAME_WORKERS) == 0);
+    printf("Pool sizing between limits: PASS\n");
+}
+
+int main(void) {
+    printf("=== Worker Pool Unit Tests ===\n\n");
+
+    assert(initialize_metrics() == 0);
+    assert(initialize_results() == 0);
+    assert(initialize_game_table(GAME_TABLE_DEFAULT_SLOTS) == 0);
+    worker_pool_config config = { .min_workers = 2, .max_workers = 2, .heartbeat_interval_ms = 300 };
+    configure_worker_pool(&config);
+    configure_io_backend(IO_BACKEND_URING);
+    assert(start_worker_pool() == 0);
+
+    test_dispatch_and_finish();
+    test_stop_game();
+    test_premoves();
+    test_rematch();
+    test_heartbeat();
+    test_pool_sizing();
+
+    printf("\n=== All Tests Passed! ===\n");
+    return 0;
+}
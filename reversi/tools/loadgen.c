@@ -0,0 +1,407 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include "../client/network.h"
+#include "../lib/reversi.h"
+#include "../common/protocol.h"
+
+#define DEFAULT_CONNECTIONS 100
+#define DEFAULT_DURATION_SECONDS 10
+#define EPOLL_BATCH_SIZE 256
+
+typedef enum {
+    STRATEGY_RANDOM,
+    STRATEGY_FIRST_LEGAL
+} MoveStrategy;
+
+typedef struct {
+    int socket_fd;
+    ReversiColor color;
+    ReversiGame *game;
+    LineReader reader;
+    uint64_t move_sent_at;
+    int in_tournament;
+    int games_played;
+    char name[16];
+} Bot;
+
+typedef struct {
+    uint64_t *samples;
+    size_t count;
+    size_t capacity;
+} LatencySamples;
+
+typedef struct {
+    uint64_t games_completed;
+    uint64_t games_abandoned;
+    uint64_t moves_played;
+    uint64_t invalid_replies;
+    uint64_t reconnect_failures;
+    uint64_t connections_rejected;
+    uint64_t tournaments_finished;
+    uint64_t rematches_declined;
+    LatencySamples round_trips;
+} LoadStats;
+
+static const char *g_host;
+static const char *g_port;
+static const char *g_unix_path;
+static MoveStrategy g_strategy = STRATEGY_RANDOM;
+static int g_games_per_connection = 1;
+static int g_epoll_fd = -1;
+static LoadStats g_stats;
+
+static uint64_t now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+static void record_round_trip(uint64_t nanoseconds) {
+    LatencySamples *samples = &g_stats.round_trips;
+    if (samples->count == samples->capacity) {
+        size_t new_capacity = samples->capacity == 0 ? 4096 : samples->capacity * 2;
+        uint64_t *grown = realloc(samples->samples, new_capacity * sizeof(uint64_t));
+        if (grown == NULL) {
+            return;
+        }
+        samples->samples = grown;
+        samples->capacity = new_capacity;
+    }
+    samples->samples[samples->count++] = nanoseconds;
+}
+
+static int compare_samples(const void *left, const void *right) {
+    uint64_t a = *(const uint64_t *)left;
+    uint64_t b = *(const uint64_t *)right;
+    return (a > b) - (a < b);
+}
+
+static double percentile_us(const LatencySamples *samples, double fraction) {
+    if (samples->count == 0) {
+        return 0.0;
+    }
+    size_t index = (size_t)(fraction * (double)(samples->count - 1) + 0.5);
+    return (double)samples->samples[index] / 1000.0;
+}
+
+static void load_board(Bot *bot, const char *board_string, int size) {
+    char position[REVERSI_SERIALIZED_LENGTH];
+    snprintf(position, sizeof(position), "%d|%c|%s", size, bot->color == REVERSI_BLACK ? 'B' : 'W', board_string);
+    reversi_deserialize(bot->game, position);
+}
+
+static int choose_move(Bot *bot, int *row, int *col) {
+    int candidates[REVERSI_MAX_SQUARES];
+    int candidate_count = reversi_legal_moves(bot->game, candidates,
+                                              g_strategy == STRATEGY_FIRST_LEGAL ? 1 : REVERSI_MAX_SQUARES);
+    int size = reversi_size(bot->game);
+
+    if (candidate_count == 0) {
+        return 0;
+    }
+
+    int chosen = candidates[g_strategy == STRATEGY_RANDOM ? rand() % candidate_count : 0];
+    *row = chosen / size;
+    *col = chosen % size;
+    return 1;
+}
+
+static int open_bot(Bot *bot) {
+    char name[sizeof(bot->name)];
+    ReversiGame *game = bot->game;
+    memcpy(name, bot->name, sizeof(name));
+    memset(bot, 0, sizeof(*bot));
+    memcpy(bot->name, name, sizeof(name));
+    bot->game = game;
+    bot->socket_fd = g_unix_path != NULL ? connect_to_unix_server(g_unix_path) : connect_to_server(g_host, g_port);
+    if (bot->socket_fd < 0) {
+        return -1;
+    }
+
+    set_nonblocking(bot->socket_fd);
+    line_reader_init(&bot->reader, bot->socket_fd);
+
+    struct epoll_event event = { .events = EPOLLIN, .data.ptr = bot };
+    if (epoll_ctl(g_epoll_fd, EPOLL_CTL_ADD, bot->socket_fd, &event) < 0) {
+        perror("epoll_ctl failed");
+        close(bot->socket_fd);
+        bot->socket_fd = -1;
+        return -1;
+    }
+    return 0;
+}
+
+static void close_bot(Bot *bot) {
+    if (bot->socket_fd >= 0) {
+        epoll_ctl(g_epoll_fd, EPOLL_CTL_DEL, bot->socket_fd, NULL);
+        close(bot->socket_fd);
+        bot->socket_fd = -1;
+    }
+}
+
+static void restart_bot(Bot *bot) {
+    close_bot(bot);
+    if (open_bot(bot) < 0) {
+        g_stats.reconnect_failures++;
+    }
+}
+
+static int handle_bot_message(Bot *bot, char *line) {
+    ParsedMessage message;
+    const char *text;
+    int row;
+    int col;
+    int size;
+
+    tokenize_message(line, &message);
+
+    switch (message.type) {
+        case MESSAGE_TYPE_WELCOME:
+            if ((text = message_field(&message, 0)) != NULL) {
+                bot->color = (strcmp(text, COLOR_WHITE) == 0) ? REVERSI_WHITE : REVERSI_BLACK;
+            }
+            send_name(bot->socket_fd, bot->name);
+            break;
+
+        case MESSAGE_TYPE_BOARD:
+            if ((text = parse_board_message(&message, &size)) != NULL) {
+                load_board(bot, text, size);
+            }
+            break;
+
+        case MESSAGE_TYPE_YOUR_TURN:
+            if (choose_move(bot, &row, &col)) {
+                bot->move_sent_at = now_ns();
+                send_move(bot->socket_fd, row, col);
+            } else {
+                bot->move_sent_at = 0;
+                send_pass(bot->socket_fd);
+            }
+            break;
+
+        case MESSAGE_TYPE_VALID:
+            if (bot->move_sent_at != 0) {
+                record_round_trip(now_ns() - bot->move_sent_at);
+                g_stats.moves_played++;
+                bot->move_sent_at = 0;
+            }
+            break;
+
+        case MESSAGE_TYPE_INVALID:
+            g_stats.invalid_replies++;
+            bot->move_sent_at = 0;
+            send_pass(bot->socket_fd);
+            break;
+
+        case MESSAGE_TYPE_GAME_OVER:
+            if (bot->color == REVERSI_BLACK) {
+                g_stats.games_completed++;
+            }
+            bot->move_sent_at = 0;
+            if (!bot->in_tournament && ++bot->games_played < g_games_per_connection) {
+                send_rematch(bot->socket_fd);
+                return 0;
+            }
+            return bot->in_tournament ? 0 : -1;
+
+        case MESSAGE_TYPE_OPPONENT_LEFT:
+            g_stats.games_abandoned++;
+            bot->move_sent_at = 0;
+            return bot->in_tournament ? 0 : -1;
+
+        case MESSAGE_TYPE_ROUND:
+            bot->in_tournament = 1;
+            break;
+
+        case MESSAGE_TYPE_TOURNAMENT_OVER:
+            g_stats.tournaments_finished++;
+            return -1;
+
+        case MESSAGE_TYPE_PING:
+            send_pong(bot->socket_fd, (text = message_field(&message, 0)) != NULL ? text : "");
+            break;
+
+        case MESSAGE_TYPE_ERROR:
+            if ((text = message_field(&message, 0)) != NULL && strncmp(text, "rematch_", 8) == 0) {
+                g_stats.rematches_declined++;
+            } else {
+                g_stats.connections_rejected++;
+            }
+            return -1;
+
+        default:
+            break;
+    }
+    return 0;
+}
+
+static void service_bot(Bot *bot) {
+    while (1) {
+        ssize_t bytes_received = line_reader_fill(&bot->reader);
+        if (bytes_received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        if (bytes_received <= 0) {
+            restart_bot(bot);
+            return;
+        }
+
+        char *line;
+        while ((line = line_reader_next(&bot->reader)) != NULL) {
+            if (handle_bot_message(bot, line) < 0) {
+                restart_bot(bot);
+                return;
+            }
+        }
+    }
+}
+
+static void print_report(double elapsed_seconds, int connections) {
+    LatencySamples *samples = &g_stats.round_trips;
+    qsort(samples->samples, samples->count, sizeof(uint64_t), compare_samples);
+
+    printf("connections:        %d\n", connections);
+    printf("duration:           %.2f s\n", elapsed_seconds);
+    printf("games completed:    %llu (%.1f games/s)\n",
+           (unsigned long long)g_stats.games_completed, (double)g_stats.games_completed / elapsed_seconds);
+    printf("games abandoned:    %llu\n", (unsigned long long)g_stats.games_abandoned);
+    printf("moves played:       %llu (%.1f moves/s)\n",
+           (unsigned long long)g_stats.moves_played, (double)g_stats.moves_played / elapsed_seconds);
+    printf("invalid replies:    %llu\n", (unsigned long long)g_stats.invalid_replies);
+    printf("reconnect failures: %llu\n", (unsigned long long)g_stats.reconnect_failures);
+    printf("rejected by server: %llu\n", (unsigned long long)g_stats.connections_rejected);
+    if (g_games_per_connection > 1) {
+        printf("rematches declined: %llu\n", (unsigned long long)g_stats.rematches_declined);
+    }
+    if (g_stats.tournaments_finished > 0) {
+        printf("tournament players: %llu finished\n", (unsigned long long)g_stats.tournaments_finished);
+    }
+    printf("move round trip:    p50 %.1f us  p99 %.1f us  p999 %.1f us  max %.1f us\n",
+           percentile_us(samples, 0.50), percentile_us(samples, 0.99), percentile_us(samples, 0.999),
+           percentile_us(samples, 1.0));
+}
+
+static void print_usage(const char *program_name) {
+    fprintf(stderr, "Usage: %s [-c connections] [-d seconds] [-g games_per_connection] [-m random|first] [-s seed] "
+            "{<server_ip> <port> | -u socket_path}\n",
+            program_name);
+}
+
+int main(int argc, char *argv[]) {
+    int connections = DEFAULT_CONNECTIONS;
+    int duration_seconds = DEFAULT_DURATION_SECONDS;
+    unsigned int seed = (unsigned int)time(NULL);
+
+    int option;
+    while ((option = getopt(argc, argv, "c:d:g:m:s:u:")) != -1) {
+        switch (option) {
+            case 'c':
+                connections = atoi(optarg);
+                break;
+            case 'd':
+                duration_seconds = atoi(optarg);
+                break;
+            case 'g':
+                g_games_per_connection = atoi(optarg);
+                break;
+            case 'm':
+                if (strcmp(optarg, "random") == 0) {
+                    g_strategy = STRATEGY_RANDOM;
+                } else if (strcmp(optarg, "first") == 0) {
+                    g_strategy = STRATEGY_FIRST_LEGAL;
+                } else {
+                    print_usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 's':
+                seed = (unsigned int)strtoul(optarg, NULL, 10);
+                break;
+            case 'u':
+                g_unix_path = optarg;
+                break;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (argc - optind != (g_unix_path != NULL ? 0 : 2) || connections <= 0 || duration_seconds <= 0 || g_games_per_connection <= 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (g_unix_path == NULL) {
+        g_host = argv[optind];
+        g_port = argv[optind + 1];
+    }
+    srand(seed);
+
+    g_epoll_fd = epoll_create1(0);
+    if (g_epoll_fd < 0) {
+        perror("epoll_create1 failed");
+        return 1;
+    }
+
+    Bot *bots = calloc((size_t)connections, sizeof(Bot));
+    if (bots == NULL) {
+        perror("calloc failed");
+        return 1;
+    }
+
+    for (int i = 0; i < connections; i++) {
+        snprintf(bots[i].name, sizeof(bots[i].name), "bot%d", i);
+        bots[i].game = reversi_create(REVERSI_DEFAULT_SIZE);
+        if (bots[i].game == NULL) {
+            perror("reversi_create failed");
+            return 1;
+        }
+        if (open_bot(&bots[i]) < 0) {
+            fprintf(stderr, "Failed to open connection %d\n", i);
+            g_stats.reconnect_failures++;
+        }
+    }
+
+    uint64_t started_at = now_ns();
+    uint64_t deadline = started_at + (uint64_t)duration_seconds * 1000000000ULL;
+    struct epoll_event events[EPOLL_BATCH_SIZE];
+
+    while (now_ns() < deadline) {
+        int remaining_ms = (int)((deadline - now_ns()) / 1000000ULL) + 1;
+        int ready = epoll_wait(g_epoll_fd, events, EPOLL_BATCH_SIZE, remaining_ms);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("epoll_wait failed");
+            break;
+        }
+
+        for (int i = 0; i < ready; i++) {
+            Bot *bot = events[i].data.ptr;
+            if (bot->socket_fd >= 0) {
+                service_bot(bot);
+            }
+        }
+    }
+
+    double elapsed_seconds = (double)(now_ns() - started_at) / 1e9;
+
+    for (int i = 0; i < connections; i++) {
+        close_bot(&bots[i]);
+        reversi_destroy(bots[i].game);
+    }
+    close(g_epoll_fd);
+
+    print_report(elapsed_seconds, connections);
+
+    free(g_stats.round_trips.samples);
+    free(bots);
+    return 0;
+}